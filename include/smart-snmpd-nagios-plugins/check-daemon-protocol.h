@@ -0,0 +1,293 @@
+/*
+ * Copyright 2010,2011 Matthias Haag, Jens Rehsack
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ *
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __SMART_SNMPD_NAGIOS_CHECKS_CHECK_DAEMON_PROTOCOL_H_INCLUDED__
+#define __SMART_SNMPD_NAGIOS_CHECKS_CHECK_DAEMON_PROTOCOL_H_INCLUDED__
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * environment variable to overwrite the default check daemon socket
+ */
+#define SSNC_CHECK_DAEMON_SOCKET_ENV "SSNC_CHECK_DAEMON_SOCKET"
+
+/**
+ * upper limit for a single string transferred between client and daemon
+ */
+static const uint32_t CheckDaemonMaxStringLength = 1024 * 1024;
+
+/**
+ * connection between check daemon client and check daemon
+ *
+ * The protocol is intentionally simple, all integers are transferred as
+ * 32-bit unsigned values in network byte order:
+ *
+ * request:  <argc> { <length> <argument> } * argc
+ * response: <exit code> <length> <stdout> <length> <stderr>
+ *
+ * argv[0] of the request contains the name of the check plugin to run.
+ * One request is handled per connection.
+ */
+class CheckDaemonConnection
+{
+public:
+    /**
+     * constructor
+     *
+     * @param fd - connected stream socket, owned by the connection
+     */
+    explicit CheckDaemonConnection( int fd = -1 )
+        : mFd( fd )
+    {}
+
+    /**
+     * destructor - closes the socket
+     */
+    virtual ~CheckDaemonConnection()
+    {
+        close();
+    }
+
+    /**
+     * connects to the check daemon listening on the given unix socket
+     *
+     * @param socketPath - path of the unix domain socket
+     *
+     * @return true on success, false otherwise (errno is set)
+     */
+    bool connect( string const &socketPath )
+    {
+        struct sockaddr_un addr;
+
+        close();
+
+        if( socketPath.length() >= sizeof(addr.sun_path) )
+        {
+            errno = ENAMETOOLONG;
+            return false;
+        }
+
+        memset( &addr, 0, sizeof(addr) );
+        addr.sun_family = AF_UNIX;
+        strncpy( addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1 );
+
+        if( -1 == ( mFd = ::socket( AF_UNIX, SOCK_STREAM, 0 ) ) )
+            return false;
+
+        if( -1 == ::connect( mFd, (struct sockaddr *)&addr, sizeof(addr) ) )
+        {
+            int saved_errno = errno;
+            close();
+            errno = saved_errno;
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * closes the connection
+     */
+    void close()
+    {
+        if( -1 != mFd )
+        {
+            ::close( mFd );
+            mFd = -1;
+        }
+    }
+
+    /**
+     * sends a check request
+     *
+     * @param args - plugin name followed by the command line arguments
+     *
+     * @return true on success, false otherwise
+     */
+    bool sendRequest( vector<string> const &args )
+    {
+        if( !sendUInt32( args.size() ) )
+            return false;
+
+        for( vector<string>::const_iterator ci = args.begin(); ci != args.end(); ++ci )
+        {
+            if( !sendString( *ci ) )
+                return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * receives a check request
+     *
+     * @param args - receives plugin name followed by the command line arguments
+     *
+     * @return true on success, false otherwise
+     */
+    bool receiveRequest( vector<string> &args )
+    {
+        uint32_t argc;
+
+        if( !receiveUInt32( argc ) || ( argc > 1024 ) )
+            return false;
+
+        args.resize( argc );
+        for( vector<string>::iterator i = args.begin(); i != args.end(); ++i )
+        {
+            if( !receiveString( *i ) )
+                return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * sends the result of a check
+     *
+     * @param exitCode - exit code of the check
+     * @param out - standard output of the check
+     * @param err - error output of the check
+     *
+     * @return true on success, false otherwise
+     */
+    bool sendResponse( int exitCode, string const &out, string const &err )
+    {
+        return sendUInt32( exitCode ) && sendString( out ) && sendString( err );
+    }
+
+    /**
+     * receives the result of a check
+     *
+     * @param exitCode - receives exit code of the check
+     * @param out - receives standard output of the check
+     * @param err - receives error output of the check
+     *
+     * @return true on success, false otherwise
+     */
+    bool receiveResponse( int &exitCode, string &out, string &err )
+    {
+        uint32_t rc;
+
+        if( !receiveUInt32( rc ) || !receiveString( out ) || !receiveString( err ) )
+            return false;
+
+        exitCode = static_cast<int>( rc );
+        return true;
+    }
+
+protected:
+    /**
+     * connected socket
+     */
+    int mFd;
+
+    bool sendAll( void const *buf, size_t len )
+    {
+        char const *p = static_cast<char const *>( buf );
+
+        while( len > 0 )
+        {
+            ssize_t n = ::send( mFd, p, len, MSG_NOSIGNAL );
+            if( n < 0 )
+            {
+                if( EINTR == errno )
+                    continue;
+                return false;
+            }
+            p += n;
+            len -= n;
+        }
+
+        return true;
+    }
+
+    bool receiveAll( void *buf, size_t len )
+    {
+        char *p = static_cast<char *>( buf );
+
+        while( len > 0 )
+        {
+            ssize_t n = ::recv( mFd, p, len, 0 );
+            if( n < 0 )
+            {
+                if( EINTR == errno )
+                    continue;
+                return false;
+            }
+            if( 0 == n )
+                return false; // peer closed connection
+            p += n;
+            len -= n;
+        }
+
+        return true;
+    }
+
+    bool sendUInt32( uint32_t value )
+    {
+        uint32_t netValue = htonl( value );
+        return sendAll( &netValue, sizeof(netValue) );
+    }
+
+    bool receiveUInt32( uint32_t &value )
+    {
+        uint32_t netValue;
+        if( !receiveAll( &netValue, sizeof(netValue) ) )
+            return false;
+        value = ntohl( netValue );
+        return true;
+    }
+
+    bool sendString( string const &s )
+    {
+        return sendUInt32( s.length() ) && sendAll( s.data(), s.length() );
+    }
+
+    bool receiveString( string &s )
+    {
+        uint32_t len;
+
+        if( !receiveUInt32( len ) || ( len > CheckDaemonMaxStringLength ) )
+            return false;
+
+        s.resize( len );
+        return ( 0 == len ) || receiveAll( &s[0], len );
+    }
+
+private:
+    /**
+     * forbidden copy constructor
+     */
+    CheckDaemonConnection( CheckDaemonConnection const & );
+    /**
+     * forbidden assignment operator
+     */
+    CheckDaemonConnection & operator = ( CheckDaemonConnection const & );
+};
+
+#endif /* __SMART_SNMPD_NAGIOS_CHECKS_CHECK_DAEMON_PROTOCOL_H_INCLUDED__ */
@@ -0,0 +1,840 @@
+/*
+ * Copyright 2010,2011 Matthias Haag, Jens Rehsack
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ *
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __SMART_SNMPD_NAGIOS_CHECKS_HOST_STATE_STORE_H_INCLUDED__
+#define __SMART_SNMPD_NAGIOS_CHECKS_HOST_STATE_STORE_H_INCLUDED__
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
+#undef loggerModuleName
+#define loggerModuleName "nagiosplugins.hoststatestore"
+
+/**
+ * creates a directory including its missing parents (like mkdir -p)
+ *
+ * @param dir - path of the directory
+ * @param mode - mode of the created directories
+ *
+ * @return true when the directory exists afterwards, false otherwise (errno is set)
+ */
+inline bool
+make_directories( string const &dir, mode_t mode = 0770 )
+{
+    struct stat st;
+
+    if( dir.empty() || ( 0 == stat( dir.c_str(), &st ) && S_ISDIR( st.st_mode ) ) )
+        return true;
+
+    string::size_type pos = dir.find_last_of( '/' );
+    if( ( pos != string::npos ) && ( pos > 0 ) && !make_directories( dir.substr( 0, pos ), mode ) )
+        return false;
+
+    // a concurrent plugin might have created it meanwhile
+    return ( 0 == mkdir( dir.c_str(), mode ) ) || ( EEXIST == errno );
+}
+
+/**
+ * creates a new file next to fileName to be renamed over it later
+ *
+ * Unlike mkstemp(), the file gets the given mode reduced by the umask.
+ *
+ * @param fileName - path of the file to replace
+ * @param mode - mode of the created file
+ * @param tmpName - receives the path of the created file
+ *
+ * @return descriptor of the file opened for reading and writing, -1 on failure (errno is set)
+ */
+inline int
+create_unique_file( string const &fileName, mode_t mode, string &tmpName )
+{
+    static unsigned long counter = 0;
+    char suffix[48];
+
+    for( unsigned attempt = 0; attempt < 100; ++attempt )
+    {
+        // threads racing on counter just retry
+        snprintf( suffix, sizeof(suffix), ".%ld.%lu", (long)getpid(), counter++ );
+        tmpName = fileName + suffix;
+
+        int fd = open( tmpName.c_str(), O_RDWR | O_CREAT | O_EXCL, mode );
+        if( ( -1 != fd ) || ( EEXIST != errno ) )
+            return fd;
+    }
+
+    return -1;
+}
+
+/**
+ * keyed hash of the strings identifying a host including its credentials
+ *
+ * The host ids contain the community or the SNMPv3 passwords. Hashed
+ * by SipHash-2-4 with a random key kept in store.key (readable by its
+ * owner only) within the cache directory, the record keys in the shared
+ * stores don't allow to guess the credentials offline.
+ */
+class StoreKeyHasher
+{
+public:
+    /**
+     * returns the hasher using the key of the given directory, creating the key on first use
+     *
+     * @param cacheDir - directory containing the key, empty to disable
+     *
+     * @return the hasher or NULL when it's disabled or the key can't be read
+     */
+    static StoreKeyHasher const * instance( string const &cacheDir )
+    {
+#ifdef HAVE_PTHREAD
+        static pthread_mutex_t instanceMutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+        static map<string, StoreKeyHasher *> hashers;
+        StoreKeyHasher *hasher = NULL;
+
+        if( cacheDir.empty() )
+            return NULL;
+
+#ifdef HAVE_PTHREAD
+        pthread_mutex_lock( &instanceMutex );
+#endif
+        map<string, StoreKeyHasher *>::iterator i = hashers.find( cacheDir );
+        if( i == hashers.end() )
+        {
+            uint64_t k0, k1;
+            if( load_key( cacheDir, k0, k1 ) )
+                hasher = new StoreKeyHasher( k0, k1 );
+            // remember failures, too - don't try again for each host
+            hashers[cacheDir] = hasher;
+        }
+        else
+        {
+            hasher = i->second;
+        }
+#ifdef HAVE_PTHREAD
+        pthread_mutex_unlock( &instanceMutex );
+#endif
+
+        return hasher;
+    }
+
+    /**
+     * @param hostId - string identifying the host and the credentials
+     *
+     * @return SipHash-2-4 of hostId, never 0
+     */
+    uint64_t hash( string const &hostId ) const
+    {
+        unsigned char const *in = reinterpret_cast<unsigned char const *>( hostId.data() );
+        size_t len = hostId.length();
+        uint64_t v0 = 0x736f6d6570736575ULL ^ mK0;
+        uint64_t v1 = 0x646f72616e646f6dULL ^ mK1;
+        uint64_t v2 = 0x6c7967656e657261ULL ^ mK0;
+        uint64_t v3 = 0x7465646279746573ULL ^ mK1;
+        uint64_t m;
+
+        for( ; len >= 8; in += 8, len -= 8 )
+        {
+            m = get_le64( in, 8 );
+            v3 ^= m;
+            sip_round( v0, v1, v2, v3 );
+            sip_round( v0, v1, v2, v3 );
+            v0 ^= m;
+        }
+
+        m = get_le64( in, len ) | ( static_cast<uint64_t>( hostId.length() ) << 56 );
+        v3 ^= m;
+        sip_round( v0, v1, v2, v3 );
+        sip_round( v0, v1, v2, v3 );
+        v0 ^= m;
+
+        v2 ^= 0xff;
+        for( int r = 0; r < 4; ++r )
+            sip_round( v0, v1, v2, v3 );
+
+        uint64_t h = v0 ^ v1 ^ v2 ^ v3;
+        return h ? h : 1;
+    }
+
+protected:
+    uint64_t mK0;
+    uint64_t mK1;
+
+    StoreKeyHasher( uint64_t k0, uint64_t k1 )
+        : mK0( k0 )
+        , mK1( k1 )
+    {}
+
+    /**
+     * reads the key of the directory - a missing key is created from /dev/urandom
+     */
+    static bool load_key( string const &cacheDir, uint64_t &k0, uint64_t &k1 )
+    {
+        string fileName = cacheDir + "/store.key";
+        unsigned char key[16];
+
+        int fd = open( fileName.c_str(), O_RDONLY );
+        if( ( -1 == fd ) && ( ENOENT == errno ) && make_directories( cacheDir ) )
+        {
+            string tmpName;
+            int rnd = open( "/dev/urandom", O_RDONLY );
+            int tmp = create_unique_file( fileName, 0600, tmpName );
+            bool ok = ( -1 != rnd ) && ( -1 != tmp ) &&
+                      ( read( rnd, key, sizeof(key) ) == (ssize_t)sizeof(key) ) &&
+                      ( write( tmp, key, sizeof(key) ) == (ssize_t)sizeof(key) );
+            if( -1 != rnd )
+                close( rnd );
+            if( -1 != tmp )
+            {
+                close( tmp );
+                // link() doesn't replace the key another process created meanwhile
+                if( ok )
+                    link( tmpName.c_str(), fileName.c_str() );
+                unlink( tmpName.c_str() );
+            }
+
+            fd = open( fileName.c_str(), O_RDONLY );
+        }
+
+        bool ok = ( -1 != fd ) && ( read( fd, key, sizeof(key) ) == (ssize_t)sizeof(key) );
+        if( -1 != fd )
+            close( fd );
+
+        if( !ok )
+        {
+            SSNC_LOG_BEGIN( loggerModuleName, WARNING_LOG | 1 );
+            LOG( "Can't read key of persistent record stores" );
+            LOG( fileName.c_str() );
+            LOG_END;
+            return false;
+        }
+
+        k0 = get_le64( key, 8 );
+        k1 = get_le64( key + 8, 8 );
+        return true;
+    }
+
+    static inline uint64_t get_le64( unsigned char const *p, size_t len )
+    {
+        uint64_t v = 0;
+        for( size_t i = len; i > 0; --i )
+            v = ( v << 8 ) | p[i - 1];
+        return v;
+    }
+
+    static inline uint64_t rotl( uint64_t x, int b )
+    {
+        return ( x << b ) | ( x >> ( 64 - b ) );
+    }
+
+    static inline void sip_round( uint64_t &v0, uint64_t &v1, uint64_t &v2, uint64_t &v3 )
+    {
+        v0 += v1; v1 = rotl( v1, 13 ); v1 ^= v0; v0 = rotl( v0, 32 );
+        v2 += v3; v3 = rotl( v3, 16 ); v3 ^= v2;
+        v0 += v3; v3 = rotl( v3, 21 ); v3 ^= v0;
+        v2 += v1; v1 = rotl( v1, 17 ); v1 ^= v2; v2 = rotl( v2, 32 );
+    }
+
+private:
+    StoreKeyHasher( StoreKeyHasher const & );
+    StoreKeyHasher & operator = ( StoreKeyHasher const & );
+};
+
+/**
+ * data remembered per host between plugin runs
+ *
+ * Plain old data - it's directly stored in the memory mapped file.
+ * Increase FormatVersion when changing the layout.
+ */
+struct HostStateRecord
+{
+    static const uint32_t FormatVersion = 5;
+    static const uint32_t SlotCount = 4096;
+    static const mode_t FileMode = 0660;
+    static const char * fileName() { return "host-state.db"; }
+
+    /**
+     * keyed hash of the host key (see StoreKeyHasher), 0 for an unused slot
+     */
+    uint64_t mKey;
+    /**
+     * time of the last update
+     */
+    time_t mUpdated;
+    /**
+     * printable address of the host (informational only)
+     */
+    char mHost[64];
+    /**
+     * best max-repetitions for get-bulk requests, 0 when not yet known
+     */
+    uint32_t mBulkMaxRepetitions;
+    /**
+     * largest get request (estimated size) answered without tooBig, 0 when not yet known
+     */
+    uint32_t mGetMaxMsgSize;
+    /**
+     * name of the identified snmp daemon, empty when not yet known
+     */
+    char mDaemonName[32];
+    /**
+     * sysUpTime.0 of the agent seen last, detects restarts
+     */
+    uint32_t mSysUpTime;
+    /**
+     * time of the daemon identification
+     */
+    time_t mIdentified;
+    /**
+     * smoothed round trip time in microseconds, 0 when not yet known
+     */
+    uint32_t mSmoothedRtt;
+    /**
+     * round trip time variance in microseconds
+     */
+    uint32_t mRttVariance;
+};
+
+/**
+ * SNMPv3 data remembered per target and user between plugin runs
+ *
+ * Contains the localized keys - the store is readable by its owner only.
+ * An mEngineIdLength of 0 marks a record as invalid.
+ */
+struct UsmKeyRecord
+{
+    static const uint32_t FormatVersion = 2;
+    static const uint32_t SlotCount = 4096;
+    static const mode_t FileMode = 0600;
+    static const char * fileName() { return "usm-keys.db"; }
+
+    /**
+     * keyed hash of the target and user credentials (see StoreKeyHasher), 0 for an unused slot
+     */
+    uint64_t mKey;
+    /**
+     * time of the last update
+     */
+    time_t mUpdated;
+    /**
+     * discovered authoritative engine id of the agent
+     */
+    uint32_t mEngineIdLength;
+    unsigned char mEngineId[32];
+    /**
+     * authentication key localized for mEngineId
+     */
+    uint32_t mAuthKeyLength;
+    unsigned char mAuthKey[64];
+    /**
+     * privacy key localized for mEngineId
+     */
+    uint32_t mPrivKeyLength;
+    unsigned char mPrivKey[64];
+};
+
+/**
+ * row index of a table row found by name, remembered per host and table
+ *
+ * The index is verified on each use by fetching the name at this index
+ * along with the data to check.
+ */
+struct RowIndexRecord
+{
+    static const uint32_t FormatVersion = 2;
+    static const uint32_t SlotCount = 16384;
+    static const mode_t FileMode = 0660;
+    static const char * fileName() { return "row-index.db"; }
+
+    /**
+     * hash of the host key, the searched columns and the name, 0 for an unused slot
+     */
+    uint64_t mKey;
+    /**
+     * time of the last update
+     */
+    time_t mUpdated;
+    /**
+     * index of the row containing the name
+     */
+    int64_t mRowIndex;
+};
+
+/**
+ * persistent records shared by all plugins
+ *
+ * The records are kept in a memory mapped file consisting of a fixed number
+ * of slots. A record is stored in one of the ProbeSlots consecutive slots
+ * beginning at its hash - when all of them are occupied by other records,
+ * the least recently updated one is replaced. Each access locks the
+ * affected slots using fcntl() byte range locks (against other processes)
+ * and a mutex (against other threads of the same process).
+ *
+ * The store is a cache: when the file can't be created or opened, the
+ * plugins simply work without it. A file of another format is replaced by
+ * a new one, never modified in place.
+ *
+ * @param Record - plain old data type with the members mKey and mUpdated,
+ *                 the constants FormatVersion, SlotCount and FileMode and
+ *                 the static method fileName()
+ */
+template < class Record >
+class PersistentRecordStore
+{
+public:
+    static const uint32_t SlotCount = Record::SlotCount;
+    static const uint32_t ProbeSlots = 8;
+
+    /**
+     * returns the store within the given directory, opening it on first use
+     *
+     * @param cacheDir - directory containing the store, empty to disable
+     *
+     * @return the store or NULL when it's disabled or can't be opened
+     */
+    static PersistentRecordStore * instance( string const &cacheDir )
+    {
+        static map<string, PersistentRecordStore *> stores;
+        PersistentRecordStore *store = NULL;
+
+        if( cacheDir.empty() )
+            return NULL;
+
+        instanceLock( true );
+        typename map<string, PersistentRecordStore *>::iterator i = stores.find( cacheDir );
+        if( i == stores.end() )
+        {
+            store = new PersistentRecordStore( cacheDir + "/" + Record::fileName() );
+            if( !store->isOpen() )
+            {
+                delete store;
+                store = NULL;
+            }
+            // remember failures, too - don't try again for each record
+            stores[cacheDir] = store;
+        }
+        else
+        {
+            store = i->second;
+        }
+        instanceLock( false );
+
+        return store;
+    }
+
+    /**
+     * builds the key of a record from a string identifying it
+     *
+     * Not keyed - ids containing credentials are hashed by StoreKeyHasher,
+     * e.g. the hash of the host key is used here instead of the host key.
+     *
+     * @param hostId - string identifying the record, must not contain secrets
+     *
+     * @return 64 bit FNV-1a hash of hostId, never 0
+     */
+    static uint64_t make_key( string const &hostId )
+    {
+        uint64_t h = 14695981039346656037ULL;
+        for( string::const_iterator ci = hostId.begin(); ci != hostId.end(); ++ci )
+        {
+            h ^= static_cast<unsigned char>( *ci );
+            h *= 1099511628211ULL;
+        }
+        return h ? h : 1;
+    }
+
+    /**
+     * destructor
+     */
+    virtual ~PersistentRecordStore()
+    {
+        if( MAP_FAILED != mMap )
+            munmap( mMap, mMapSize );
+        if( -1 != mFd )
+            close( mFd );
+#ifdef HAVE_PTHREAD
+        pthread_mutex_destroy( &mMutex );
+#endif
+    }
+
+    /**
+     * @return true when the store is usable
+     */
+    inline bool isOpen() const { return MAP_FAILED != mMap; }
+
+    /**
+     * loads a record
+     *
+     * @param key - key of the record (see make_key())
+     * @param rec - receives the record
+     *
+     * @return true when the record was found, false otherwise
+     */
+    bool load( uint64_t key, Record &rec )
+    {
+        bool found = false;
+        uint32_t first = firstSlot( key );
+
+        lockSlots( first, F_RDLCK );
+        for( uint32_t i = first; i < first + ProbeSlots; ++i )
+        {
+            if( mSlots[i].mKey == key )
+            {
+                rec = mSlots[i];
+                found = true;
+                break;
+            }
+        }
+        unlockSlots( first );
+
+        return found;
+    }
+
+    /**
+     * stores a record
+     *
+     * @param rec - the record, rec.mKey must be set
+     */
+    void save( Record const &rec )
+    {
+        uint32_t first = firstSlot( rec.mKey );
+        uint32_t slot = first;
+
+        lockSlots( first, F_WRLCK );
+        for( uint32_t i = first; i < first + ProbeSlots; ++i )
+        {
+            if( ( mSlots[i].mKey == rec.mKey ) || ( 0 == mSlots[i].mKey ) )
+            {
+                slot = i;
+                break;
+            }
+            if( mSlots[i].mUpdated < mSlots[slot].mUpdated )
+                slot = i;
+        }
+
+        mSlots[slot] = rec;
+        mSlots[slot].mUpdated = time( NULL );
+        unlockSlots( first );
+    }
+
+    /**
+     * stores some members of a record, keeping the other members as stored
+     *
+     * The stored record is read, modified and written under the lock of its
+     * slots, so members updated concurrently by other processes aren't lost.
+     * When the record isn't stored yet, it's saved completely.
+     *
+     * @param rec - the record, rec.mKey must be set
+     * @param first - address of the first member within rec to store
+     * @param len - number of bytes to store beginning at first
+     */
+    void save_members( Record const &rec, void const *first, size_t len )
+    {
+        size_t offset = static_cast<char const *>( first ) - reinterpret_cast<char const *>( &rec );
+        uint32_t firstSlotNo = firstSlot( rec.mKey );
+        uint32_t slot = firstSlotNo;
+        bool found = false;
+
+        lockSlots( firstSlotNo, F_WRLCK );
+        for( uint32_t i = firstSlotNo; i < firstSlotNo + ProbeSlots; ++i )
+        {
+            if( mSlots[i].mKey == rec.mKey )
+            {
+                slot = i;
+                found = true;
+                break;
+            }
+            if( 0 == mSlots[i].mKey )
+            {
+                slot = i;
+                break;
+            }
+            if( mSlots[i].mUpdated < mSlots[slot].mUpdated )
+                slot = i;
+        }
+
+        if( found )
+            memcpy( reinterpret_cast<char *>( &mSlots[slot] ) + offset, first, len );
+        else
+            mSlots[slot] = rec;
+        mSlots[slot].mUpdated = time( NULL );
+        unlockSlots( firstSlotNo );
+    }
+
+protected:
+    /**
+     * file header
+     */
+    struct Header
+    {
+        char mMagic[8];
+        uint32_t mVersion;
+        uint32_t mSlotCount;
+        uint32_t mRecordSize;
+        uint32_t mReserved;
+    };
+
+    int mFd;
+    void *mMap;
+    size_t mMapSize;
+    Record *mSlots;
+#ifdef HAVE_PTHREAD
+    pthread_mutex_t mMutex;
+#endif
+
+    /**
+     * opens (and initializes, if necessary) the store
+     *
+     * @param fileName - path of the file containing the store
+     */
+    explicit PersistentRecordStore( string const &fileName )
+        : mFd( -1 )
+        , mMap( MAP_FAILED )
+        , mMapSize( sizeof(Header) + SlotCount * sizeof(Record) )
+        , mSlots( NULL )
+    {
+#ifdef HAVE_PTHREAD
+        pthread_mutex_init( &mMutex, NULL );
+#endif
+
+        string::size_type pos = fileName.find_last_of( '/' );
+        if( ( pos != string::npos ) && !make_directories( fileName.substr( 0, pos ) ) )
+        {
+            SSNC_LOG_BEGIN( loggerModuleName, WARNING_LOG | 1 );
+            LOG( "Can't create directory of persistent record store" );
+            LOG( fileName.c_str() );
+            LOG( strerror(errno) );
+            LOG_END;
+            return;
+        }
+
+        // another process might replace an invalid file while we wait for the lock - retry then
+        for( unsigned attempt = 0; attempt < 3; ++attempt )
+        {
+            if( -1 == ( mFd = open( fileName.c_str(), O_RDWR | O_CREAT, Record::FileMode ) ) )
+            {
+                SSNC_LOG_BEGIN( loggerModuleName, WARNING_LOG | 1 );
+                LOG( "Can't open persistent record store" );
+                LOG( fileName.c_str() );
+                LOG( strerror(errno) );
+                LOG_END;
+                return;
+            }
+
+            // check and initialize under exclusive lock of the header to avoid racing with other processes
+            if( !lockRange( 0, sizeof(Header), F_WRLCK ) )
+                break;
+
+            struct stat st, pathSt;
+            if( ( 0 != fstat( mFd, &st ) ) || ( 0 != stat( fileName.c_str(), &pathSt ) ) ||
+                ( st.st_dev != pathSt.st_dev ) || ( st.st_ino != pathSt.st_ino ) )
+            {
+                close( mFd ); // replaced meanwhile
+                mFd = -1;
+                continue;
+            }
+
+            if( !isValid( st ) && !replaceFile( fileName ) )
+            {
+                lockRange( 0, sizeof(Header), F_UNLCK );
+                break;
+            }
+
+            mMap = mmap( NULL, mMapSize, PROT_READ | PROT_WRITE, MAP_SHARED, mFd, 0 );
+            if( MAP_FAILED != mMap )
+                mSlots = reinterpret_cast<Record *>( static_cast<char *>( mMap ) + sizeof(Header) );
+
+            lockRange( 0, sizeof(Header), F_UNLCK );
+            return;
+        }
+
+        if( -1 != mFd )
+        {
+            close( mFd );
+            mFd = -1;
+        }
+    }
+
+    /**
+     * checks the header and the size of the opened file
+     *
+     * @param st - status of the opened file
+     *
+     * @return true when the file contains a store of this format
+     */
+    bool isValid( struct stat const &st ) const
+    {
+        Header hdr;
+
+        return ( pread( mFd, &hdr, sizeof(hdr), 0 ) == (ssize_t)sizeof(hdr) ) &&
+               ( 0 == memcmp( hdr.mMagic, "SSNCHST", 8 ) ) &&
+               ( Record::FormatVersion == hdr.mVersion ) &&
+               ( SlotCount == hdr.mSlotCount ) &&
+               ( sizeof(Record) == hdr.mRecordSize ) &&
+               ( (size_t)st.st_size == mMapSize );
+    }
+
+    /**
+     * replaces the opened file by a new, empty store
+     *
+     * Other processes (e.g. still running plugins of an older version) might
+     * have mapped the old file - truncating it would kill them by SIGBUS.
+     * Thus the new store is written into a temporary file which is renamed
+     * over the old one. On success, mFd refers to the new file and its header
+     * is locked exclusively.
+     *
+     * @param fileName - path of the file containing the store
+     *
+     * @return true on success, false otherwise
+     */
+    bool replaceFile( string const &fileName )
+    {
+        SSNC_LOG_BEGIN( loggerModuleName, INFO_LOG | 1 );
+        LOG( "Initializing persistent record store" );
+        LOG( fileName.c_str() );
+        LOG_END;
+
+        string tmpName;
+        int fd = create_unique_file( fileName, Record::FileMode, tmpName );
+        if( -1 == fd )
+            return false;
+
+        Header hdr;
+        memset( &hdr, 0, sizeof(hdr) );
+        memcpy( hdr.mMagic, "SSNCHST", 8 );
+        hdr.mVersion = Record::FormatVersion;
+        hdr.mSlotCount = SlotCount;
+        hdr.mRecordSize = sizeof(Record);
+
+        int oldFd = mFd;
+        mFd = fd;
+        if( ( 0 != ftruncate( fd, mMapSize ) ) ||
+            ( pwrite( fd, &hdr, sizeof(hdr), 0 ) != (ssize_t)sizeof(hdr) ) ||
+            !lockRange( 0, sizeof(Header), F_WRLCK ) ||
+            ( 0 != rename( tmpName.c_str(), fileName.c_str() ) ) )
+        {
+            SSNC_LOG_BEGIN( loggerModuleName, WARNING_LOG | 1 );
+            LOG( "Can't initialize persistent record store" );
+            LOG( fileName.c_str() );
+            LOG( strerror(errno) );
+            LOG_END;
+
+            unlink( tmpName.c_str() );
+            close( fd );
+            mFd = oldFd;
+            return false;
+        }
+
+        // releases the lock of the old file - waiting processes notice the replacement
+        close( oldFd );
+        return true;
+    }
+
+    inline uint32_t firstSlot( uint64_t key ) const
+    {
+        return static_cast<uint32_t>( key % ( SlotCount - ProbeSlots + 1 ) );
+    }
+
+    bool lockRange( off_t start, off_t len, short type )
+    {
+        struct flock fl;
+        memset( &fl, 0, sizeof(fl) );
+        fl.l_type = type;
+        fl.l_whence = SEEK_SET;
+        fl.l_start = start;
+        fl.l_len = len;
+
+        while( -1 == fcntl( mFd, F_SETLKW, &fl ) )
+        {
+            if( EINTR != errno )
+                return false;
+        }
+
+        return true;
+    }
+
+    void lockSlots( uint32_t first, short type )
+    {
+#ifdef HAVE_PTHREAD
+        pthread_mutex_lock( &mMutex );
+#endif
+        lockRange( sizeof(Header) + first * sizeof(Record), ProbeSlots * sizeof(Record), type );
+    }
+
+    void unlockSlots( uint32_t first )
+    {
+        lockRange( sizeof(Header) + first * sizeof(Record), ProbeSlots * sizeof(Record), F_UNLCK );
+#ifdef HAVE_PTHREAD
+        pthread_mutex_unlock( &mMutex );
+#endif
+    }
+
+    static void instanceLock( bool lock )
+    {
+#ifdef HAVE_PTHREAD
+        static pthread_mutex_t instanceMutex = PTHREAD_MUTEX_INITIALIZER;
+        if( lock )
+            pthread_mutex_lock( &instanceMutex );
+        else
+            pthread_mutex_unlock( &instanceMutex );
+#else
+        (void)lock;
+#endif
+    }
+
+private:
+    /**
+     * forbidden copy constructor
+     */
+    PersistentRecordStore( PersistentRecordStore const & );
+    /**
+     * forbidden assignment operator
+     */
+    PersistentRecordStore & operator = ( PersistentRecordStore const & );
+};
+
+/**
+ * store of the per host state
+ */
+typedef PersistentRecordStore<HostStateRecord> HostStateStore;
+/**
+ * store of the localized SNMPv3 keys
+ */
+typedef PersistentRecordStore<UsmKeyRecord> UsmKeyStore;
+/**
+ * store of the row indices found by name
+ */
+typedef PersistentRecordStore<RowIndexRecord> RowIndexStore;
+
+#undef loggerModuleName
+
+#endif /* __SMART_SNMPD_NAGIOS_CHECKS_HOST_STATE_STORE_H_INCLUDED__ */
@@ -239,6 +239,10 @@ protected:
  * log messages using the external library log4cplus from
  * http://log4cplus.sourceforge.net/.
  *
+ * When constructed with properties, log4cplus isn't configured before the
+ * first log entry passes the filter of the snmp++ log profile - runs
+ * without any log output don't pay for setting up loggers and appenders.
+ *
  * @author Jens Rehsack
  * @version 0.1.0
  */
@@ -252,12 +256,39 @@ public:
      */ 
     AgentLog4CPlus()
         : AgentLog()
-    {}
+        , mProperties()
+        , mConfigured( true )
+    {
+#if defined(_THREADS) && !defined(_WIN32THREADS)
+        pthread_mutex_init( &mConfigureLock, NULL );
+#endif
+    }
+
+    /**
+     * Constructor deferring the configuration of log4cplus until
+     * the first log entry is needed.
+     *
+     * @param properties - log4cplus configuration to apply then
+     */
+    explicit AgentLog4CPlus( log4cplus::helpers::Properties const &properties )
+        : AgentLog()
+        , mProperties( properties )
+        , mConfigured( false )
+    {
+#if defined(_THREADS) && !defined(_WIN32THREADS)
+        pthread_mutex_init( &mConfigureLock, NULL );
+#endif
+    }
 
     /**
      * Destructor.
      */
-    virtual ~AgentLog4CPlus() {}
+    virtual ~AgentLog4CPlus()
+    {
+#if defined(_THREADS) && !defined(_WIN32THREADS)
+        pthread_mutex_destroy( &mConfigureLock );
+#endif
+    }
 
     /**
      * Create a new LogEntry.
@@ -308,12 +339,43 @@ public:
         bool rc = AgentLog::log_needed(n, t);
         if( rc )
         {
+            configure();
             Logger logger = Logger::getInstance( n );
             rc = logger.isEnabledFor( LogEntry4CPlus::getLog4CPlusLogLevel(t) );
         }
 
         return rc;
     }
+
+protected:
+    log4cplus::helpers::Properties mProperties;
+    mutable bool mConfigured;
+#if defined(_THREADS) && !defined(_WIN32THREADS)
+    mutable pthread_mutex_t mConfigureLock;
+#endif
+
+    /**
+     * configures log4cplus from the properties given at construction once
+     *
+     * Only called for entries passing the log profile, so the lock is taken
+     * each time - mConfigured mustn't be read unlocked by the threads of the
+     * check daemon.
+     */
+    void configure() const
+    {
+#if defined(_THREADS) && !defined(_WIN32THREADS)
+        pthread_mutex_lock( &mConfigureLock );
+#endif
+        if( !mConfigured )
+        {
+            PropertyConfigurator configurator( mProperties );
+            configurator.configure();
+            mConfigured = true;
+        }
+#if defined(_THREADS) && !defined(_WIN32THREADS)
+        pthread_mutex_unlock( &mConfigureLock );
+#endif
+    }
 };
 
 #endif /* __SMART_SNMPD_NAGIOS_CHECKS_LOG4CPLUS_H_INCLUDED__ */
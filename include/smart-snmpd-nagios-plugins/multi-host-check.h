@@ -0,0 +1,641 @@
+/*
+ * Copyright 2010,2011 Matthias Haag, Jens Rehsack
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ *
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __SMART_SNMPD_NAGIOS_CHECKS_MULTI_HOST_CHECK_H_INCLUDED__
+#define __SMART_SNMPD_NAGIOS_CHECKS_MULTI_HOST_CHECK_H_INCLUDED__
+
+#include <smart-snmpd-nagios-plugins/snmp-appl.h>
+#include <smart-snmpd-nagios-plugins/snmp-session-pool.h>
+#include <smart-snmpd-nagios-plugins/nagios-stats.h>
+
+#include <boost/lexical_cast.hpp>
+
+using namespace boost;
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+
+#include <limits.h>
+#include <sys/time.h>
+
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
+#undef loggerModuleName
+#define loggerModuleName "nagiosplugins.multihostcheck"
+
+extern "C"
+{
+static void * multi_host_check_worker(void *arg);
+}
+
+/**
+ * runs one check plugin against many hosts concurrently
+ *
+ * The command line of the plugin is split into the host specifications
+ * (each -H/--host and the hosts listed in --hosts-file), the options
+ * controlling the multi host run and the remaining plugin options. For
+ * each host the plugin is run with the remaining options and a single
+ * -H in a hosted environment, so each host has its own application
+ * object (and therefore its own SnmpComm and data map).
+ *
+ * The results are printed as one line per host prefixed with the host
+ * name or submitted as passive service check results to the nagios
+ * external command file.
+ *
+ * --alarm-timeout limits the whole run: each host is checked with the
+ * time remaining, hosts not checked in time are reported as UNKNOWN.
+ */
+class MultiHostCheck
+{
+public:
+    /**
+     * constructor
+     *
+     * @param runFunc - run function of the check plugin
+     * @param hostedEnv - environment of the hosting process, NULL when running standalone
+     */
+    MultiHostCheck( CheckPluginRunFunc runFunc, HostedEnvironment *hostedEnv = NULL )
+        : mRunFunc( runFunc )
+        , mHostedEnv( hostedEnv )
+        , mOwnSessionPool()
+        , mHosts()
+        , mArgs()
+        , mHostsFile()
+        , mParallel( 16 )
+        , mPassiveService()
+        , mCommandFile()
+        , mResults()
+        , mNextHost( 0 )
+        , mFinishedHosts( 0 )
+        , mAlarmTimeout( 45 )
+        , mDeadline()
+        , mTimedOut( false )
+    {
+#ifdef HAVE_PTHREAD
+        pthread_mutex_init( &mMutex, NULL );
+        pthread_cond_init( &mFinishedCond, NULL );
+#endif
+    }
+
+    /**
+     * destructor
+     */
+    virtual ~MultiHostCheck()
+    {
+#ifdef HAVE_PTHREAD
+        pthread_cond_destroy( &mFinishedCond );
+        pthread_mutex_destroy( &mMutex );
+#endif
+    }
+
+    /**
+     * adds the options controlling multi host runs to the given options_description instance
+     *
+     * The options are handled before the plugin parses its command line,
+     * they're only registered at the plugin to show up in the help output.
+     *
+     * @param multihostopts - options_description instance to add the multi host options to
+     */
+    static void add_multi_host_options(options_description &multihostopts)
+    {
+        multihostopts.add_options()
+            ("hosts-file", value<string>(), "file containing the hosts to check (one per line: address [name]), "
+                                            "additionally to the hosts given by (repeated) --host")
+            ("parallel", value<unsigned>()->default_value(16), "maximum number of hosts checked concurrently")
+            ("passive-service", value<string>(), "submit the results as passive check results for this service")
+            ("command-file", value<string>(), "nagios external command file to submit passive check results to")
+            ;
+    }
+
+    /**
+     * splits the command line
+     *
+     * @param argc - argument count
+     * @param argv - argument values
+     *
+     * @return true when the plugin shall be run against multiple hosts
+     */
+    bool setupFromCommandLine( int argc, char *argv[] )
+    {
+        bool multiHost = false;
+
+        mArgs.push_back( argv[0] );
+        for( int i = 1; i < argc; ++i )
+        {
+            string arg( argv[i] );
+            string value;
+
+            if( getOptionValue( "-H", "--host", arg, argc, argv, i, value ) )
+                mHosts.push_back( HostEntry( value, value ) );
+            else if( getOptionValue( NULL, "--hosts-file", arg, argc, argv, i, value ) )
+            {
+                mHostsFile = value;
+                multiHost = true;
+            }
+            else if( getOptionValue( NULL, "--parallel", arg, argc, argv, i, value ) )
+                mParallel = lexical_cast<unsigned>( value );
+            else if( getOptionValue( NULL, "--passive-service", arg, argc, argv, i, value ) )
+                mPassiveService = value;
+            else if( getOptionValue( NULL, "--command-file", arg, argc, argv, i, value ) )
+                mCommandFile = value;
+            else if( getOptionValue( "-a", "--alarm-timeout", arg, argc, argv, i, value ) )
+                mAlarmTimeout = lexical_cast<unsigned>( value ); // passed to each host with the time remaining
+            else
+                mArgs.push_back( arg );
+        }
+
+        if( mHosts.size() > 1 )
+            multiHost = true;
+        if( !multiHost )
+            return false;
+
+        if( !mHostsFile.empty() )
+            readHostsFile( mHostsFile );
+        if( mHosts.empty() )
+            throw option_error( "No hosts to check." );
+        if( 0 == mParallel )
+            throw validation_error( validation_error::invalid_option_value, "0", "parallel" );
+        if( mCommandFile.empty() != mPassiveService.empty() )
+            throw option_error( "Options 'passive-service' and 'command-file' must be used together." );
+
+        return true;
+    }
+
+    /**
+     * runs the plugin against all hosts and reports the results
+     *
+     * @return worst nagios state of all hosts (or STATE_UNKNOWN when
+     *         passive check results can't be submitted)
+     */
+    int run()
+    {
+#ifdef _SNMPv3
+        SnmpComm::init_v3mp(); // once, before any thread is started
+#endif
+        mResults.assign( mHosts.size(), HostResult() );
+        mNextHost = 0;
+        mFinishedHosts = 0;
+        struct timeval now;
+        gettimeofday( &now, NULL );
+        mDeadline.tv_sec = mAlarmTimeout ? now.tv_sec + mAlarmTimeout : 0;
+        mDeadline.tv_nsec = now.tv_usec * 1000;
+        mTimedOut = false;
+
+#ifdef HAVE_PTHREAD
+        vector<pthread_t> workers;
+        unsigned nWorkers = mParallel < mHosts.size() ? mParallel : mHosts.size();
+        for( unsigned i = 0; i < nWorkers; ++i )
+        {
+            pthread_t tid;
+            if( 0 != pthread_create( &tid, NULL, multi_host_check_worker, this ) )
+                break;
+            workers.push_back( tid );
+        }
+
+        if( workers.empty() )
+            checkHosts(); // no threads available - check sequentially
+        else if( !mHostedEnv && mDeadline.tv_sec && !waitForHosts() )
+        {
+            // a host hangs beyond its deadline - report without it, the process ends anyway
+            int rc = mPassiveService.empty() ? reportResults() : submitResults();
+            getOutputStream().flush();
+            getErrorStream().flush();
+            _exit( rc );
+        }
+        for( vector<pthread_t>::iterator i = workers.begin(); i != workers.end(); ++i )
+            pthread_join( *i, NULL );
+#else
+        checkHosts();
+#endif
+
+        return mPassiveService.empty() ? reportResults() : submitResults();
+    }
+
+    /**
+     * worker loop - checks hosts until all hosts are done
+     */
+    void checkHosts()
+    {
+        SnmpSessionPool &sessionPool = mHostedEnv ? mHostedEnv->getSessionPool() : mOwnSessionPool;
+
+        for(;;)
+        {
+            size_t idx;
+
+            lock();
+            idx = mTimedOut ? mHosts.size() : mNextHost++;
+            unlock();
+
+            if( idx >= mHosts.size() )
+                break;
+
+            HostResult result;
+            unsigned timeout = mAlarmTimeout;
+            if( mDeadline.tv_sec )
+            {
+                time_t now = time( NULL );
+                if( now >= mDeadline.tv_sec )
+                {
+                    result.mOutput = timedOutMessage();
+                    storeResult( idx, result );
+                    continue;
+                }
+                timeout = static_cast<unsigned>( mDeadline.tv_sec - now );
+            }
+
+            vector<string> args( mArgs );
+            args.insert( args.begin() + 1, to_string( timeout ) );
+            args.insert( args.begin() + 1, "--alarm-timeout" );
+            args.insert( args.begin() + 1, mHosts[idx].mAddress );
+            args.insert( args.begin() + 1, "--host" );
+
+            vector<char *> argv;
+            for( vector<string>::iterator i = args.begin(); i != args.end(); ++i )
+                argv.push_back( const_cast<char *>( i->c_str() ) );
+            argv.push_back( NULL );
+
+            ostringstream out, err;
+            HostedEnvironment hostedEnv( out, err, sessionPool );
+
+            try
+            {
+                result.mState = mRunFunc( args.size(), &argv[0], &hostedEnv );
+            }
+            catch(hosted_exit &e)
+            {
+                result.mState = e.getExitCode();
+            }
+            catch(std::exception &e)
+            {
+                result.mState = STATE_UNKNOWN;
+                out << "UNKNOWN - " << e.what() << endl;
+            }
+
+            result.mOutput = out.str();
+            result.mError = err.str();
+            storeResult( idx, result );
+        }
+    }
+
+protected:
+    /**
+     * host to check
+     */
+    struct HostEntry
+    {
+        HostEntry( string const &address, string const &name )
+            : mAddress( address )
+            , mName( name )
+        {}
+
+        /**
+         * address passed to the plugin via --host
+         */
+        string mAddress;
+        /**
+         * name used in the output and the passive check results
+         */
+        string mName;
+    };
+
+    /**
+     * result of the check of one host
+     */
+    struct HostResult
+    {
+        HostResult()
+            : mState( STATE_UNKNOWN )
+            , mOutput()
+            , mError()
+            , mFinished( false )
+        {}
+
+        int mState;
+        string mOutput;
+        string mError;
+        bool mFinished;
+    };
+
+    CheckPluginRunFunc mRunFunc;
+    HostedEnvironment *mHostedEnv;
+    SnmpSessionPool mOwnSessionPool;
+    vector<HostEntry> mHosts;
+    vector<string> mArgs;
+    string mHostsFile;
+    unsigned mParallel;
+    string mPassiveService;
+    string mCommandFile;
+    vector<HostResult> mResults;
+    size_t mNextHost;
+    size_t mFinishedHosts;
+    unsigned mAlarmTimeout;
+    struct timespec mDeadline;
+    bool mTimedOut;
+#ifdef HAVE_PTHREAD
+    pthread_mutex_t mMutex;
+    pthread_cond_t mFinishedCond;
+#endif
+
+    inline void lock()
+    {
+#ifdef HAVE_PTHREAD
+        pthread_mutex_lock( &mMutex );
+#endif
+    }
+
+    inline void unlock()
+    {
+#ifdef HAVE_PTHREAD
+        pthread_mutex_unlock( &mMutex );
+#endif
+    }
+
+    /**
+     * stores the result of a host unless the run timed out meanwhile
+     */
+    void storeResult( size_t idx, HostResult const &result )
+    {
+        lock();
+        if( !mTimedOut )
+        {
+            mResults[idx] = result;
+            mResults[idx].mFinished = true;
+            ++mFinishedHosts;
+#ifdef HAVE_PTHREAD
+            pthread_cond_signal( &mFinishedCond );
+#endif
+        }
+        unlock();
+    }
+
+    string timedOutMessage() const
+    {
+        return "UNKNOWN - not checked within the alarm timeout of " + to_string( mAlarmTimeout ) + " seconds\n";
+    }
+
+#ifdef HAVE_PTHREAD
+    /**
+     * waits until all hosts are checked or the deadline is reached
+     *
+     * On timeout, the hosts not finished are reported as UNKNOWN and the
+     * workers don't store any result anymore.
+     *
+     * @return true when all hosts are checked, false on timeout
+     */
+    bool waitForHosts()
+    {
+        lock();
+        while( mFinishedHosts < mHosts.size() )
+        {
+            if( ETIMEDOUT == pthread_cond_timedwait( &mFinishedCond, &mMutex, &mDeadline ) )
+                break;
+        }
+
+        bool finished = mFinishedHosts == mHosts.size();
+        if( !finished )
+        {
+            mTimedOut = true;
+            for( vector<HostResult>::iterator i = mResults.begin(); i != mResults.end(); ++i )
+            {
+                if( !i->mFinished )
+                    i->mOutput = timedOutMessage();
+            }
+        }
+        unlock();
+
+        return finished;
+    }
+#endif
+
+    inline ostream & getOutputStream() const { return mHostedEnv ? mHostedEnv->getOutput() : cout; }
+    inline ostream & getErrorStream() const { return mHostedEnv ? mHostedEnv->getError() : cerr; }
+
+    /**
+     * checks whether arg is the given option and extracts its value
+     *
+     * Handles "-X value", "-Xvalue", "--long value" and "--long=value".
+     */
+    static bool getOptionValue( const char *shortOpt, const char *longOpt, string const &arg,
+                                int argc, char *argv[], int &i, string &value )
+    {
+        string longPrefix = string( longOpt ) + "=";
+
+        if( ( shortOpt && ( arg == shortOpt ) ) || ( arg == longOpt ) )
+        {
+            if( i + 1 >= argc )
+                throw option_error( string( "Option '" ) + ( longOpt + 2 ) + "' requires an argument." );
+            value = argv[++i];
+            return true;
+        }
+        if( 0 == arg.compare( 0, longPrefix.length(), longPrefix ) )
+        {
+            value = arg.substr( longPrefix.length() );
+            return true;
+        }
+        if( shortOpt && ( arg.length() > 2 ) && ( 0 == arg.compare( 0, 2, shortOpt ) ) )
+        {
+            value = arg.substr( 2 );
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * reads the hosts from given file - empty lines and comments (#) are skipped
+     */
+    void readHostsFile( string const &fileName )
+    {
+        ifstream ifs( fileName.c_str() );
+        if( !ifs )
+            throw runtime_error( string( "Can't open hosts file '" ) + fileName + "'" );
+
+        string line;
+        while( getline( ifs, line ) )
+        {
+            string::size_type pos = line.find( '#' );
+            if( pos != string::npos )
+                line.erase( pos );
+
+            istringstream iss( line );
+            string address, name;
+            if( !( iss >> address ) )
+                continue;
+            if( !( iss >> name ) )
+                name = address;
+
+            mHosts.push_back( HostEntry( address, name ) );
+        }
+    }
+
+    /**
+     * prints the result lines of all hosts, prefixed with the host name
+     *
+     * @return worst state of all hosts
+     */
+    int reportResults()
+    {
+        ostream &os = getOutputStream();
+        ostream &es = getErrorStream();
+        int worstState = STATE_OK;
+
+        for( size_t i = 0; i < mResults.size(); ++i )
+        {
+            printPrefixed( os, mHosts[i].mName, mResults[i].mOutput );
+            printPrefixed( es, mHosts[i].mName, mResults[i].mError );
+
+            worstState = worse_state( worstState, mResults[i].mState );
+        }
+
+        return worstState;
+    }
+
+    /**
+     * writes PROCESS_SERVICE_CHECK_RESULT commands to the command file
+     *
+     * @return STATE_OK on success, STATE_UNKNOWN otherwise
+     */
+    int submitResults()
+    {
+        time_t now = time( NULL );
+
+        // the command file usually is a FIFO shared with other writers - only
+        // writes up to PIPE_BUF are atomic, so write each command on its own
+        int fd = open( mCommandFile.c_str(), O_WRONLY | O_APPEND );
+        bool ok = -1 != fd;
+
+        for( size_t i = 0; ok && ( i < mResults.size() ); ++i )
+        {
+            string output = mResults[i].mOutput;
+            string::size_type pos = output.find( '\n' );
+            if( pos != string::npos )
+                output.erase( pos );
+
+            ostringstream command;
+            command << "[" << now << "] PROCESS_SERVICE_CHECK_RESULT;" << mHosts[i].mName << ";"
+                    << mPassiveService << ";" << mResults[i].mState << ";";
+            string line = command.str();
+            if( line.length() + output.length() >= PIPE_BUF )
+                output.erase( ( line.length() + 1 < PIPE_BUF ) ? PIPE_BUF - line.length() - 1 : 0 );
+            line += output + "\n";
+
+            ok = write_all( fd, line.data(), line.length() );
+        }
+
+        if( -1 != fd )
+            close( fd );
+
+        if( !ok )
+        {
+            getOutputStream() << "UNKNOWN - can't submit check results to " << mCommandFile << ": " << strerror(errno) << endl;
+            return STATE_UNKNOWN;
+        }
+
+        getOutputStream() << "OK - submitted " << mResults.size() << " check results for " << mPassiveService << endl;
+        return STATE_OK;
+    }
+
+    /**
+     * writes len bytes of buf, continuing after interruptions and partial writes
+     *
+     * @return true on success, false otherwise (errno is set)
+     */
+    static bool write_all( int fd, char const *buf, size_t len )
+    {
+        while( len > 0 )
+        {
+            ssize_t n = write( fd, buf, len );
+            if( -1 == n )
+            {
+                if( EINTR == errno )
+                    continue;
+                return false;
+            }
+            buf += n;
+            len -= n;
+        }
+
+        return true;
+    }
+
+    static void printPrefixed( ostream &os, string const &prefix, string const &text )
+    {
+        istringstream iss( text );
+        string line;
+        while( getline( iss, line ) )
+            os << prefix << ": " << line << endl;
+    }
+
+private:
+    /**
+     * forbidden copy constructor
+     */
+    MultiHostCheck( MultiHostCheck const & );
+    /**
+     * forbidden assignment operator
+     */
+    MultiHostCheck & operator = ( MultiHostCheck const & );
+};
+
+extern "C"
+{
+static void *
+multi_host_check_worker(void *arg)
+{
+    static_cast<MultiHostCheck *>( arg )->checkHosts();
+    return NULL;
+}
+}
+
+/**
+ * runs a check plugin against one or many hosts
+ *
+ * @param argc - argument count
+ * @param argv - argument values
+ * @param runFunc - run function of the check plugin
+ * @param hostedEnv - environment of the hosting process, NULL when running standalone
+ *
+ * @return nagios state to use as exit code
+ */
+inline int
+run_check_plugin( int argc, char *argv[], CheckPluginRunFunc runFunc, HostedEnvironment *hostedEnv = NULL )
+{
+    MultiHostCheck multiHostCheck( runFunc, hostedEnv );
+
+    try
+    {
+        if( !multiHostCheck.setupFromCommandLine( argc, argv ) )
+            return runFunc( argc, argv, hostedEnv );
+
+        return multiHostCheck.run();
+    }
+    catch(std::exception &e)
+    {
+        ( hostedEnv ? hostedEnv->getOutput() : cout ) << "UNKNOWN - " << e.what() << endl;
+    }
+
+    return STATE_UNKNOWN;
+}
+
+#undef loggerModuleName
+
+#endif /* __SMART_SNMPD_NAGIOS_CHECKS_MULTI_HOST_CHECK_H_INCLUDED__ */
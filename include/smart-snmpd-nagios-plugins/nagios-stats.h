@@ -30,4 +30,27 @@
 
 static const char *states[] = { "OK", "WARNING", "CRITICAL", "UNKNOWN", "DEPENDENT", "UNKNOWN" };
 
+/**
+ * returns the more severe of two states
+ *
+ * The exit codes aren't ordered by severity: a critical state outranks
+ * an unknown one, so a part which couldn't be checked doesn't hide a
+ * critical part. Exit codes beyond UNKNOWN rank as UNKNOWN.
+ *
+ * @param a - first nagios state
+ * @param b - second nagios state
+ *
+ * @return a or b, whichever ranks higher in OK < WARNING < UNKNOWN < CRITICAL
+ */
+inline int
+worse_state( int a, int b )
+{
+    // severity rank of each exit code from STATE_OK to STATE_UNKNOWN
+    static const int ranks[] = { 0, 1, 3, 2 };
+    int rankA = ( a >= STATE_OK && a <= STATE_UNKNOWN ) ? ranks[a] : ranks[STATE_UNKNOWN];
+    int rankB = ( b >= STATE_OK && b <= STATE_UNKNOWN ) ? ranks[b] : ranks[STATE_UNKNOWN];
+
+    return ( rankB > rankA ) ? b : a;
+}
+
 #endif /* __SMART_SNMPD_NAGIOS_CHECKS_NAGIOS_STATS_H_INCLUDED__ */
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2010,2011 Matthias Haag, Jens Rehsack
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ *
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __SMART_SNMPD_NAGIOS_CHECKS_OID_TABLE_H_INCLUDED__
+#define __SMART_SNMPD_NAGIOS_CHECKS_OID_TABLE_H_INCLUDED__
+
+#include <smart-snmpd-nagios-plugins/snmp-pp-std.h>
+#include <smart-snmpd-nagios-plugins/oid-values.h>
+
+#include <stddef.h>
+
+#include <iterator>
+#include <vector>
+
+using namespace std;
+
+/**
+ * entry of an oid table: the oid NAME of oids.h
+ */
+#define OID_ENTRY(name) name##_LEN, name##_IDS
+
+/**
+ * entry of an oid table: the oid NAME of oids.h followed by instance
+ */
+#define OID_INSTANCE_ENTRY(name, instance) name##_LEN + 1, name##_IDS, instance
+
+/**
+ * view of a table of numeric oids in static storage
+ *
+ * The table is an array of unsigned long initialized at compile time by
+ * OID_ENTRY() and OID_INSTANCE_ENTRY(): each oid is given by the number
+ * of its sub-identifiers followed by the sub-identifiers. The Oid objects
+ * are built from the numbers when iterating, no dotted strings are
+ * parsed and the table itself is never copied.
+ */
+class StaticOidTable
+{
+public:
+    /**
+     * iterates the oids of the table
+     */
+    class const_iterator
+    {
+    public:
+        typedef input_iterator_tag iterator_category;
+        typedef Oid value_type;
+        typedef ptrdiff_t difference_type;
+        typedef Oid const * pointer;
+        typedef Oid reference;
+
+        explicit const_iterator( unsigned long const *pos = 0 ) : mPos( pos ) {}
+
+        Oid operator * () const { return Oid( mPos + 1, static_cast<int>( *mPos ) ); }
+
+        const_iterator & operator ++ () { mPos += 1 + *mPos; return *this; }
+        const_iterator operator ++ (int) { const_iterator prev( *this ); ++*this; return prev; }
+
+        bool operator == ( const_iterator const &r ) const { return mPos == r.mPos; }
+        bool operator != ( const_iterator const &r ) const { return mPos != r.mPos; }
+
+    protected:
+        unsigned long const *mPos;
+    };
+
+    /**
+     * @param values - table built by OID_ENTRY() and OID_INSTANCE_ENTRY()
+     */
+    template<size_t N>
+    StaticOidTable( unsigned long const (&values)[N] )
+        : mBegin( values )
+        , mEnd( values + N )
+    {}
+
+    const_iterator begin() const { return const_iterator( mBegin ); }
+    const_iterator end() const { return const_iterator( mEnd ); }
+
+    /**
+     * @return number of oids in the table
+     */
+    size_t size() const
+    {
+        size_t n = 0;
+        for( unsigned long const *pos = mBegin; pos < mEnd; pos += 1 + *pos )
+            ++n;
+        return n;
+    }
+
+    /**
+     * @return the oids of the table, built without parsing
+     */
+    vector<Oid> to_vector() const
+    {
+        vector<Oid> oids;
+        oids.reserve( size() );
+        oids.insert( oids.end(), begin(), end() );
+        return oids;
+    }
+
+protected:
+    unsigned long const *mBegin;
+    unsigned long const *mEnd;
+};
+
+#endif /* __SMART_SNMPD_NAGIOS_CHECKS_OID_TABLE_H_INCLUDED__ */
@@ -0,0 +1,63 @@
+# Generates oid-values.h from oids.h:
+#
+#   awk -f oid-values.awk oids.h > oid-values.h
+#
+# For each "#define NAME [PARENT] "dotted"" in oids.h, NAME_LEN is defined
+# as the number of sub-identifiers and NAME_IDS as the comma separated
+# sub-identifiers - usable in aggregate initializers (see oid-table.h).
+
+BEGIN {
+    print "/*"
+    print " * Copyright 2010,2011 Matthias Haag, Jens Rehsack"
+    print " *"
+    print " * Licensed under the Apache License, Version 2.0 (the \"License\");"
+    print " *"
+    print " * you may not use this file except in compliance with the License."
+    print " * You may obtain a copy of the License at"
+    print " *"
+    print " *     http://www.apache.org/licenses/LICENSE-2.0"
+    print " *"
+    print " * Unless required by applicable law or agreed to in writing, software"
+    print " * distributed under the License is distributed on an \"AS IS\" BASIS,"
+    print " * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied."
+    print " * See the License for the specific language governing permissions and"
+    print " * limitations under the License."
+    print " */"
+    print ""
+    print "/* generated from oids.h by oid-values.awk - don't edit */"
+    print ""
+    print "#ifndef __SMART_SNMPD_NAGIOS_CHECKS_OID_VALUES_H_INCLUDED__"
+    print "#define __SMART_SNMPD_NAGIOS_CHECKS_OID_VALUES_H_INCLUDED__"
+}
+
+/^#define[ \t]+[A-Z0-9_]+[ \t]+([A-Z0-9_]+[ \t]+)?"[0-9.]*"[ \t]*$/ {
+    name = $2
+    dotted = ""
+    for( i = 3; i <= NF; ++i )
+    {
+        if( $i ~ /^"/ )
+            dotted = dotted substr( $i, 2, length( $i ) - 2 )
+        else if( $i in oids )
+            dotted = dotted oids[$i]
+        else
+        {
+            print "oid-values.awk: unknown parent " $i " of " name > "/dev/stderr"
+            exit 1
+        }
+    }
+    oids[name] = dotted
+
+    n = split( dotted, ids, "." )
+    list = ""
+    for( i = 1; i <= n; ++i )
+        list = list ( list == "" ? "" : ", " ) ids[i]
+
+    print ""
+    print "#define " name "_LEN " n
+    print "#define " name "_IDS " list
+}
+
+END {
+    print ""
+    print "#endif /* __SMART_SNMPD_NAGIOS_CHECKS_OID_VALUES_H_INCLUDED__ */"
+}
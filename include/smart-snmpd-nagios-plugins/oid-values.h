@@ -0,0 +1,1133 @@
+/*
+ * Copyright 2010,2011 Matthias Haag, Jens Rehsack
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ *
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* generated from oids.h by oid-values.awk - don't edit */
+
+#ifndef __SMART_SNMPD_NAGIOS_CHECKS_OID_VALUES_H_INCLUDED__
+#define __SMART_SNMPD_NAGIOS_CHECKS_OID_VALUES_H_INCLUDED__
+
+#define MIB_INET_LEN 4
+#define MIB_INET_IDS 1, 3, 6, 1
+
+#define MIB_DIRECTORY_LEN 5
+#define MIB_DIRECTORY_IDS 1, 3, 6, 1, 1
+
+#define MIB_MGMT_LEN 5
+#define MIB_MGMT_IDS 1, 3, 6, 1, 2
+
+#define MIB_II_LEN 6
+#define MIB_II_IDS 1, 3, 6, 1, 2, 1
+
+#define MIB_SYSTEM_LEN 7
+#define MIB_SYSTEM_IDS 1, 3, 6, 1, 2, 1, 1
+
+#define SYS_DESCRIPTION_LEN 8
+#define SYS_DESCRIPTION_IDS 1, 3, 6, 1, 2, 1, 1, 1
+
+#define SYS_OBJECT_ID_LEN 8
+#define SYS_OBJECT_ID_IDS 1, 3, 6, 1, 2, 1, 1, 2
+
+#define SYS_UPTIME_LEN 8
+#define SYS_UPTIME_IDS 1, 3, 6, 1, 2, 1, 1, 3
+
+#define SYS_CONTACT_LEN 8
+#define SYS_CONTACT_IDS 1, 3, 6, 1, 2, 1, 1, 4
+
+#define SYS_NAME_LEN 8
+#define SYS_NAME_IDS 1, 3, 6, 1, 2, 1, 1, 5
+
+#define SYS_LOCATION_LEN 8
+#define SYS_LOCATION_IDS 1, 3, 6, 1, 2, 1, 1, 6
+
+#define SYS_SERVICES_LEN 8
+#define SYS_SERVICES_IDS 1, 3, 6, 1, 2, 1, 1, 7
+
+#define MIB_INTERFACES_LEN 7
+#define MIB_INTERFACES_IDS 1, 3, 6, 1, 2, 1, 2
+
+#define MIB_AT_LEN 7
+#define MIB_AT_IDS 1, 3, 6, 1, 2, 1, 3
+
+#define MIB_IP_LEN 7
+#define MIB_IP_IDS 1, 3, 6, 1, 2, 1, 4
+
+#define MIB_ICMP_LEN 7
+#define MIB_ICMP_IDS 1, 3, 6, 1, 2, 1, 5
+
+#define MIB_TCP_LEN 7
+#define MIB_TCP_IDS 1, 3, 6, 1, 2, 1, 6
+
+#define MIB_UDP_LEN 7
+#define MIB_UDP_IDS 1, 3, 6, 1, 2, 1, 7
+
+#define MIB_EGP_LEN 7
+#define MIB_EGP_IDS 1, 3, 6, 1, 2, 1, 8
+
+#define MIB_TRANSMISSION_LEN 7
+#define MIB_TRANSMISSION_IDS 1, 3, 6, 1, 2, 1, 10
+
+#define MIB_SNMP_LEN 7
+#define MIB_SNMP_IDS 1, 3, 6, 1, 2, 1, 11
+
+#define MIB_HOST_LEN 7
+#define MIB_HOST_IDS 1, 3, 6, 1, 2, 1, 25
+
+#define HR_SYSTEM_MIB_LEN 8
+#define HR_SYSTEM_MIB_IDS 1, 3, 6, 1, 2, 1, 25, 1
+
+#define HR_SYSTEM_UPTIME_LEN 9
+#define HR_SYSTEM_UPTIME_IDS 1, 3, 6, 1, 2, 1, 25, 1, 1
+
+#define HR_SYSTEM_DATE_LEN 9
+#define HR_SYSTEM_DATE_IDS 1, 3, 6, 1, 2, 1, 25, 1, 2
+
+#define HR_SYSTEM_INITIAL_LOAD_DEVICE_LEN 9
+#define HR_SYSTEM_INITIAL_LOAD_DEVICE_IDS 1, 3, 6, 1, 2, 1, 25, 1, 3
+
+#define HR_SYSTEM_INITIAL_LOAD_PARAMETERS_LEN 9
+#define HR_SYSTEM_INITIAL_LOAD_PARAMETERS_IDS 1, 3, 6, 1, 2, 1, 25, 1, 4
+
+#define HR_SYSTEM_NUM_USERS_LEN 9
+#define HR_SYSTEM_NUM_USERS_IDS 1, 3, 6, 1, 2, 1, 25, 1, 5
+
+#define HR_SYSTEM_PROCESSES_LEN 9
+#define HR_SYSTEM_PROCESSES_IDS 1, 3, 6, 1, 2, 1, 25, 1, 6
+
+#define HR_SYSTEM_MAX_PROCESSES_LEN 9
+#define HR_SYSTEM_MAX_PROCESSES_IDS 1, 3, 6, 1, 2, 1, 25, 1, 7
+
+#define HR_STORAGE_MIB_LEN 8
+#define HR_STORAGE_MIB_IDS 1, 3, 6, 1, 2, 1, 25, 2
+
+#define HR_MEMORY_SIZE_LEN 9
+#define HR_MEMORY_SIZE_IDS 1, 3, 6, 1, 2, 1, 25, 2, 2
+
+#define HR_STORAGE_TABLE_LEN 9
+#define HR_STORAGE_TABLE_IDS 1, 3, 6, 1, 2, 1, 25, 2, 3
+
+#define HR_STORAGE_ENTRY_LEN 10
+#define HR_STORAGE_ENTRY_IDS 1, 3, 6, 1, 2, 1, 25, 2, 3, 1
+
+#define HR_STORAGE_INDEX_LEN 11
+#define HR_STORAGE_INDEX_IDS 1, 3, 6, 1, 2, 1, 25, 2, 3, 1, 1
+
+#define HR_STORAGE_TYPE_LEN 11
+#define HR_STORAGE_TYPE_IDS 1, 3, 6, 1, 2, 1, 25, 2, 3, 1, 2
+
+#define HR_STORAGE_DESCR_LEN 11
+#define HR_STORAGE_DESCR_IDS 1, 3, 6, 1, 2, 1, 25, 2, 3, 1, 3
+
+#define HR_STORAGE_ALLOC_UNITS_LEN 11
+#define HR_STORAGE_ALLOC_UNITS_IDS 1, 3, 6, 1, 2, 1, 25, 2, 3, 1, 4
+
+#define HR_STORAGE_SIZE_LEN 11
+#define HR_STORAGE_SIZE_IDS 1, 3, 6, 1, 2, 1, 25, 2, 3, 1, 5
+
+#define HR_STORAGE_USED_LEN 11
+#define HR_STORAGE_USED_IDS 1, 3, 6, 1, 2, 1, 25, 2, 3, 1, 6
+
+#define HR_STORAGE_ALLOC_FAILURES_LEN 11
+#define HR_STORAGE_ALLOC_FAILURES_IDS 1, 3, 6, 1, 2, 1, 25, 2, 3, 1, 7
+
+#define HR_DEVICE_MIB_LEN 8
+#define HR_DEVICE_MIB_IDS 1, 3, 6, 1, 2, 1, 25, 3
+
+#define HR_DEVICE_TYPES_LEN 9
+#define HR_DEVICE_TYPES_IDS 1, 3, 6, 1, 2, 1, 25, 3, 1
+
+#define HR_DEVICE_TABLE_LEN 9
+#define HR_DEVICE_TABLE_IDS 1, 3, 6, 1, 2, 1, 25, 3, 2
+
+#define HR_DEVICE_ENTRY_LEN 10
+#define HR_DEVICE_ENTRY_IDS 1, 3, 6, 1, 2, 1, 25, 3, 2, 1
+
+#define HR_DEVICE_INDEX_LEN 11
+#define HR_DEVICE_INDEX_IDS 1, 3, 6, 1, 2, 1, 25, 3, 2, 1, 1
+
+#define HR_DEVICE_TYPE_LEN 11
+#define HR_DEVICE_TYPE_IDS 1, 3, 6, 1, 2, 1, 25, 3, 2, 1, 2
+
+#define HR_DEVICE_DESCR_LEN 11
+#define HR_DEVICE_DESCR_IDS 1, 3, 6, 1, 2, 1, 25, 3, 2, 1, 3
+
+#define HR_DEVICE_ID_LEN 11
+#define HR_DEVICE_ID_IDS 1, 3, 6, 1, 2, 1, 25, 3, 2, 1, 4
+
+#define HR_DEVICE_STATUS_LEN 11
+#define HR_DEVICE_STATUS_IDS 1, 3, 6, 1, 2, 1, 25, 3, 2, 1, 5
+
+#define HR_DEVICE_ERRORS_LEN 11
+#define HR_DEVICE_ERRORS_IDS 1, 3, 6, 1, 2, 1, 25, 3, 2, 1, 6
+
+#define HR_PROCESSOR_TABLE_LEN 9
+#define HR_PROCESSOR_TABLE_IDS 1, 3, 6, 1, 2, 1, 25, 3, 3
+
+#define HR_PROCESSOR_ENTRY_LEN 10
+#define HR_PROCESSOR_ENTRY_IDS 1, 3, 6, 1, 2, 1, 25, 3, 3, 1
+
+#define HR_PROCESSOR_FRWID_LEN 11
+#define HR_PROCESSOR_FRWID_IDS 1, 3, 6, 1, 2, 1, 25, 3, 3, 1, 1
+
+#define HR_PROCESSOR_LOAD_LEN 11
+#define HR_PROCESSOR_LOAD_IDS 1, 3, 6, 1, 2, 1, 25, 3, 3, 1, 2
+
+#define HR_NETWORK_TABLE_LEN 9
+#define HR_NETWORK_TABLE_IDS 1, 3, 6, 1, 2, 1, 25, 3, 4
+
+#define HR_NETWORK_ENTRY_LEN 10
+#define HR_NETWORK_ENTRY_IDS 1, 3, 6, 1, 2, 1, 25, 3, 4, 1
+
+#define HR_NETWORK_IF_INDEX_LEN 11
+#define HR_NETWORK_IF_INDEX_IDS 1, 3, 6, 1, 2, 1, 25, 3, 4, 1, 1
+
+#define HR_PRINTER_TABLE_LEN 9
+#define HR_PRINTER_TABLE_IDS 1, 3, 6, 1, 2, 1, 25, 3, 5
+
+#define HR_PRINTER_ENTRY_LEN 10
+#define HR_PRINTER_ENTRY_IDS 1, 3, 6, 1, 2, 1, 25, 3, 5, 1
+
+#define HR_PRINTER_STATUS_LEN 11
+#define HR_PRINTER_STATUS_IDS 1, 3, 6, 1, 2, 1, 25, 3, 5, 1, 1
+
+#define HR_PRINTER_DETECTED_ERROR_STATE_LEN 11
+#define HR_PRINTER_DETECTED_ERROR_STATE_IDS 1, 3, 6, 1, 2, 1, 25, 3, 5, 1, 2
+
+#define HR_DISK_STORAGE_TABLE_LEN 9
+#define HR_DISK_STORAGE_TABLE_IDS 1, 3, 6, 1, 2, 1, 25, 3, 6
+
+#define HR_DISK_STORAGE_ENTRY_LEN 10
+#define HR_DISK_STORAGE_ENTRY_IDS 1, 3, 6, 1, 2, 1, 25, 3, 6, 1
+
+#define HR_DISK_STORAGE_ACCESS_LEN 11
+#define HR_DISK_STORAGE_ACCESS_IDS 1, 3, 6, 1, 2, 1, 25, 3, 6, 1, 1
+
+#define HR_DISK_STORAGE_MEDIA_LEN 11
+#define HR_DISK_STORAGE_MEDIA_IDS 1, 3, 6, 1, 2, 1, 25, 3, 6, 1, 2
+
+#define HR_DISK_STORAGE_REMOVABLE_LEN 11
+#define HR_DISK_STORAGE_REMOVABLE_IDS 1, 3, 6, 1, 2, 1, 25, 3, 6, 1, 3
+
+#define HR_DISK_STORAGE_CAPACITY_LEN 11
+#define HR_DISK_STORAGE_CAPACITY_IDS 1, 3, 6, 1, 2, 1, 25, 3, 6, 1, 4
+
+#define HR_PARTITION_TABLE_LEN 9
+#define HR_PARTITION_TABLE_IDS 1, 3, 6, 1, 2, 1, 25, 3, 7
+
+#define HR_PARTITION_ENTRY_LEN 10
+#define HR_PARTITION_ENTRY_IDS 1, 3, 6, 1, 2, 1, 25, 3, 7, 1
+
+#define HR_PARTITION_INDEX_LEN 11
+#define HR_PARTITION_INDEX_IDS 1, 3, 6, 1, 2, 1, 25, 3, 7, 1, 1
+
+#define HR_PARTITION_LABEL_LEN 11
+#define HR_PARTITION_LABEL_IDS 1, 3, 6, 1, 2, 1, 25, 3, 7, 1, 2
+
+#define HR_PARTITION_ID_LEN 11
+#define HR_PARTITION_ID_IDS 1, 3, 6, 1, 2, 1, 25, 3, 7, 1, 3
+
+#define HR_PARTITION_SIZE_LEN 11
+#define HR_PARTITION_SIZE_IDS 1, 3, 6, 1, 2, 1, 25, 3, 7, 1, 4
+
+#define HR_PARTITION_FSINDEX_LEN 11
+#define HR_PARTITION_FSINDEX_IDS 1, 3, 6, 1, 2, 1, 25, 3, 7, 1, 5
+
+#define HR_FILESYSTEM_TABLE_LEN 9
+#define HR_FILESYSTEM_TABLE_IDS 1, 3, 6, 1, 2, 1, 25, 3, 8
+
+#define HR_FILESYSTEM_ENTRY_LEN 10
+#define HR_FILESYSTEM_ENTRY_IDS 1, 3, 6, 1, 2, 1, 25, 3, 8, 1
+
+#define HR_FILESYSTEM_INDEX_LEN 11
+#define HR_FILESYSTEM_INDEX_IDS 1, 3, 6, 1, 2, 1, 25, 3, 8, 1, 1
+
+#define HR_FILESYSTEM_MOUNTPOINT_LEN 11
+#define HR_FILESYSTEM_MOUNTPOINT_IDS 1, 3, 6, 1, 2, 1, 25, 3, 8, 1, 2
+
+#define HR_FILESYSTEM_REMOTE_MOUNTPOINT_LEN 11
+#define HR_FILESYSTEM_REMOTE_MOUNTPOINT_IDS 1, 3, 6, 1, 2, 1, 25, 3, 8, 1, 3
+
+#define HR_FILESYSTEM_TYPE_LEN 11
+#define HR_FILESYSTEM_TYPE_IDS 1, 3, 6, 1, 2, 1, 25, 3, 8, 1, 4
+
+#define HR_FILESYSTEM_ACCESS_LEN 11
+#define HR_FILESYSTEM_ACCESS_IDS 1, 3, 6, 1, 2, 1, 25, 3, 8, 1, 5
+
+#define HR_FILESYSTEM_BOOTABLE_LEN 11
+#define HR_FILESYSTEM_BOOTABLE_IDS 1, 3, 6, 1, 2, 1, 25, 3, 8, 1, 6
+
+#define HR_FILESYSTEM_STORAGE_INDEX_LEN 11
+#define HR_FILESYSTEM_STORAGE_INDEX_IDS 1, 3, 6, 1, 2, 1, 25, 3, 8, 1, 7
+
+#define HR_FILESYSTEM_LAST_FULL_BACKUP_DATE_LEN 11
+#define HR_FILESYSTEM_LAST_FULL_BACKUP_DATE_IDS 1, 3, 6, 1, 2, 1, 25, 3, 8, 1, 8
+
+#define HR_FILESYSTEM_LAST_PARTIAL_BACKUP_DATE_LEN 11
+#define HR_FILESYSTEM_LAST_PARTIAL_BACKUP_DATE_IDS 1, 3, 6, 1, 2, 1, 25, 3, 8, 1, 9
+
+#define HR_FILESYSTEM_TYPES_LEN 9
+#define HR_FILESYSTEM_TYPES_IDS 1, 3, 6, 1, 2, 1, 25, 3, 9
+
+#define HR_SWRUN_MIB_LEN 8
+#define HR_SWRUN_MIB_IDS 1, 3, 6, 1, 2, 1, 25, 4
+
+#define HR_SW_OS_INDEX_LEN 9
+#define HR_SW_OS_INDEX_IDS 1, 3, 6, 1, 2, 1, 25, 4, 1
+
+#define HR_SWRUN_TABLE_LEN 9
+#define HR_SWRUN_TABLE_IDS 1, 3, 6, 1, 2, 1, 25, 4, 2
+
+#define HR_SWRUN_ENTRY_LEN 10
+#define HR_SWRUN_ENTRY_IDS 1, 3, 6, 1, 2, 1, 25, 4, 2, 1
+
+#define HR_SWRUN_INDEX_LEN 11
+#define HR_SWRUN_INDEX_IDS 1, 3, 6, 1, 2, 1, 25, 4, 2, 1, 1
+
+#define HR_SWRUN_NAME_LEN 11
+#define HR_SWRUN_NAME_IDS 1, 3, 6, 1, 2, 1, 25, 4, 2, 1, 2
+
+#define HR_SWRUN_ID_LEN 11
+#define HR_SWRUN_ID_IDS 1, 3, 6, 1, 2, 1, 25, 4, 2, 1, 3
+
+#define HR_SWRUN_PATH_LEN 11
+#define HR_SWRUN_PATH_IDS 1, 3, 6, 1, 2, 1, 25, 4, 2, 1, 4
+
+#define HR_SWRUN_PARAMETERS_LEN 11
+#define HR_SWRUN_PARAMETERS_IDS 1, 3, 6, 1, 2, 1, 25, 4, 2, 1, 5
+
+#define HR_SWRUN_TYPE_LEN 11
+#define HR_SWRUN_TYPE_IDS 1, 3, 6, 1, 2, 1, 25, 4, 2, 1, 6
+
+#define HR_SWRUN_STATUS_LEN 11
+#define HR_SWRUN_STATUS_IDS 1, 3, 6, 1, 2, 1, 25, 4, 2, 1, 7
+
+#define HR_SWRUN_PERF_MIB_LEN 8
+#define HR_SWRUN_PERF_MIB_IDS 1, 3, 6, 1, 2, 1, 25, 5
+
+#define HR_SWRUN_PERF_TABLE_LEN 9
+#define HR_SWRUN_PERF_TABLE_IDS 1, 3, 6, 1, 2, 1, 25, 5, 1
+
+#define HR_SWRUN_PERF_ENTRY_LEN 10
+#define HR_SWRUN_PERF_ENTRY_IDS 1, 3, 6, 1, 2, 1, 25, 5, 1, 1
+
+#define HR_SWRUN_PERF_CPU_LEN 11
+#define HR_SWRUN_PERF_CPU_IDS 1, 3, 6, 1, 2, 1, 25, 5, 1, 1, 1
+
+#define HR_SWRUN_PERF_MEM_LEN 11
+#define HR_SWRUN_PERF_MEM_IDS 1, 3, 6, 1, 2, 1, 25, 5, 1, 1, 2
+
+#define HR_SWRUN_INSTALLED_MIB_LEN 8
+#define HR_SWRUN_INSTALLED_MIB_IDS 1, 3, 6, 1, 2, 1, 25, 6
+
+#define HR_SW_INSTALLED_LAST_CHANGE_LEN 9
+#define HR_SW_INSTALLED_LAST_CHANGE_IDS 1, 3, 6, 1, 2, 1, 25, 6, 1
+
+#define HR_SW_INSTALLED_LAST_UPDATE_TIME_LEN 9
+#define HR_SW_INSTALLED_LAST_UPDATE_TIME_IDS 1, 3, 6, 1, 2, 1, 25, 6, 2
+
+#define HR_SW_INSTALLED_TABLE_LEN 9
+#define HR_SW_INSTALLED_TABLE_IDS 1, 3, 6, 1, 2, 1, 25, 6, 3
+
+#define HR_SW_INSTALLED_ENTRY_LEN 10
+#define HR_SW_INSTALLED_ENTRY_IDS 1, 3, 6, 1, 2, 1, 25, 6, 3, 1
+
+#define HR_SW_INSTALLED_INDEX_LEN 11
+#define HR_SW_INSTALLED_INDEX_IDS 1, 3, 6, 1, 2, 1, 25, 6, 3, 1, 1
+
+#define HR_SW_INSTALLED_NAME_LEN 11
+#define HR_SW_INSTALLED_NAME_IDS 1, 3, 6, 1, 2, 1, 25, 6, 3, 1, 2
+
+#define HR_SW_INSTALLED_ID_LEN 11
+#define HR_SW_INSTALLED_ID_IDS 1, 3, 6, 1, 2, 1, 25, 6, 3, 1, 3
+
+#define HR_SW_INSTALLED_TYPE_LEN 11
+#define HR_SW_INSTALLED_TYPE_IDS 1, 3, 6, 1, 2, 1, 25, 6, 3, 1, 4
+
+#define HR_SW_INSTALLED_DATE_LEN 11
+#define HR_SW_INSTALLED_DATE_IDS 1, 3, 6, 1, 2, 1, 25, 6, 3, 1, 5
+
+#define HR_MIB_ADMIN_INFO_MIB_LEN 8
+#define HR_MIB_ADMIN_INFO_MIB_IDS 1, 3, 6, 1, 2, 1, 25, 7
+
+#define MIB_EXPERIMENTAL_LEN 5
+#define MIB_EXPERIMENTAL_IDS 1, 3, 6, 1, 3
+
+#define MIB_PRIVATE_LEN 5
+#define MIB_PRIVATE_IDS 1, 3, 6, 1, 4
+
+#define MIB_ENTERPRISE_LEN 6
+#define MIB_ENTERPRISE_IDS 1, 3, 6, 1, 4, 1
+
+#define UCDAVIS_MIB_LEN 7
+#define UCDAVIS_MIB_IDS 1, 3, 6, 1, 4, 1, 2021
+
+#define UCD_MEMORY_LEN 8
+#define UCD_MEMORY_IDS 1, 3, 6, 1, 4, 1, 2021, 4
+
+#define UCD_MEM_INDEX_LEN 9
+#define UCD_MEM_INDEX_IDS 1, 3, 6, 1, 4, 1, 2021, 4, 1
+
+#define UCD_MEM_ERROR_NAME_LEN 9
+#define UCD_MEM_ERROR_NAME_IDS 1, 3, 6, 1, 4, 1, 2021, 4, 2
+
+#define UCD_MEM_TOTAL_SWAP_LEN 9
+#define UCD_MEM_TOTAL_SWAP_IDS 1, 3, 6, 1, 4, 1, 2021, 4, 3
+
+#define UCD_MEM_AVAIL_SWAP_LEN 9
+#define UCD_MEM_AVAIL_SWAP_IDS 1, 3, 6, 1, 4, 1, 2021, 4, 4
+
+#define UCD_MEM_TOTAL_REAL_LEN 9
+#define UCD_MEM_TOTAL_REAL_IDS 1, 3, 6, 1, 4, 1, 2021, 4, 5
+
+#define UCD_MEM_AVAIL_REAL_LEN 9
+#define UCD_MEM_AVAIL_REAL_IDS 1, 3, 6, 1, 4, 1, 2021, 4, 6
+
+#define UCD_MEM_TOTAL_SWAP_TXT_LEN 9
+#define UCD_MEM_TOTAL_SWAP_TXT_IDS 1, 3, 6, 1, 4, 1, 2021, 4, 7
+
+#define UCD_MEM_AVAIL_SWAP_TXT_LEN 9
+#define UCD_MEM_AVAIL_SWAP_TXT_IDS 1, 3, 6, 1, 4, 1, 2021, 4, 8
+
+#define UCD_MEM_TOTAL_REAL_TXT_LEN 9
+#define UCD_MEM_TOTAL_REAL_TXT_IDS 1, 3, 6, 1, 4, 1, 2021, 4, 9
+
+#define UCD_MEM_AVAIL_REAL_TXT_LEN 9
+#define UCD_MEM_AVAIL_REAL_TXT_IDS 1, 3, 6, 1, 4, 1, 2021, 4, 10
+
+#define UCD_MEM_TOTAL_FREE_LEN 9
+#define UCD_MEM_TOTAL_FREE_IDS 1, 3, 6, 1, 4, 1, 2021, 4, 11
+
+#define UCD_MEM_MINIMUM_SWAP_LEN 9
+#define UCD_MEM_MINIMUM_SWAP_IDS 1, 3, 6, 1, 4, 1, 2021, 4, 12
+
+#define UCD_MEM_SHARED_LEN 9
+#define UCD_MEM_SHARED_IDS 1, 3, 6, 1, 4, 1, 2021, 4, 13
+
+#define UCD_MEM_BUFFER_LEN 9
+#define UCD_MEM_BUFFER_IDS 1, 3, 6, 1, 4, 1, 2021, 4, 14
+
+#define UCD_MEM_CACHED_LEN 9
+#define UCD_MEM_CACHED_IDS 1, 3, 6, 1, 4, 1, 2021, 4, 15
+
+#define UCD_MEM_USED_SWAP_TXT_LEN 9
+#define UCD_MEM_USED_SWAP_TXT_IDS 1, 3, 6, 1, 4, 1, 2021, 4, 16
+
+#define UCD_MEM_USED_REAL_TXT_LEN 9
+#define UCD_MEM_USED_REAL_TXT_IDS 1, 3, 6, 1, 4, 1, 2021, 4, 17
+
+#define UCD_LOAD_TABLE_LEN 8
+#define UCD_LOAD_TABLE_IDS 1, 3, 6, 1, 4, 1, 2021, 10
+
+#define UCD_LA_ENTRY_LEN 9
+#define UCD_LA_ENTRY_IDS 1, 3, 6, 1, 4, 1, 2021, 10, 1
+
+#define UCD_LA_INDEX_LEN 10
+#define UCD_LA_INDEX_IDS 1, 3, 6, 1, 4, 1, 2021, 10, 1, 1
+
+#define UCD_LA_NAMES_LEN 10
+#define UCD_LA_NAMES_IDS 1, 3, 6, 1, 4, 1, 2021, 10, 1, 2
+
+#define UCD_LA_LOAD_LEN 10
+#define UCD_LA_LOAD_IDS 1, 3, 6, 1, 4, 1, 2021, 10, 1, 3
+
+#define UCD_LA_CONFIG_LEN 10
+#define UCD_LA_CONFIG_IDS 1, 3, 6, 1, 4, 1, 2021, 10, 1, 4
+
+#define UCD_LA_LOAD_INT_LEN 10
+#define UCD_LA_LOAD_INT_IDS 1, 3, 6, 1, 4, 1, 2021, 10, 1, 5
+
+#define UCD_LA_LOAD_FLOAT_LEN 10
+#define UCD_LA_LOAD_FLOAT_IDS 1, 3, 6, 1, 4, 1, 2021, 10, 1, 6
+
+#define UCD_LA_ERROR_FLAG_LEN 10
+#define UCD_LA_ERROR_FLAG_IDS 1, 3, 6, 1, 4, 1, 2021, 10, 1, 100
+
+#define UCD_LA_ERROR_MESSAGE_LEN 10
+#define UCD_LA_ERROR_MESSAGE_IDS 1, 3, 6, 1, 4, 1, 2021, 10, 1, 101
+
+#define UCD_SYSTEM_STATS_LEN 8
+#define UCD_SYSTEM_STATS_IDS 1, 3, 6, 1, 4, 1, 2021, 11
+
+#define UCD_SS_INDEX_LEN 9
+#define UCD_SS_INDEX_IDS 1, 3, 6, 1, 4, 1, 2021, 11, 1
+
+#define UCD_SS_ERROR_NAME_LEN 9
+#define UCD_SS_ERROR_NAME_IDS 1, 3, 6, 1, 4, 1, 2021, 11, 2
+
+#define UCD_SS_SWAP_IN_LEN 9
+#define UCD_SS_SWAP_IN_IDS 1, 3, 6, 1, 4, 1, 2021, 11, 3
+
+#define UCD_SS_SWAP_OUT_LEN 9
+#define UCD_SS_SWAP_OUT_IDS 1, 3, 6, 1, 4, 1, 2021, 11, 4
+
+#define UCD_SS_IO_SENT_LEN 9
+#define UCD_SS_IO_SENT_IDS 1, 3, 6, 1, 4, 1, 2021, 11, 5
+
+#define UCD_SS_IO_RECEIVE_LEN 9
+#define UCD_SS_IO_RECEIVE_IDS 1, 3, 6, 1, 4, 1, 2021, 11, 6
+
+#define UCD_SS_SYS_INTERRUPTS_LEN 9
+#define UCD_SS_SYS_INTERRUPTS_IDS 1, 3, 6, 1, 4, 1, 2021, 11, 7
+
+#define UCD_SS_SYS_CONTEXT_LEN 9
+#define UCD_SS_SYS_CONTEXT_IDS 1, 3, 6, 1, 4, 1, 2021, 11, 8
+
+#define UCD_SS_CPU_USER_LEN 9
+#define UCD_SS_CPU_USER_IDS 1, 3, 6, 1, 4, 1, 2021, 11, 9
+
+#define UCD_SS_CPU_SYSTEM_LEN 9
+#define UCD_SS_CPU_SYSTEM_IDS 1, 3, 6, 1, 4, 1, 2021, 11, 10
+
+#define UCD_SS_CPU_IDLE_LEN 9
+#define UCD_SS_CPU_IDLE_IDS 1, 3, 6, 1, 4, 1, 2021, 11, 11
+
+#define UCD_SS_CPU_RAW_USER_LEN 9
+#define UCD_SS_CPU_RAW_USER_IDS 1, 3, 6, 1, 4, 1, 2021, 11, 50
+
+#define UCD_SS_CPU_RAW_NICE_LEN 9
+#define UCD_SS_CPU_RAW_NICE_IDS 1, 3, 6, 1, 4, 1, 2021, 11, 51
+
+#define UCD_SS_CPU_RAW_SYSTEM_LEN 9
+#define UCD_SS_CPU_RAW_SYSTEM_IDS 1, 3, 6, 1, 4, 1, 2021, 11, 52
+
+#define UCD_SS_CPU_RAW_IDLE_LEN 9
+#define UCD_SS_CPU_RAW_IDLE_IDS 1, 3, 6, 1, 4, 1, 2021, 11, 53
+
+#define UCD_SS_CPU_RAW_WAIT_LEN 9
+#define UCD_SS_CPU_RAW_WAIT_IDS 1, 3, 6, 1, 4, 1, 2021, 11, 54
+
+#define UCD_SS_CPU_RAW_KERNEL_LEN 9
+#define UCD_SS_CPU_RAW_KERNEL_IDS 1, 3, 6, 1, 4, 1, 2021, 11, 55
+
+#define UCD_SS_CPU_RAW_INTERRUPT_LEN 9
+#define UCD_SS_CPU_RAW_INTERRUPT_IDS 1, 3, 6, 1, 4, 1, 2021, 11, 56
+
+#define UCD_SS_IO_RAW_SENT_LEN 9
+#define UCD_SS_IO_RAW_SENT_IDS 1, 3, 6, 1, 4, 1, 2021, 11, 57
+
+#define UCD_SS_IO_RAW_RECEIVED_LEN 9
+#define UCD_SS_IO_RAW_RECEIVED_IDS 1, 3, 6, 1, 4, 1, 2021, 11, 58
+
+#define UCD_SS_RAW_INTERRUPTS_LEN 9
+#define UCD_SS_RAW_INTERRUPTS_IDS 1, 3, 6, 1, 4, 1, 2021, 11, 59
+
+#define UCD_SS_RAW_CONTEXTS_LEN 9
+#define UCD_SS_RAW_CONTEXTS_IDS 1, 3, 6, 1, 4, 1, 2021, 11, 60
+
+#define UCD_SS_CPU_RAW_SOFT_IRQ_LEN 9
+#define UCD_SS_CPU_RAW_SOFT_IRQ_IDS 1, 3, 6, 1, 4, 1, 2021, 11, 61
+
+#define UCD_SS_RAW_SWAP_IN_LEN 9
+#define UCD_SS_RAW_SWAP_IN_IDS 1, 3, 6, 1, 4, 1, 2021, 11, 62
+
+#define UCD_SS_WAW_SWAP_OUT_LEN 9
+#define UCD_SS_WAW_SWAP_OUT_IDS 1, 3, 6, 1, 4, 1, 2021, 11, 63
+
+#define SM_MAHAAG_MIB_LEN 7
+#define SM_MAHAAG_MIB_IDS 1, 3, 6, 1, 4, 1, 36539
+
+#define SM_MIB_OBJECTS_LEN 8
+#define SM_MIB_OBJECTS_IDS 1, 3, 6, 1, 4, 1, 36539, 10
+
+#define SM_DAEMON_STATUS_LEN 9
+#define SM_DAEMON_STATUS_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 1
+
+#define SM_LAST_UPDATE_DAEMON_STATUS_LEN 10
+#define SM_LAST_UPDATE_DAEMON_STATUS_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 1, 1
+
+#define SM_INITIAL_VIRTUAL_MEMORY_USAGE_LEN 10
+#define SM_INITIAL_VIRTUAL_MEMORY_USAGE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 1, 2
+
+#define SM_INITIAL_RESIDENT_MEMORY_USAGE_LEN 10
+#define SM_INITIAL_RESIDENT_MEMORY_USAGE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 1, 3
+
+#define SM_AGGREGATED_VIRTUAL_MEMORY_USAGE_LEN 10
+#define SM_AGGREGATED_VIRTUAL_MEMORY_USAGE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 1, 4
+
+#define SM_AGGREGATED_RESIDENT_MEMORY_USAGE_LEN 10
+#define SM_AGGREGATED_RESIDENT_MEMORY_USAGE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 1, 5
+
+#define SM_CURRENT_VIRTUAL_MEMORY_USAGE_LEN 10
+#define SM_CURRENT_VIRTUAL_MEMORY_USAGE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 1, 6
+
+#define SM_CURRENT_RESIDENT_MEMORY_USAGE_LEN 10
+#define SM_CURRENT_RESIDENT_MEMORY_USAGE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 1, 7
+
+#define SM_CURRENT_VIRTUAL_MEMORY_INCREASES_LEN 10
+#define SM_CURRENT_VIRTUAL_MEMORY_INCREASES_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 1, 8
+
+#define SM_CURRENT_RESIDENT_MEMORY_INCREASES_LEN 10
+#define SM_CURRENT_RESIDENT_MEMORY_INCREASES_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 1, 9
+
+#define SM_HANDLED_REQUESTS_LEN 10
+#define SM_HANDLED_REQUESTS_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 1, 10
+
+#define SM_DAEMON_UPTIME_LEN 10
+#define SM_DAEMON_UPTIME_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 1, 11
+
+#define SM_DAEMON_CPUTIME_LEN 10
+#define SM_DAEMON_CPUTIME_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 1, 12
+
+#define SM_HOST_INFO_LEN 9
+#define SM_HOST_INFO_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 2
+
+#define SM_LAST_UPDATE_HOST_INFO_LEN 10
+#define SM_LAST_UPDATE_HOST_INFO_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 2, 1
+
+#define SM_HOSTNAME_LEN 10
+#define SM_HOSTNAME_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 2, 2
+
+#define SM_OS_NAME_LEN 10
+#define SM_OS_NAME_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 2, 3
+
+#define SM_OS_RELEASE_LEN 10
+#define SM_OS_RELEASE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 2, 4
+
+#define SM_OS_VERSION_LEN 10
+#define SM_OS_VERSION_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 2, 5
+
+#define SM_PLATFORM_LEN 10
+#define SM_PLATFORM_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 2, 6
+
+#define SM_HOST_UPTIME_LEN 10
+#define SM_HOST_UPTIME_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 2, 7
+
+#define SM_BITWIDTH_LEN 10
+#define SM_BITWIDTH_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 2, 8
+
+#define SM_VIRTUALIZED_LEN 10
+#define SM_VIRTUALIZED_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 2, 9
+
+#define SM_CPU_STATUS_LEN 10
+#define SM_CPU_STATUS_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 2, 10
+
+#define SM_CPU_COUNT_MIN_LEN 11
+#define SM_CPU_COUNT_MIN_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 2, 10, 1
+
+#define SM_CPU_COUNT_MAX_LEN 11
+#define SM_CPU_COUNT_MAX_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 2, 10, 2
+
+#define SM_CPU_COUNT_CURRENT_LEN 11
+#define SM_CPU_COUNT_CURRENT_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 2, 10, 3
+
+#define SM_CPU_USAGE_LEN 9
+#define SM_CPU_USAGE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 3
+
+#define SM_LAST_UPDATE_CPU_USAGE_LEN 10
+#define SM_LAST_UPDATE_CPU_USAGE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 3, 1
+
+#define SM_CPU_INTERVAL_FROM_LEN 10
+#define SM_CPU_INTERVAL_FROM_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 3, 2
+
+#define SM_CPU_INTERVAL_UNTIL_LEN 10
+#define SM_CPU_INTERVAL_UNTIL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 3, 3
+
+#define SM_CPU_TOTAL_LEN 10
+#define SM_CPU_TOTAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 3, 4
+
+#define SM_CPU_USER_TIME_TOTAL_LEN 11
+#define SM_CPU_USER_TIME_TOTAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 3, 4, 1
+
+#define SM_CPU_KERNEL_TIME_TOTAL_LEN 11
+#define SM_CPU_KERNEL_TIME_TOTAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 3, 4, 2
+
+#define SM_CPU_IDLE_TIME_TOTAL_LEN 11
+#define SM_CPU_IDLE_TIME_TOTAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 3, 4, 3
+
+#define SM_CPU_WAIT_TIME_TOTAL_LEN 11
+#define SM_CPU_WAIT_TIME_TOTAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 3, 4, 4
+
+#define SM_CPU_SWAP_TIME_TOTAL_LEN 11
+#define SM_CPU_SWAP_TIME_TOTAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 3, 4, 5
+
+#define SM_CPU_NICE_TIME_TOTAL_LEN 11
+#define SM_CPU_NICE_TIME_TOTAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 3, 4, 6
+
+#define SM_CPU_TOTAL_TIME_TOTAL_LEN 11
+#define SM_CPU_TOTAL_TIME_TOTAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 3, 4, 7
+
+#define SM_CPU_CONTEXT_SWITCHES_TOTAL_LEN 11
+#define SM_CPU_CONTEXT_SWITCHES_TOTAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 3, 4, 8
+
+#define SM_CPU_INVOL_CTX_SWITCHES_TOTAL_LEN 11
+#define SM_CPU_INVOL_CTX_SWITCHES_TOTAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 3, 4, 9
+
+#define SM_CPU_VOLUNTARY_CTX_SWITCHES_TOTAL_LEN 11
+#define SM_CPU_VOLUNTARY_CTX_SWITCHES_TOTAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 3, 4, 10
+
+#define SM_CPU_INTERRUPTS_TOTAL_LEN 11
+#define SM_CPU_INTERRUPTS_TOTAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 3, 4, 11
+
+#define SM_CPU_SOFT_INTERRUPTS_TOTAL_LEN 11
+#define SM_CPU_SOFT_INTERRUPTS_TOTAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 3, 4, 12
+
+#define SM_CPU_INTERVAL_LEN 10
+#define SM_CPU_INTERVAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 3, 5
+
+#define SM_CPU_USER_TIME_INTERVAL_LEN 11
+#define SM_CPU_USER_TIME_INTERVAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 3, 5, 1
+
+#define SM_CPU_KERNEL_TIME_INTERVAL_LEN 11
+#define SM_CPU_KERNEL_TIME_INTERVAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 3, 5, 2
+
+#define SM_CPU_IDLE_TIME_INTERVAL_LEN 11
+#define SM_CPU_IDLE_TIME_INTERVAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 3, 5, 3
+
+#define SM_CPU_WAIT_TIME_INTERVAL_LEN 11
+#define SM_CPU_WAIT_TIME_INTERVAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 3, 5, 4
+
+#define SM_CPU_SWAP_TIME_INTERVAL_LEN 11
+#define SM_CPU_SWAP_TIME_INTERVAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 3, 5, 5
+
+#define SM_CPU_NICE_TIME_INTERVAL_LEN 11
+#define SM_CPU_NICE_TIME_INTERVAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 3, 5, 6
+
+#define SM_CPU_TOTAL_TIME_INTERVAL_LEN 11
+#define SM_CPU_TOTAL_TIME_INTERVAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 3, 5, 7
+
+#define SM_CPU_CONTEXT_SWITCHES_INTERVAL_LEN 11
+#define SM_CPU_CONTEXT_SWITCHES_INTERVAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 3, 5, 8
+
+#define SM_CPU_INVOL_CTX_SWITCHES_INTERVAL_LEN 11
+#define SM_CPU_INVOL_CTX_SWITCHES_INTERVAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 3, 5, 9
+
+#define SM_CPU_VOLUNTARY_CTX_SWITCHES_INTERVAL_LEN 11
+#define SM_CPU_VOLUNTARY_CTX_SWITCHES_INTERVAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 3, 5, 10
+
+#define SM_CPU_INTERRUPTS_INTERVAL_LEN 11
+#define SM_CPU_INTERRUPTS_INTERVAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 3, 5, 11
+
+#define SM_CPU_SOFT_INTERRUPTS_INTERVAL_LEN 11
+#define SM_CPU_SOFT_INTERRUPTS_INTERVAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 3, 5, 12
+
+#define SM_MEMORY_USAGE_LEN 9
+#define SM_MEMORY_USAGE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 4
+
+#define SM_LAST_UPDATE_MEMORY_USAGE_LEN 10
+#define SM_LAST_UPDATE_MEMORY_USAGE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 4, 1
+
+#define SM_MEMORY_PHYSICAL_LEN 10
+#define SM_MEMORY_PHYSICAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 4, 2
+
+#define SM_TOTAL_MEMORY_PHYSICAL_LEN 11
+#define SM_TOTAL_MEMORY_PHYSICAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 4, 2, 1
+
+#define SM_FREE_MEMORY_PHYSICAL_LEN 11
+#define SM_FREE_MEMORY_PHYSICAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 4, 2, 2
+
+#define SM_USED_MEMORY_PHYSICAL_LEN 11
+#define SM_USED_MEMORY_PHYSICAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 4, 2, 3
+
+#define SM_CACHE_MEMORY_PHYSICAL_LEN 11
+#define SM_CACHE_MEMORY_PHYSICAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 4, 2, 4
+
+#define SM_MEMORY_SWAP_LEN 10
+#define SM_MEMORY_SWAP_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 4, 3
+
+#define SM_TOTAL_MEMORY_SWAP_LEN 11
+#define SM_TOTAL_MEMORY_SWAP_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 4, 3, 1
+
+#define SM_FREE_MEMORY_SWAP_LEN 11
+#define SM_FREE_MEMORY_SWAP_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 4, 3, 2
+
+#define SM_USED_MEMORY_SWAP_LEN 11
+#define SM_USED_MEMORY_SWAP_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 4, 3, 3
+
+#define SM_MEMORY_VIRTUAL_LEN 10
+#define SM_MEMORY_VIRTUAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 4, 4
+
+#define SM_TOTAL_MEMORY_VIRTUAL_LEN 11
+#define SM_TOTAL_MEMORY_VIRTUAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 4, 4, 1
+
+#define SM_FREE_MEMORY_VIRTUAL_LEN 11
+#define SM_FREE_MEMORY_VIRTUAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 4, 4, 2
+
+#define SM_USED_MEMORY_VIRTUAL_LEN 11
+#define SM_USED_MEMORY_VIRTUAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 4, 4, 3
+
+#define SM_SYSTEM_LOAD_LEN 9
+#define SM_SYSTEM_LOAD_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 5
+
+#define SM_LAST_UPDATE_SYSTEM_LOAD_LEN 10
+#define SM_LAST_UPDATE_SYSTEM_LOAD_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 5, 1
+
+#define SM_SYSTEM_LOAD_REAL_LEN 10
+#define SM_SYSTEM_LOAD_REAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 5, 2
+
+#define SM_SYSTEM_LOAD1_REAL_FLOAT_LEN 11
+#define SM_SYSTEM_LOAD1_REAL_FLOAT_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 5, 2, 1
+
+#define SM_SYSTEM_LOAD5_REAL_FLOAT_LEN 11
+#define SM_SYSTEM_LOAD5_REAL_FLOAT_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 5, 2, 5
+
+#define SM_SYSTEM_LOAD15_REAL_FLOAT_LEN 11
+#define SM_SYSTEM_LOAD15_REAL_FLOAT_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 5, 2, 15
+
+#define SM_SYSTEM_LOAD1_REAL_INTEGER_LEN 11
+#define SM_SYSTEM_LOAD1_REAL_INTEGER_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 5, 2, 101
+
+#define SM_SYSTEM_LOAD5_REAL_INTEGER_LEN 11
+#define SM_SYSTEM_LOAD5_REAL_INTEGER_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 5, 2, 105
+
+#define SM_SYSTEM_LOAD15_REAL_INTEGER_LEN 11
+#define SM_SYSTEM_LOAD15_REAL_INTEGER_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 5, 2, 115
+
+#define SM_SYSTEM_LOAD_NORM_LEN 10
+#define SM_SYSTEM_LOAD_NORM_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 5, 3
+
+#define SM_SYSTEM_LOAD1_NORM_FLOAT_LEN 11
+#define SM_SYSTEM_LOAD1_NORM_FLOAT_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 5, 3, 1
+
+#define SM_SYSTEM_LOAD5_NORM_FLOAT_LEN 11
+#define SM_SYSTEM_LOAD5_NORM_FLOAT_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 5, 3, 5
+
+#define SM_SYSTEM_LOAD15_NORM_FLOAT_LEN 11
+#define SM_SYSTEM_LOAD15_NORM_FLOAT_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 5, 3, 15
+
+#define SM_SYSTEM_LOAD1_NORM_INTEGER_LEN 11
+#define SM_SYSTEM_LOAD1_NORM_INTEGER_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 5, 3, 101
+
+#define SM_SYSTEM_LOAD5_NORM_INTEGER_LEN 11
+#define SM_SYSTEM_LOAD5_NORM_INTEGER_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 5, 3, 105
+
+#define SM_SYSTEM_LOAD15_NORM_INTEGER_LEN 11
+#define SM_SYSTEM_LOAD15_NORM_INTEGER_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 5, 3, 115
+
+#define SM_USER_LOGIN_STATUS_LEN 9
+#define SM_USER_LOGIN_STATUS_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 6
+
+#define SM_LAST_UPDATE_USER_LOGIN_LEN 10
+#define SM_LAST_UPDATE_USER_LOGIN_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 6, 1
+
+#define SM_USER_LOGIN_COUNT_LEN 10
+#define SM_USER_LOGIN_COUNT_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 6, 2
+
+#define SM_USER_LOGIN_TABLE_LEN 10
+#define SM_USER_LOGIN_TABLE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 6, 3
+
+#define SM_USER_LOGIN_ENTRY_LEN 11
+#define SM_USER_LOGIN_ENTRY_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 6, 3, 1
+
+#define SM_USER_LOGIN_INDEX_LEN 12
+#define SM_USER_LOGIN_INDEX_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 6, 3, 1, 1
+
+#define SM_USER_LOGIN_USERNAME_LEN 12
+#define SM_USER_LOGIN_USERNAME_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 6, 3, 1, 2
+
+#define SM_USER_LOGIN_USERID_LEN 12
+#define SM_USER_LOGIN_USERID_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 6, 3, 1, 3
+
+#define SM_USER_LOGIN_TTY_LEN 12
+#define SM_USER_LOGIN_TTY_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 6, 3, 1, 4
+
+#define SM_USER_LOGIN_LOGIN_TIME_LEN 12
+#define SM_USER_LOGIN_LOGIN_TIME_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 6, 3, 1, 5
+
+#define SM_USER_LOGIN_IDLE_TIME_LEN 12
+#define SM_USER_LOGIN_IDLE_TIME_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 6, 3, 1, 6
+
+#define SM_USER_LOGIN_JCPU_TIME_LEN 12
+#define SM_USER_LOGIN_JCPU_TIME_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 6, 3, 1, 7
+
+#define SM_USER_LOGIN_PCPU_TIME_LEN 12
+#define SM_USER_LOGIN_PCPU_TIME_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 6, 3, 1, 8
+
+#define SM_USER_LOGIN_WHAT_LEN 12
+#define SM_USER_LOGIN_WHAT_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 6, 3, 1, 9
+
+#define SM_USER_LOGIN_FROM_LEN 12
+#define SM_USER_LOGIN_FROM_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 6, 3, 1, 10
+
+#define SM_PROCESS_STATUS_LEN 9
+#define SM_PROCESS_STATUS_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 7
+
+#define SM_LAST_UPDATE_PROCESS_STATUS_LEN 10
+#define SM_LAST_UPDATE_PROCESS_STATUS_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 7, 1
+
+#define SM_PROCESS_TOTAL_LEN 10
+#define SM_PROCESS_TOTAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 7, 2
+
+#define SM_PROCESS_RUNNING_LEN 10
+#define SM_PROCESS_RUNNING_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 7, 3
+
+#define SM_PROCESS_SLEEPING_LEN 10
+#define SM_PROCESS_SLEEPING_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 7, 4
+
+#define SM_PROCESS_STOPPED_LEN 10
+#define SM_PROCESS_STOPPED_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 7, 5
+
+#define SM_PROCESS_ZOMBIE_LEN 10
+#define SM_PROCESS_ZOMBIE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 7, 6
+
+#define SM_PROCESS_TABLE_LEN 10
+#define SM_PROCESS_TABLE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 7, 7
+
+#define SM_PROCESS_ENTRY_LEN 11
+#define SM_PROCESS_ENTRY_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 7, 7, 1
+
+#define SM_PROCESS_PID_LEN 12
+#define SM_PROCESS_PID_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 7, 7, 1, 1
+
+#define SM_PROCESS_PPID_LEN 12
+#define SM_PROCESS_PPID_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 7, 7, 1, 2
+
+#define SM_PROCESS_EXE_LEN 12
+#define SM_PROCESS_EXE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 7, 7, 1, 3
+
+#define SM_PROCESS_ARGS_LEN 12
+#define SM_PROCESS_ARGS_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 7, 7, 1, 4
+
+#define SM_PROCESS_STATE_LEN 12
+#define SM_PROCESS_STATE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 7, 7, 1, 5
+
+#define SM_PROCESS_VSIZE_LEN 12
+#define SM_PROCESS_VSIZE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 7, 7, 1, 6
+
+#define SM_PROCESS_RSIZE_LEN 12
+#define SM_PROCESS_RSIZE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 7, 7, 1, 7
+
+#define SM_PROCESS_START_TIME_LEN 12
+#define SM_PROCESS_START_TIME_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 7, 7, 1, 8
+
+#define SM_PROCESS_CPU_TIME_LEN 12
+#define SM_PROCESS_CPU_TIME_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 7, 7, 1, 9
+
+#define SM_PROCESS_USERID_LEN 12
+#define SM_PROCESS_USERID_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 7, 7, 1, 10
+
+#define SM_PROCESS_USERNAME_LEN 12
+#define SM_PROCESS_USERNAME_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 7, 7, 1, 11
+
+#define SM_PROCESS_GROUPID_LEN 12
+#define SM_PROCESS_GROUPID_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 7, 7, 1, 12
+
+#define SM_PROCESS_GROUPNAME_LEN 12
+#define SM_PROCESS_GROUPNAME_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 7, 7, 1, 13
+
+#define SM_PROCESS_EFFECTIVE_USERID_LEN 12
+#define SM_PROCESS_EFFECTIVE_USERID_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 7, 7, 1, 14
+
+#define SM_PROCESS_EFFECTIVE_USERNAME_LEN 12
+#define SM_PROCESS_EFFECTIVE_USERNAME_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 7, 7, 1, 15
+
+#define SM_PROCESS_EFFECTIVE_GROUPID_LEN 12
+#define SM_PROCESS_EFFECTIVE_GROUPID_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 7, 7, 1, 16
+
+#define SM_PROCESS_EFFECTIVE_GROUPNAME_LEN 12
+#define SM_PROCESS_EFFECTIVE_GROUPNAME_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 7, 7, 1, 17
+
+#define SM_PROCESS_NICE_LEN 12
+#define SM_PROCESS_NICE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 7, 7, 1, 18
+
+#define SM_PROCESS_CPU_PERCENT_LEN 12
+#define SM_PROCESS_CPU_PERCENT_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 7, 7, 1, 19
+
+#define SM_FILE_SYSTEM_USAGE_LEN 9
+#define SM_FILE_SYSTEM_USAGE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 8
+
+#define SM_LAST_UPDATE_FILE_SYSTEM_USAGE_LEN 10
+#define SM_LAST_UPDATE_FILE_SYSTEM_USAGE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 8, 1
+
+#define SM_FILE_SYSTEM_COUNT_LEN 10
+#define SM_FILE_SYSTEM_COUNT_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 8, 2
+
+#define SM_FILE_SYSTEM_TABLE_LEN 10
+#define SM_FILE_SYSTEM_TABLE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 8, 3
+
+#define SM_FILE_SYSTEM_ENTRY_LEN 11
+#define SM_FILE_SYSTEM_ENTRY_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 8, 3, 1
+
+#define SM_FILE_SYSTEM_INDEX_LEN 12
+#define SM_FILE_SYSTEM_INDEX_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 8, 3, 1, 1
+
+#define SM_FILE_SYSTEM_MOUNTPOINT_LEN 12
+#define SM_FILE_SYSTEM_MOUNTPOINT_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 8, 3, 1, 2
+
+#define SM_FILE_SYSTEM_DEVICE_LEN 12
+#define SM_FILE_SYSTEM_DEVICE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 8, 3, 1, 3
+
+#define SM_FILE_SYSTEM_OPTIONS_LEN 12
+#define SM_FILE_SYSTEM_OPTIONS_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 8, 3, 1, 4
+
+#define SM_FILE_SYSTEM_TYPE_LEN 12
+#define SM_FILE_SYSTEM_TYPE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 8, 3, 1, 5
+
+#define SM_FILE_SYSTEM_DEVICE_TYPE_LEN 12
+#define SM_FILE_SYSTEM_DEVICE_TYPE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 8, 3, 1, 6
+
+#define SM_FILE_SYSTEM_TOTAL_LEN 12
+#define SM_FILE_SYSTEM_TOTAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 8, 3, 1, 7
+
+#define SM_FILE_SYSTEM_USED_LEN 12
+#define SM_FILE_SYSTEM_USED_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 8, 3, 1, 8
+
+#define SM_FILE_SYSTEM_FREE_LEN 12
+#define SM_FILE_SYSTEM_FREE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 8, 3, 1, 9
+
+#define SM_FILE_SYSTEM_AVAIL_LEN 12
+#define SM_FILE_SYSTEM_AVAIL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 8, 3, 1, 10
+
+#define SM_FILE_SYSTEM_INODES_TOTAL_LEN 12
+#define SM_FILE_SYSTEM_INODES_TOTAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 8, 3, 1, 11
+
+#define SM_FILE_SYSTEM_INODES_USED_LEN 12
+#define SM_FILE_SYSTEM_INODES_USED_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 8, 3, 1, 12
+
+#define SM_FILE_SYSTEM_INODES_FREE_LEN 12
+#define SM_FILE_SYSTEM_INODES_FREE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 8, 3, 1, 13
+
+#define SM_FILE_SYSTEM_INODES_AVAIL_LEN 12
+#define SM_FILE_SYSTEM_INODES_AVAIL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 8, 3, 1, 14
+
+#define SM_FILE_SYSTEM_BLOCKS_TOTAL_LEN 12
+#define SM_FILE_SYSTEM_BLOCKS_TOTAL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 8, 3, 1, 15
+
+#define SM_FILE_SYSTEM_BLOCKS_USED_LEN 12
+#define SM_FILE_SYSTEM_BLOCKS_USED_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 8, 3, 1, 16
+
+#define SM_FILE_SYSTEM_BLOCKS_FREE_LEN 12
+#define SM_FILE_SYSTEM_BLOCKS_FREE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 8, 3, 1, 17
+
+#define SM_FILE_SYSTEM_BLOCKS_AVAIL_LEN 12
+#define SM_FILE_SYSTEM_BLOCKS_AVAIL_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 8, 3, 1, 18
+
+#define SM_FILE_SYSTEM_BLOCK_SIZE_LEN 12
+#define SM_FILE_SYSTEM_BLOCK_SIZE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 8, 3, 1, 19
+
+#define SM_FILE_SYSTEM_IO_SIZE_LEN 12
+#define SM_FILE_SYSTEM_IO_SIZE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 8, 3, 1, 20
+
+#define SM_DISK_IO_STATUS_LEN 9
+#define SM_DISK_IO_STATUS_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 20
+
+#define SM_LAST_UPDATE_DISK_IO_STATUS_LEN 10
+#define SM_LAST_UPDATE_DISK_IO_STATUS_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 20, 1
+
+#define SM_DISK_IO_COUNT_LEN 10
+#define SM_DISK_IO_COUNT_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 20, 2
+
+#define SM_DISK_IO_TABLE_LEN 10
+#define SM_DISK_IO_TABLE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 20, 3
+
+#define SM_DISK_IO_ENTRY_LEN 11
+#define SM_DISK_IO_ENTRY_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 20, 3, 1
+
+#define SM_DISK_IO_INDEX_LEN 12
+#define SM_DISK_IO_INDEX_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 20, 3, 1, 1
+
+#define SM_DISK_IO_DISKNAME_LEN 12
+#define SM_DISK_IO_DISKNAME_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 20, 3, 1, 2
+
+#define SM_DISK_IO_READ_BYTES_LEN 12
+#define SM_DISK_IO_READ_BYTES_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 20, 3, 1, 3
+
+#define SM_DISK_IO_WRIT_BYTES_LEN 12
+#define SM_DISK_IO_WRIT_BYTES_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 20, 3, 1, 4
+
+#define SM_NETWORK_IO_STATUS_LEN 9
+#define SM_NETWORK_IO_STATUS_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 21
+
+#define SM_LAST_UPDATE_NETWORK_IO_STATUS_LEN 10
+#define SM_LAST_UPDATE_NETWORK_IO_STATUS_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 21, 1
+
+#define SM_NETWORK_IO_COUNT_LEN 10
+#define SM_NETWORK_IO_COUNT_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 21, 2
+
+#define SM_NETWORK_IO_TABLE_LEN 10
+#define SM_NETWORK_IO_TABLE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 21, 3
+
+#define SM_NETWORK_IO_ENTRY_LEN 11
+#define SM_NETWORK_IO_ENTRY_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 21, 3, 1
+
+#define SM_NETWORK_IO_INDEX_LEN 12
+#define SM_NETWORK_IO_INDEX_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 21, 3, 1, 1
+
+#define SM_NETWORK_IO_INTERFACE_LEN 12
+#define SM_NETWORK_IO_INTERFACE_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 21, 3, 1, 2
+
+#define SM_NETWORK_IO_TRANSMITTED_LEN 12
+#define SM_NETWORK_IO_TRANSMITTED_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 21, 3, 1, 3
+
+#define SM_NETWORK_IO_RECEIVED_LEN 12
+#define SM_NETWORK_IO_RECEIVED_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 21, 3, 1, 4
+
+#define SM_NETWORK_IO_INPKTS_LEN 12
+#define SM_NETWORK_IO_INPKTS_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 21, 3, 1, 5
+
+#define SM_NETWORK_IO_OUTPKTS_LEN 12
+#define SM_NETWORK_IO_OUTPKTS_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 21, 3, 1, 6
+
+#define SM_NETWORK_IO_INERRORS_LEN 12
+#define SM_NETWORK_IO_INERRORS_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 21, 3, 1, 7
+
+#define SM_NETWORK_IO_OUTERRORS_LEN 12
+#define SM_NETWORK_IO_OUTERRORS_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 21, 3, 1, 8
+
+#define SM_NETWORK_IO_COLLISIONS_LEN 12
+#define SM_NETWORK_IO_COLLISIONS_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 21, 3, 1, 9
+
+#define SM_SWAP_IO_STATUS_LEN 9
+#define SM_SWAP_IO_STATUS_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 22
+
+#define SM_LAST_UPDATE_SWAP_IO_STATUS_LEN 10
+#define SM_LAST_UPDATE_SWAP_IO_STATUS_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 22, 1
+
+#define SM_SWAP_PAGES_IN_LEN 10
+#define SM_SWAP_PAGES_IN_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 22, 2
+
+#define SM_SWAP_PAGES_OUT_LEN 10
+#define SM_SWAP_PAGES_OUT_IDS 1, 3, 6, 1, 4, 1, 36539, 10, 22, 3
+
+#define SM_EXTERNAL_COMMANDS_LEN 8
+#define SM_EXTERNAL_COMMANDS_IDS 1, 3, 6, 1, 4, 1, 36539, 20
+
+#define SM_APP_MONITORING_LEN 9
+#define SM_APP_MONITORING_IDS 1, 3, 6, 1, 4, 1, 36539, 20, 1
+
+#define SM_LAST_UPDATE_APP_MONITORING_LEN 10
+#define SM_LAST_UPDATE_APP_MONITORING_IDS 1, 3, 6, 1, 4, 1, 36539, 20, 1, 1
+
+#define SM_LAST_STARTED_APP_MONITORING_LEN 10
+#define SM_LAST_STARTED_APP_MONITORING_IDS 1, 3, 6, 1, 4, 1, 36539, 20, 1, 2
+
+#define SM_LAST_FINISHED_APP_MONITORING_LEN 10
+#define SM_LAST_FINISHED_APP_MONITORING_IDS 1, 3, 6, 1, 4, 1, 36539, 20, 1, 3
+
+#define SM_APP_MONITORING_COMMAND_LEN 10
+#define SM_APP_MONITORING_COMMAND_IDS 1, 3, 6, 1, 4, 1, 36539, 20, 1, 4
+
+#define SM_APP_MONITORING_COMMAND_LINE_LEN 10
+#define SM_APP_MONITORING_COMMAND_LINE_IDS 1, 3, 6, 1, 4, 1, 36539, 20, 1, 5
+
+#define SM_APP_MONITORING_USER_LEN 10
+#define SM_APP_MONITORING_USER_IDS 1, 3, 6, 1, 4, 1, 36539, 20, 1, 6
+
+#define SM_APP_MONITORING_LAST_EXIT_CODE_LEN 10
+#define SM_APP_MONITORING_LAST_EXIT_CODE_IDS 1, 3, 6, 1, 4, 1, 36539, 20, 1, 7
+
+#define SM_APP_MONITORING_LAST_SIGNAL_CODE_LEN 10
+#define SM_APP_MONITORING_LAST_SIGNAL_CODE_IDS 1, 3, 6, 1, 4, 1, 36539, 20, 1, 8
+
+#define SM_APP_MONITORING_ERROR_CODE_LEN 10
+#define SM_APP_MONITORING_ERROR_CODE_IDS 1, 3, 6, 1, 4, 1, 36539, 20, 1, 9
+
+#define SM_APP_MONITORING_ERROR_MESSAGE_LEN 10
+#define SM_APP_MONITORING_ERROR_MESSAGE_IDS 1, 3, 6, 1, 4, 1, 36539, 20, 1, 10
+
+#define SM_APP_MONITORING_DATA_LEN 10
+#define SM_APP_MONITORING_DATA_IDS 1, 3, 6, 1, 4, 1, 36539, 20, 1, 100
+
+#endif /* __SMART_SNMPD_NAGIOS_CHECKS_OID_VALUES_H_INCLUDED__ */
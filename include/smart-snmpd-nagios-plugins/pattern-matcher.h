@@ -0,0 +1,408 @@
+/*
+ * Copyright 2010,2011 Matthias Haag, Jens Rehsack
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ *
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __SMART_SNMPD_NAGIOS_CHECKS_PATTERN_MATCHER_H_INCLUDED__
+#define __SMART_SNMPD_NAGIOS_CHECKS_PATTERN_MATCHER_H_INCLUDED__
+
+#include <boost/regex.hpp>
+
+#include <ctype.h>
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * literals each match of a regular expression has to contain
+ *
+ * The expression is scanned once: runs of ordinary characters outside of
+ * groups and character classes are required by every match, except the
+ * last character of a run followed by an optional quantifier. Whenever
+ * the scan can't be sure (alternatives, (?...) constructs, \Q...\E,
+ * escapes like \x41) no literal is extracted at all.
+ */
+class LiteralPrefilter
+{
+public:
+    explicit LiteralPrefilter( string const &pattern = "" )
+        : mLiterals()
+        , mLeadingLiteral()
+        , mLiteral()
+        , mUsable( true )
+        , mExact( true )
+    {
+        parse( pattern );
+    }
+
+    /**
+     * @return true when the pattern contains no meta characters - getLiteral() is the pattern then
+     */
+    bool isExact() const { return mUsable && mExact; }
+
+    /**
+     * @return the unescaped pattern when isExact()
+     */
+    string const & getLiteral() const { return mLiteral; }
+
+    /**
+     * @return literal each match starts with, empty when unknown
+     */
+    string const & getLeadingLiteral() const { return mLeadingLiteral; }
+
+    /**
+     * checks whether subject contains all required literals
+     *
+     * @param subject - the string to search in
+     *
+     * @return false when subject can't match, true when it has to be matched by the regular expression
+     */
+    bool mayMatch( string const &subject ) const
+    {
+        for( vector<string>::const_iterator ci = mLiterals.begin(); ci != mLiterals.end(); ++ci )
+        {
+            if( string::npos == find_literal( subject, *ci, 0 ) )
+                return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * searches needle in haystack
+     *
+     * @return position of the first occurrence at or after pos, string::npos when not found
+     */
+    static string::size_type find_literal( string const &haystack, string const &needle, string::size_type pos )
+    {
+        if( ( pos > haystack.length() ) || ( needle.length() > haystack.length() - pos ) )
+            return string::npos;
+
+#ifdef HAVE_MEMMEM
+        void const *found = memmem( haystack.data() + pos, haystack.length() - pos, needle.data(), needle.length() );
+        return found ? static_cast<char const *>( found ) - haystack.data() : string::npos;
+#else
+        return haystack.find( needle, pos );
+#endif
+    }
+
+protected:
+    /**
+     * literals required by each match, longest first
+     */
+    vector<string> mLiterals;
+    string mLeadingLiteral;
+    string mLiteral;
+    bool mUsable;
+    bool mExact;
+
+    void parse( string const &pattern )
+    {
+        string run;
+        bool leading = true;
+        string::size_type i = 0, n = pattern.length();
+
+        while( mUsable && ( i < n ) )
+        {
+            char c = pattern[i];
+            switch( c )
+            {
+            case '\\':
+                if( i + 1 >= n )
+                {
+                    mUsable = false;
+                    break;
+                }
+                c = pattern[i + 1];
+                if( strchr( "dDwWsSbB", c ) || strchr( "<>`'", c ) )
+                {
+                    // character class escapes and zero width assertions
+                    meta( run, leading );
+                }
+                else if( isalnum( static_cast<unsigned char>( c ) ) )
+                {
+                    // \Q, \x41, back references, ... aren't worth it
+                    mUsable = false;
+                }
+                else
+                {
+                    run += c;
+                }
+                i += 2;
+                continue;
+
+            case '*':
+            case '?':
+            case '{':
+                // the preceding character is optional
+                if( !run.empty() )
+                    run.erase( run.length() - 1 );
+                meta( run, leading );
+                if( '{' == c )
+                {
+                    i = pattern.find( '}', i );
+                    if( string::npos == i )
+                    {
+                        mUsable = false;
+                        break;
+                    }
+                }
+                break;
+
+            case '+':
+            case '.':
+            case '^':
+            case '$':
+                meta( run, leading );
+                break;
+
+            case '[':
+                meta( run, leading );
+                i = skip_class( pattern, i );
+                continue;
+
+            case '(':
+                meta( run, leading );
+                i = skip_group( pattern, i );
+                continue;
+
+            case '|':
+            case ')':
+                mUsable = false;
+                break;
+
+            default:
+                run += c;
+                ++i;
+                continue;
+            }
+
+            ++i;
+        }
+
+        if( !mUsable )
+        {
+            mLiterals.clear();
+            mLeadingLiteral.erase();
+            return;
+        }
+
+        if( mExact )
+        {
+            mLiteral = run;
+            mLeadingLiteral = run;
+        }
+        flush( run, leading );
+
+        sort( mLiterals.begin(), mLiterals.end(), LongerFirst() );
+    }
+
+    void flush( string &run, bool &leading )
+    {
+        if( !run.empty() )
+        {
+            if( leading )
+                mLeadingLiteral = run;
+            mLiterals.push_back( run );
+            run.erase();
+        }
+
+        leading = false;
+    }
+
+    /**
+     * ends the current run of ordinary characters at a meta character
+     */
+    void meta( string &run, bool &leading )
+    {
+        flush( run, leading );
+        mExact = false;
+    }
+
+    /**
+     * @return position after the character class starting at i
+     */
+    string::size_type skip_class( string const &pattern, string::size_type i )
+    {
+        string::size_type n = pattern.length();
+
+        ++i;
+        if( ( i < n ) && ( '^' == pattern[i] ) )
+            ++i;
+        if( ( i < n ) && ( ']' == pattern[i] ) )
+            ++i;
+
+        while( ( i < n ) && ( ']' != pattern[i] ) )
+        {
+            if( ( '[' == pattern[i] ) && ( i + 1 < n ) && strchr( ":.=", pattern[i + 1] ) )
+            {
+                // [:alpha:], [.x.], [=x=]
+                char const close[] = { pattern[i + 1], ']', 0 };
+                i = pattern.find( close, i + 2 );
+                if( string::npos == i )
+                    break;
+                i += 2;
+                continue;
+            }
+            if( '\\' == pattern[i] )
+                ++i;
+            ++i;
+        }
+
+        if( i >= n )
+        {
+            mUsable = false;
+            return n;
+        }
+
+        return i + 1;
+    }
+
+    /**
+     * @return position after the group starting at i
+     */
+    string::size_type skip_group( string const &pattern, string::size_type i )
+    {
+        string::size_type n = pattern.length();
+        unsigned depth = 0;
+
+        if( ( i + 1 < n ) && ( '?' == pattern[i + 1] ) )
+        {
+            // (?i), (?=...), ... may change what the rest matches
+            mUsable = false;
+            return n;
+        }
+
+        while( i < n )
+        {
+            char c = pattern[i];
+            if( '\\' == c )
+            {
+                i += 2;
+                continue;
+            }
+            if( '[' == c )
+            {
+                i = skip_class( pattern, i );
+                continue;
+            }
+            if( '(' == c )
+            {
+                ++depth;
+            }
+            else if( ( ')' == c ) && ( 0 == --depth ) )
+            {
+                return i + 1;
+            }
+            ++i;
+        }
+
+        mUsable = false;
+        return n;
+    }
+
+    struct LongerFirst
+    {
+        bool operator () ( string const &a, string const &b ) const { return a.length() > b.length(); }
+    };
+};
+
+/**
+ * matches a pattern as word(s) of a process argument string
+ *
+ * CommandPosition matches like the regular expression "^PATTERN(\s+.*|$)",
+ * ArgumentPosition like ".*\s+PATTERN(\s+.*|$)". Patterns without meta
+ * characters are compared directly, all others are pre-checked by their
+ * required literals before the regular expression is run.
+ */
+class ArgumentPatternMatcher
+{
+public:
+    enum Position
+    {
+        CommandPosition,
+        ArgumentPosition
+    };
+
+    ArgumentPatternMatcher( string const &pattern = "", Position position = CommandPosition )
+        : mPosition( position )
+        , mPrefilter( pattern )
+        , mRegex()
+    {
+        if( !mPrefilter.isExact() )
+        {
+            if( CommandPosition == mPosition )
+                mRegex.assign( "^" + pattern + "(\\s+.*|$)" );
+            else
+                mRegex.assign( ".*\\s+" + pattern + "(\\s+.*|$)" );
+        }
+    }
+
+    bool matches( string const &args ) const
+    {
+        if( mPrefilter.isExact() )
+            return ( CommandPosition == mPosition ) ? matchesCommand( args ) : matchesArgument( args );
+
+        if( !mPrefilter.mayMatch( args ) )
+            return false;
+
+        string const &leading = mPrefilter.getLeadingLiteral();
+        if( ( CommandPosition == mPosition ) && ( 0 != args.compare( 0, leading.length(), leading ) ) )
+            return false;
+
+        return boost::regex_match( args, mRegex );
+    }
+
+    bool isExact() const { return mPrefilter.isExact(); }
+
+protected:
+    Position mPosition;
+    LiteralPrefilter mPrefilter;
+    boost::regex mRegex;
+
+    static bool word_ends( string const &args, string::size_type pos )
+    {
+        return ( pos == args.length() ) || isspace( static_cast<unsigned char>( args[pos] ) );
+    }
+
+    bool matchesCommand( string const &args ) const
+    {
+        string const &literal = mPrefilter.getLiteral();
+
+        return ( args.length() >= literal.length() ) &&
+               ( 0 == args.compare( 0, literal.length(), literal ) ) &&
+               word_ends( args, literal.length() );
+    }
+
+    bool matchesArgument( string const &args ) const
+    {
+        string const &literal = mPrefilter.getLiteral();
+
+        for( string::size_type pos = LiteralPrefilter::find_literal( args, literal, 1 );
+             pos != string::npos;
+             pos = LiteralPrefilter::find_literal( args, literal, pos + 1 ) )
+        {
+            if( isspace( static_cast<unsigned char>( args[pos - 1] ) ) && word_ends( args, pos + literal.length() ) )
+                return true;
+        }
+
+        return false;
+    }
+};
+
+#endif /* __SMART_SNMPD_NAGIOS_CHECKS_PATTERN_MATCHER_H_INCLUDED__ */
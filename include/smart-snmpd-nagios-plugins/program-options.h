@@ -25,6 +25,9 @@
 #include <boost/program_options/variables_map.hpp>
 #include <boost/tokenizer.hpp>
 #include <boost/token_functions.hpp>
+#include <boost/version.hpp>
+
+#include <string.h>
 
 using namespace boost;
 using namespace boost::program_options;
@@ -132,4 +135,115 @@ void option_required(variables_map const &vm, const vector<const char *> &req_op
         throw required_option( names );
 }
 
+/**
+ * splits the command line into options without boost's command line parser
+ *
+ * Handles the usual command lines only: "--name", "--name value",
+ * "--name=value", "-n", "-n value" and "-nvalue" with exactly named
+ * options taking no or exactly one value which doesn't start with '-'.
+ * Everything else (abbreviated or unknown names, grouped short options,
+ * positional arguments, "--", missing values, multi-token options)
+ * is left to parse_command_line(), which accepts or rejects it the usual
+ * way. The result is identical to the one of parse_command_line() and
+ * has to be passed to store() as usual, which converts and validates the
+ * values.
+ *
+ * @param argc - argument count
+ * @param argv - argument values
+ * @param desc - the allowed options
+ * @param result - receives the options when the command line was handled
+ *
+ * @return true when handled, false when parse_command_line() has to be used
+ */
+bool parse_command_line_fast(int argc, char *argv[], options_description const &desc, parsed_options &result)
+{
+    vector<option> options;
+    options.reserve( argc );
+
+    try
+    {
+        for( int i = 1; i < argc; ++i )
+        {
+            char const *tok = argv[i];
+            if( ( '-' != tok[0] ) || ( '\0' == tok[1] ) )
+                return false; // positional argument or "-"
+
+            string name, adjacent;
+            bool hasAdjacent = false;
+            if( '-' == tok[1] )
+            {
+                if( '\0' == tok[2] )
+                    return false; // "--" terminates the options
+                char const *eq = strchr( tok + 2, '=' );
+                if( eq )
+                {
+                    name.assign( tok + 2, eq );
+                    adjacent = eq + 1;
+                    hasAdjacent = true;
+                    if( adjacent.empty() )
+                        return false;
+                }
+                else
+                {
+                    name = tok + 2;
+                }
+            }
+            else
+            {
+                name.assign( tok, 2 );
+                if( '\0' != tok[2] )
+                {
+                    adjacent = tok + 2;
+                    hasAdjacent = true;
+                }
+            }
+
+            option_description const *d = desc.find_nothrow( name, false, false, false );
+            if( !d )
+                return false;
+
+            unsigned minTokens = d->semantic()->min_tokens();
+            unsigned maxTokens = d->semantic()->max_tokens();
+
+            option opt;
+            opt.string_key = d->key( name );
+            opt.original_tokens.push_back( tok );
+
+            if( hasAdjacent )
+            {
+                if( 0 == maxTokens )
+                    return false; // grouped short options or superfluous value
+                opt.value.push_back( adjacent );
+            }
+            else
+            {
+                if( ( minTokens != maxTokens ) || ( maxTokens > 1 ) )
+                    return false;
+                if( 1 == minTokens )
+                {
+                    if( ( i + 1 >= argc ) || ( '-' == argv[i + 1][0] ) )
+                        return false;
+                    opt.value.push_back( argv[++i] );
+                    opt.original_tokens.push_back( argv[i] );
+                }
+            }
+
+            options.push_back( opt );
+        }
+    }
+    catch( option_error & )
+    {
+        // e.g. ambiguous names - let parse_command_line() report it
+        return false;
+    }
+
+    result.options.swap( options );
+    result.description = &desc;
+#if BOOST_VERSION >= 105000
+    result.m_options_prefix = command_line_style::allow_long;
+#endif
+
+    return true;
+}
+
 #endif /* __SMART_SNMPD_NAGIOS_CHECKS_PROGRAM_OPTIONS_H_INCLUDED__ */
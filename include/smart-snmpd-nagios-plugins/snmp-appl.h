@@ -20,6 +20,7 @@
 #include <smart-snmpd-nagios-plugins/snmp-comm.h>
 #include <smart-snmpd-nagios-plugins/nagios-stats.h>
 #include <smart-snmpd-nagios-plugins/snmp-daemon-identifiers.h>
+#include <smart-snmpd-nagios-plugins/snmp-session-pool.h>
 
 #include <snmp_pp/snmp_pp.h>
 
@@ -37,12 +38,90 @@ using namespace boost;
 using namespace boost::program_options;
 
 #include <string>
+#include <iostream>
 
 using namespace std;
 
 #undef loggerModuleName
 #define loggerModuleName "nagiosplugins.snmpappl"
 
+/**
+ * environment provided by a process hosting check applications
+ *
+ * A hosting process (e.g. the check daemon) runs several applications
+ * without terminating. It provides the streams to write the output to and
+ * a pool of snmp sessions to reuse.
+ */
+class HostedEnvironment
+{
+public:
+    /**
+     * constructor
+     *
+     * @param out - stream receiving the regular output
+     * @param err - stream receiving the error output
+     * @param sessionPool - pool of reusable snmp sessions
+     */
+    HostedEnvironment( ostream &out, ostream &err, SnmpSessionPool &sessionPool )
+        : mOut( out )
+        , mErr( err )
+        , mSessionPool( sessionPool )
+    {}
+
+    /**
+     * destructor
+     */
+    virtual ~HostedEnvironment() {}
+
+    inline ostream & getOutput() const { return mOut; }
+    inline ostream & getError() const { return mErr; }
+    inline SnmpSessionPool & getSessionPool() const { return mSessionPool; }
+
+protected:
+    /**
+     * stream receiving the regular output
+     */
+    ostream &mOut;
+    /**
+     * stream receiving the error output
+     */
+    ostream &mErr;
+    /**
+     * pool of reusable snmp sessions
+     */
+    SnmpSessionPool &mSessionPool;
+
+private:
+    HostedEnvironment();
+};
+
+/**
+ * signature of the functions running a check plugin
+ */
+typedef int (*CheckPluginRunFunc)(int argc, char *argv[], HostedEnvironment *hostedEnv);
+
+/**
+ * thrown instead of calling exit() when running in a hosted environment
+ *
+ * Intentionally not derived from std::exception to pass the catch blocks
+ * of the check applications.
+ */
+class hosted_exit
+{
+public:
+    hosted_exit(int exit_code)
+        : mExitCode( exit_code )
+    {}
+
+    inline int getExitCode() const { return mExitCode; }
+
+protected:
+    int mExitCode;
+
+private:
+    hosted_exit();
+};
+
 /**
  * base class for snmp applications
  *
@@ -58,6 +137,7 @@ public:
     SnmpAppl()
         : mCmndlineValuesMap()
         , mSnmpComm()
+        , mHostedEnv(0)
     {}
 
     /**
@@ -65,6 +145,50 @@ public:
      */
     virtual ~SnmpAppl() {}
 
+    /**
+     * sets the environment of the hosting process
+     *
+     * Must be called before setupFromCommandLine().
+     *
+     * @param hostedEnv - environment of hosting process, NULL when running standalone
+     */
+    void setHostedEnvironment(HostedEnvironment *hostedEnv)
+    {
+        mHostedEnv = hostedEnv;
+        mSnmpComm.set_session_pool( mHostedEnv ? &mHostedEnv->getSessionPool() : 0 );
+    }
+
+    /**
+     * @return true when running inside a hosting process
+     */
+    inline bool isHosted() const { return mHostedEnv != 0; }
+
+    /**
+     * @return stream to write the regular output to
+     */
+    inline ostream & getOutputStream() const { return mHostedEnv ? mHostedEnv->getOutput() : cout; }
+
+    /**
+     * @return stream to write the error output to
+     */
+    inline ostream & getErrorStream() const { return mHostedEnv ? mHostedEnv->getError() : cerr; }
+
+    /**
+     * terminates the application
+     *
+     * Calls exit() when running standalone or throws hosted_exit
+     * when running in a hosted environment.
+     *
+     * @param exit_code - value to pass to exit()
+     */
+    void terminate(int exit_code) const
+    {
+        if( mHostedEnv )
+            throw hosted_exit( exit_code );
+
+        exit( exit_code );
+    }
+
     /**
      * adds the supported general options to the given options_description instance
      *
@@ -134,12 +258,15 @@ public:
     virtual void setupFromCommandLine(int argc, char *argv[])
     {
         options_description all = get_options();
-        store( parse_command_line(argc, argv, all), mCmndlineValuesMap );
+        parsed_options parsed( &all );
+        if( !parse_command_line_fast( argc, argv, all, parsed ) )
+            parsed = parse_command_line( argc, argv, all );
+        store( parsed, mCmndlineValuesMap );
 
         if( mCmndlineValuesMap.count("help") ) 
         {
-            cout << all;
-            exit(0);
+            getOutputStream() << all;
+            terminate(0);
         }
         if( mCmndlineValuesMap.count("version") )
             version(0);
@@ -199,14 +326,12 @@ public:
         properties.setProperty(LOG4CPLUS_TEXT("log4cplus.appender.STDOUT"),
                                LOG4CPLUS_TEXT("log4cplus::ConsoleAppender"));
 
-        PropertyConfigurator configurator( properties );
-        configurator.configure();
-
-        AgentLog4CPlus *al = new AgentLog4CPlus();
+        // log4cplus is configured when the first entry passes the profile
+        AgentLog4CPlus *al = new AgentLog4CPlus( properties );
         if( !al )
         {
             // this goes to stderr using default AgentLogImpl
-            LOG_BEGIN( loggerModuleName, ERROR_LOG | 0 );
+            SSNC_LOG_BEGIN( loggerModuleName, ERROR_LOG | 0 );
             LOG("Out of memory instantiating new AgentLogImpl");
             LOG_END;
 
@@ -227,20 +352,24 @@ public:
      */
     void version(int exit_code = 0) const
     {
-        ostream &os = exit_code ? cerr : cout;
+        ostream &os = exit_code ? getErrorStream() : getOutputStream();
 
         os << getApplName() << " " << getApplVersion() << " " << getApplDescription() << endl;
 
-        exit(exit_code);
+        terminate(exit_code);
     }
 
     /**
      * configures application
+     *
+     * Logging is left untouched in a hosted environment, it's configured
+     * once by the hosting process.
      */
     void configure()
     {
 #ifndef _NO_LOGGING
-        configure_logging( mCmndlineValuesMap["debug-level"].as<int>() );
+        if( !isHosted() )
+            configure_logging( mCmndlineValuesMap["debug-level"].as<int>() );
 #endif
 
         mSnmpComm.configure( mCmndlineValuesMap );
@@ -256,6 +385,10 @@ protected:
      * @see SnmpCheck
      */
     SnmpComm mSnmpComm;
+    /**
+     * environment of the hosting process, NULL when running standalone
+     */
+    HostedEnvironment *mHostedEnv;
 
     /**
      * contains the application name (e.g. check_cpu_by_snmp)
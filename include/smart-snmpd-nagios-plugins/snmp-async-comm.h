@@ -0,0 +1,929 @@
+/*
+ * Copyright 2010,2011 Matthias Haag, Jens Rehsack
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ *
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __SMART_SNMPD_NAGIOS_CHECKS_SNMP_ASYNC_COMM_H_INCLUDED__
+#define __SMART_SNMPD_NAGIOS_CHECKS_SNMP_ASYNC_COMM_H_INCLUDED__
+
+#include <smart-snmpd-nagios-plugins/snmp-pp-std.h>
+#include <smart-snmpd-nagios-plugins/snmp-comm.h>
+
+#ifdef HAVE_SYS_EPOLL_H
+#include <sys/epoll.h>
+#endif
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+#undef loggerModuleName
+#define loggerModuleName "nagiosplugins.snmpasynccomm"
+
+class SnmpAsyncComm;
+
+/**
+ * base class for requests handled by SnmpAsyncComm
+ *
+ * A request may consist of several PDUs (e.g. a table walk), it's done
+ * when finish() has been called. Request objects are owned by the caller
+ * and must live until they're done.
+ */
+class SnmpAsyncRequest
+{
+    friend class SnmpAsyncComm;
+
+public:
+    /**
+     * default constructor
+     */
+    SnmpAsyncRequest()
+        : mStatus( SNMP_CLASS_SUCCESS )
+        , mDone( false )
+        , mComm( 0 )
+        , mRequestId( 0 )
+    {}
+
+    /**
+     * destructor
+     */
+    virtual ~SnmpAsyncRequest() {}
+
+    /**
+     * called by SnmpAsyncComm when a response arrived or the request failed
+     *
+     * @param comm - engine the request was sent by, to send follow-up requests
+     * @param status - SNMP_CLASS_SUCCESS, the error status of the response or
+     *                 the reason of the failure (e.g. SNMP_CLASS_TIMEOUT)
+     * @param pdu - the received response
+     */
+    virtual void completed( SnmpAsyncComm &comm, int status, Pdu &pdu ) = 0;
+
+    /**
+     * @return true when the request is finished
+     */
+    inline bool isDone() const { return mDone; }
+
+    /**
+     * @return final status of the request, like the return value of the
+     *         according blocking SnmpComm method
+     */
+    inline int getStatus() const { return mStatus; }
+
+protected:
+    /**
+     * final status of the request
+     */
+    int mStatus;
+    /**
+     * set when the request is finished
+     */
+    bool mDone;
+    /**
+     * engine the outstanding pdu of this request was sent by, NULL when none is outstanding
+     */
+    SnmpAsyncComm *mComm;
+    /**
+     * request id of the outstanding pdu
+     */
+    unsigned long mRequestId;
+
+    /**
+     * marks the request as finished
+     *
+     * @param status - the final status
+     */
+    virtual void finish( int status )
+    {
+        mStatus = status;
+        mDone = true;
+    }
+};
+
+/**
+ * event driven snmp communication engine
+ *
+ * Unlike SnmpComm, SnmpAsyncComm doesn't wait for the response of a
+ * request. It sends the requests via the asynchronous interface of
+ * SNMP++ and delivers the responses to SnmpAsyncRequest objects while
+ * processing the events in run(). Any number of requests to any number
+ * of targets can be outstanding at the same time using one single
+ * socket.
+ *
+ * Timeouts and retries are taken from the targets, so targets configured
+ * by SnmpComm::configure_target() behave according to --timeout and
+ * --retries as with the blocking interface.
+ *
+ * The engine either creates a session of its own or sends by the session
+ * of a SnmpComm instance (e.g. one taken from the session pool). The
+ * pdus still outstanding when the engine is destroyed are cancelled.
+ */
+class SnmpAsyncComm
+{
+public:
+    /**
+     * constructor
+     *
+     * @param ipv6 - create a session for ipv6 targets
+     */
+    explicit SnmpAsyncComm( bool ipv6 = false )
+        : mSnmp( 0 )
+        , mOwnSession( true )
+        , mOutstanding()
+        , mPollFd( -1 )
+        , mPollFds()
+        , mDestroying( false )
+    {
+#ifdef _SNMPv3
+        SnmpComm::init_v3mp();
+#endif
+
+        int status = 0;
+        mSnmp = new Snmp( status, 0, ipv6 );
+        if( status != SNMP_CLASS_SUCCESS )
+        {
+            string msg( mSnmp->error_msg( status ) );
+            delete mSnmp; mSnmp = 0;
+            throw runtime_error( string("SNMP++ Session Create Fail, ") + msg );
+        }
+
+        create_poll_fd();
+    }
+
+    /**
+     * constructor sending by an existing session
+     *
+     * @param session - session to send the requests by, must outlive the engine
+     */
+    explicit SnmpAsyncComm( Snmp &session )
+        : mSnmp( &session )
+        , mOwnSession( false )
+        , mOutstanding()
+        , mPollFd( -1 )
+        , mPollFds()
+        , mDestroying( false )
+    {
+        create_poll_fd();
+    }
+
+    /**
+     * destructor - outstanding requests are dropped
+     */
+    virtual ~SnmpAsyncComm()
+    {
+        // SNMP++ might invoke the callback for outstanding requests while destroying the session
+        mDestroying = true;
+        while( !mOutstanding.empty() )
+            cancel( **mOutstanding.begin() );
+#ifdef HAVE_SYS_EPOLL_H
+        if( -1 != mPollFd )
+            close( mPollFd );
+#endif
+        if( mOwnSession )
+            delete mSnmp;
+        mSnmp = 0;
+    }
+
+    /**
+     * sends a get request
+     *
+     * @param pdu - the request, usually a copy of SnmpComm::get_pdu() with the vbs to fetch
+     * @param target - target to send the request to
+     * @param req - request object receiving the response
+     *
+     * @return SNMP_CLASS_SUCCESS when the request was sent, the error otherwise
+     */
+    int get( Pdu &pdu, SnmpTarget const &target, SnmpAsyncRequest &req )
+    {
+        return sent( req, pdu, mSnmp->get( pdu, target, async_callback, &req ) );
+    }
+
+    /**
+     * sends a get-next request
+     *
+     * @see get()
+     */
+    int get_next( Pdu &pdu, SnmpTarget const &target, SnmpAsyncRequest &req )
+    {
+        return sent( req, pdu, mSnmp->get_next( pdu, target, async_callback, &req ) );
+    }
+
+    /**
+     * sends a get-bulk request
+     *
+     * @param max_reps - max-repetitions of the request
+     *
+     * @see get()
+     */
+    int get_bulk( Pdu &pdu, SnmpTarget const &target, SnmpAsyncRequest &req, int max_reps = BulkMax )
+    {
+        return sent( req, pdu, mSnmp->get_bulk( pdu, target, 0, max_reps, async_callback, &req ) );
+    }
+
+    /**
+     * drops the outstanding pdu of a request - the request isn't notified anymore
+     *
+     * @param req - the request, left untouched when it has no pdu outstanding at this engine
+     */
+    void cancel( SnmpAsyncRequest &req )
+    {
+        if( this != req.mComm )
+            return;
+
+        mSnmp->cancel( req.mRequestId );
+        mOutstanding.erase( &req );
+        req.mComm = 0;
+    }
+
+    /**
+     * @return number of outstanding pdus
+     */
+    inline unsigned long pending() const { return mOutstanding.size(); }
+
+    /**
+     * waits for events and processes them
+     *
+     * @param max_wait_ms - maximum time to wait for events in milliseconds
+     *
+     * @throw runtime_error when waiting for events failed
+     */
+    void run_once( unsigned long max_wait_ms = 1000 )
+    {
+        EventListHolder *elh = mSnmp->get_eventListHolder();
+        unsigned long wait_ms = elh->SNMPGetNextTimeout();
+        if( wait_ms > max_wait_ms )
+            wait_ms = max_wait_ms;
+
+        int rc;
+#ifdef HAVE_SYS_EPOLL_H
+        // SNMP++ opens sockets on demand (e.g. for v3 engine discovery)
+        sync_poll_fds();
+
+        struct epoll_event events[16];
+        rc = epoll_wait( mPollFd, events, lengthof(events), static_cast<int>( wait_ms ) );
+#else
+        int maxfds = 0;
+        fd_set readfds, writefds, exceptfds;
+        FD_ZERO( &readfds ); FD_ZERO( &writefds ); FD_ZERO( &exceptfds );
+        elh->SNMPGetFdSets( maxfds, readfds, writefds, exceptfds );
+
+        struct timeval tv;
+        tv.tv_sec = wait_ms / 1000;
+        tv.tv_usec = ( wait_ms % 1000 ) * 1000;
+        rc = select( maxfds, &readfds, &writefds, &exceptfds, &tv );
+#endif
+        if( ( -1 == rc ) && ( EINTR != errno ) )
+            throw runtime_error( string("Can't wait for snmp events: ") + strerror(errno) );
+
+        // reads all pending responses and handles timeouts/retries
+        elh->SNMPProcessPendingEvents();
+    }
+
+    /**
+     * processes events until all outstanding requests are done
+     */
+    void run()
+    {
+        while( !mOutstanding.empty() )
+            run_once();
+    }
+
+protected:
+    /**
+     * snmp session shared by all requests
+     */
+    Snmp *mSnmp;
+    /**
+     * set when mSnmp is created and destroyed by this engine
+     */
+    bool mOwnSession;
+    /**
+     * requests with an outstanding pdu
+     */
+    set<SnmpAsyncRequest *> mOutstanding;
+    /**
+     * epoll instance waiting for the session sockets
+     */
+    int mPollFd;
+
+    /**
+     * session sockets registered at mPollFd
+     */
+    vector<int> mPollFds;
+
+    /**
+     * set while the engine is destroyed
+     */
+    bool mDestroying;
+
+    /**
+     * creates the epoll instance, if supported
+     *
+     * @throw runtime_error when it can't be created
+     */
+    void create_poll_fd()
+    {
+#ifdef HAVE_SYS_EPOLL_H
+        if( -1 == ( mPollFd = epoll_create( 16 ) ) )
+        {
+            if( mOwnSession )
+                delete mSnmp;
+            mSnmp = 0;
+            throw runtime_error( string("Can't create epoll instance: ") + strerror(errno) );
+        }
+#endif
+    }
+
+#ifdef HAVE_SYS_EPOLL_H
+    /**
+     * registers the current sockets of the session at mPollFd and drops
+     * those the session doesn't use anymore
+     *
+     * @throw runtime_error when a socket can't be registered
+     */
+    void sync_poll_fds()
+    {
+        int maxfds = 0;
+        fd_set readfds, writefds, exceptfds;
+        FD_ZERO( &readfds ); FD_ZERO( &writefds ); FD_ZERO( &exceptfds );
+        mSnmp->get_eventListHolder()->SNMPGetFdSets( maxfds, readfds, writefds, exceptfds );
+
+        struct epoll_event ev;
+        memset( &ev, 0, sizeof(ev) );
+
+        for( vector<int>::iterator i = mPollFds.begin(); i != mPollFds.end(); )
+        {
+            if( ( *i < maxfds ) && FD_ISSET( *i, &readfds ) )
+            {
+                ++i;
+                continue;
+            }
+
+            // closed sockets are removed by the kernel already
+            epoll_ctl( mPollFd, EPOLL_CTL_DEL, *i, &ev );
+            i = mPollFds.erase( i );
+        }
+
+        for( int fd = 0; fd < maxfds; ++fd )
+        {
+            if( !FD_ISSET( fd, &readfds ) )
+                continue;
+
+            ev.events = EPOLLIN;
+            ev.data.fd = fd;
+            // a registered fd might have been closed and reused for a new socket
+            if( 0 == epoll_ctl( mPollFd, EPOLL_CTL_MOD, fd, &ev ) )
+                continue;
+            if( ( ENOENT != errno ) || ( 0 != epoll_ctl( mPollFd, EPOLL_CTL_ADD, fd, &ev ) ) )
+                throw runtime_error( string("Can't poll snmp session socket: ") + strerror(errno) );
+            if( find( mPollFds.begin(), mPollFds.end(), fd ) == mPollFds.end() )
+                mPollFds.push_back( fd );
+        }
+    }
+#endif
+
+    inline int sent( SnmpAsyncRequest &req, Pdu const &pdu, int rc )
+    {
+        if( SNMP_CLASS_SUCCESS == rc )
+        {
+            // SNMP++ stores the request id of the sent pdu in pdu
+            req.mComm = this;
+            req.mRequestId = pdu.get_request_id();
+            mOutstanding.insert( &req );
+        }
+        return rc;
+    }
+
+    /**
+     * callback invoked by SNMP++ for each response or timeout
+     */
+    static void async_callback( int reason, Snmp *session, Pdu &pdu, SnmpTarget &target, void *data )
+    {
+        (void)session;
+        (void)target;
+
+        SnmpAsyncRequest *req = static_cast<SnmpAsyncRequest *>( data );
+        if( ( NULL == req ) || ( NULL == req->mComm ) || req->mComm->mDestroying )
+            return;
+
+        SnmpAsyncComm &comm = *req->mComm;
+        int status = reason;
+
+        if( SNMP_CLASS_ASYNC_RESPONSE == reason )
+            status = pdu.get_error_status() ? pdu.get_error_status() : SNMP_CLASS_SUCCESS;
+
+        SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
+        LOG( "async_callback: reason, status" );
+        LOG( reason );
+        LOG( status );
+        LOG_END;
+
+        comm.mOutstanding.erase( req );
+        req->mComm = 0;
+        req->completed( comm, status, pdu );
+    }
+
+private:
+    /**
+     * forbidden copy constructor
+     */
+    SnmpAsyncComm( SnmpAsyncComm const & );
+    /**
+     * forbidden assignment operator
+     */
+    SnmpAsyncComm & operator = ( SnmpAsyncComm const & );
+};
+
+/**
+ * asynchronous counterpart of SnmpComm::get( vector<Vb> & )
+ */
+class SnmpAsyncGet
+    : public SnmpAsyncRequest
+{
+public:
+    /**
+     * constructor
+     *
+     * @param vblist - vbs to fetch, receives the fetched values
+     */
+    SnmpAsyncGet( vector<Vb> &vblist )
+        : SnmpAsyncRequest()
+        , mVbList( vblist )
+    {}
+
+    virtual ~SnmpAsyncGet() {}
+
+    /**
+     * sends the request
+     *
+     * @param comm - engine to send the request by
+     * @param target - target to send the request to
+     * @param pduTemplate - pdu to start with (see SnmpComm::get_pdu())
+     *
+     * @return SNMP_CLASS_SUCCESS when the request was sent or there is nothing
+     *         to fetch (the request is done immediately), the error otherwise
+     */
+    int start( SnmpAsyncComm &comm, SnmpTarget const &target, Pdu const &pduTemplate )
+    {
+        if( mVbList.empty() )
+        {
+            finish( SNMP_CLASS_SUCCESS );
+            return SNMP_CLASS_SUCCESS;
+        }
+
+        Pdu pdu( pduTemplate ); // start fresh
+        pdu.set_vblist( &mVbList[0], mVbList.size() );
+
+        int rc = comm.get( pdu, target, *this );
+        if( SNMP_CLASS_SUCCESS != rc )
+            finish( rc );
+        return rc;
+    }
+
+    virtual void completed( SnmpAsyncComm &comm, int status, Pdu &pdu )
+    {
+        (void)comm;
+
+        if( ( SNMP_CLASS_SUCCESS == status ) && !pdu.get_vblist( &mVbList[0], mVbList.size() ) )
+            status = SNMP_CLASS_INTERNAL_ERROR;
+
+        finish( status );
+    }
+
+protected:
+    vector<Vb> &mVbList;
+
+private:
+    SnmpAsyncGet();
+};
+
+/**
+ * asynchronous counterpart of SnmpComm::get_table()
+ *
+ * Walks the columns given by the start oids using get-bulk requests and
+ * passes each row to f, until f returns true or the end of the table is
+ * reached.
+ */
+template < class F >
+class SnmpAsyncGetTable
+    : public SnmpAsyncRequest
+{
+public:
+    /**
+     * constructor
+     *
+     * @param start - the column oids to walk
+     * @param f - functor receiving the rows
+     * @param max_reps - max-repetitions of each get-bulk request
+     */
+    SnmpAsyncGetTable( vector<Oid> const &start, F &f, int max_reps = BulkMax )
+        : SnmpAsyncRequest()
+        , mStart( start )
+        , mF( f )
+        , mMaxReps( max_reps )
+        , mTarget( 0 )
+        , mPdu()
+        , mVbVec()
+    {}
+
+    virtual ~SnmpAsyncGetTable() {}
+
+    /**
+     * sends the first request
+     *
+     * @param comm - engine to send the requests by
+     * @param target - target to send the requests to, must live until the request is done
+     * @param pduTemplate - pdu to start with (see SnmpComm::get_pdu())
+     *
+     * @return SNMP_CLASS_SUCCESS when the request was sent or there are no
+     *         columns to walk (the request is done immediately), the error otherwise
+     */
+    int start( SnmpAsyncComm &comm, SnmpTarget const &target, Pdu const &pduTemplate )
+    {
+        if( mStart.empty() )
+        {
+            finish( SNMP_CLASS_SUCCESS );
+            return SNMP_CLASS_SUCCESS;
+        }
+
+        mTarget = &target;
+        mPdu = pduTemplate;
+        mVbVec.assign( mStart.begin(), mStart.end() );
+        mPdu.set_vblist( &mVbVec[0], mVbVec.size() );
+
+        return next( comm );
+    }
+
+    virtual void completed( SnmpAsyncComm &comm, int status, Pdu &pdu )
+    {
+        int num_vbs_received;
+
+        if( SNMP_CLASS_SUCCESS != status )
+        {
+            finish( status );
+            return;
+        }
+
+        if( ( 0 == ( num_vbs_received = pdu.get_vb_count() ) ) ||
+            ( ( 1 == num_vbs_received ) && ( pdu.get_vb( 0 ).get_syntax() == sNMP_SYNTAX_ENDOFMIBVIEW ) ) )
+        {
+            finish( SNMP_CLASS_SUCCESS );
+            return;
+        }
+
+        if( num_vbs_received % mVbVec.size() )
+        {
+            // invalid number of results - can't be assigned to the columns
+            finish( SNMP_CLASS_INTERNAL_ERROR );
+            return;
+        }
+
+        for( int z = 0; z < num_vbs_received; z += mVbVec.size() )
+        {
+            for( vector<Vb>::size_type i = 0; i < mVbVec.size(); ++i )
+            {
+                // exceptions keep the oid of the request - they'd match the column
+                if( !pdu.get_vb( mVbVec[i], z + i ) ||
+                    is_exception( mVbVec[i].get_syntax() ) ||
+                    ( mStart[i].nCompare( mStart[i].len(), mVbVec[i].get_oid() ) != 0 ) )
+                {
+                    finish( SNMP_CLASS_SUCCESS );
+                    return;
+                }
+            }
+
+            if( mF( mVbVec ) )
+            {
+                finish( SNMP_CLASS_SUCCESS );
+                return;
+            }
+        }
+
+        for( vector<Vb>::iterator i = mVbVec.begin(); i != mVbVec.end(); ++i )
+            i->set_null();
+        mPdu.set_vblist( &mVbVec[0], mVbVec.size() );
+
+        next( comm );
+    }
+
+protected:
+    vector<Oid> const &mStart;
+    F &mF;
+    int mMaxReps;
+    SnmpTarget const *mTarget;
+    Pdu mPdu;
+    vector<Vb> mVbVec;
+
+    static bool is_exception( SmiUINT32 syntax )
+    {
+        return ( sNMP_SYNTAX_ENDOFMIBVIEW == syntax ) ||
+               ( sNMP_SYNTAX_NOSUCHOBJECT == syntax ) ||
+               ( sNMP_SYNTAX_NOSUCHINSTANCE == syntax );
+    }
+
+    int next( SnmpAsyncComm &comm )
+    {
+        Pdu pdu( mPdu );
+        int rc = comm.get_bulk( pdu, *mTarget, *this, mMaxReps );
+        if( SNMP_CLASS_SUCCESS != rc )
+            finish( rc );
+        return rc;
+    }
+
+private:
+    SnmpAsyncGetTable();
+};
+
+/**
+ * walks the columns of a table in parallel streams and merges the rows by index
+ *
+ * Each column is walked by a SnmpAsyncGetTable of its own, at most
+ * concurrency of them are outstanding at the same time. The responses
+ * of each column arrive in the order of the row index, so a row is
+ * passed to the functor as soon as every column is walked beyond its
+ * index - only the rows between the slowest and the fastest stream are
+ * kept in memory. Cells missing in a column (sparse tables) are passed
+ * as noSuchInstance.
+ */
+template < class F >
+class SnmpParallelGetTable
+{
+protected:
+    typedef map< Oid, vector<Vb> > RowMapType;
+
+    /**
+     * stores the cells of one column into the rows of the walk
+     */
+    class ColumnCollector
+    {
+    public:
+        ColumnCollector( SnmpParallelGetTable &walk, vector<Vb>::size_type index )
+            : mWalk( walk )
+            , mIndex( index )
+        {}
+
+        template < class Row >
+        bool operator () (Row const &row)
+        {
+            return mWalk.add_cell( mIndex, row[0] );
+        }
+
+    protected:
+        SnmpParallelGetTable &mWalk;
+        vector<Vb>::size_type mIndex;
+    };
+
+public:
+    /**
+     * @param start - the column oids to walk
+     * @param f - functor receiving the merged rows, returns true to stop
+     * @param concurrency - maximum number of outstanding streams
+     * @param max_reps - max-repetitions of each get-bulk request
+     */
+    SnmpParallelGetTable( vector<Oid> const &start, F &f, unsigned concurrency, int max_reps = BulkMax )
+        : mStart( start )
+        , mF( f )
+        , mConcurrency( concurrency ? concurrency : 1 )
+        , mMaxReps( max_reps )
+        , mStopped( false )
+        , mRows()
+        , mPositions()
+        , mColumnStarts()
+        , mCollectors()
+        , mStreams()
+    {}
+
+    ~SnmpParallelGetTable()
+    {
+        for( typename vector< SnmpAsyncGetTable<ColumnCollector> * >::iterator i = mStreams.begin(); i != mStreams.end(); ++i )
+            delete *i;
+    }
+
+    /**
+     * walks the table and passes the rows to the functor
+     *
+     * @param comm - engine to send the requests by
+     * @param target - target to send the requests to
+     * @param pduTemplate - pdu to start with (see SnmpComm::get_pdu())
+     * @param deadline - SnmpComm::now_ms() to give up at, 0 for none
+     *
+     * @return SNMP_CLASS_SUCCESS, SNMP_CLASS_TIMEOUT when the deadline passed
+     *         or the error of the first failed stream
+     */
+    int run( SnmpAsyncComm &comm, SnmpTarget const &target, Pdu const &pduTemplate, long long deadline = 0 )
+    {
+        vector<Oid>::size_type columns = mStart.size();
+
+        // the streams refer to these - no reallocation once they're started
+        mColumnStarts.assign( columns, vector<Oid>( 1 ) );
+        mPositions.assign( columns, Oid() );
+        mCollectors.reserve( columns );
+        for( vector<Oid>::size_type c = 0; c < columns; ++c )
+        {
+            mColumnStarts[c][0] = mStart[c];
+            mCollectors.push_back( ColumnCollector( *this, c ) );
+        }
+
+        int rc = SNMP_CLASS_SUCCESS;
+        for( ;; )
+        {
+            unsigned running = 0;
+            for( typename vector< SnmpAsyncGetTable<ColumnCollector> * >::iterator i = mStreams.begin(); i != mStreams.end(); ++i )
+            {
+                if( !(*i)->isDone() )
+                    ++running;
+                else if( ( SNMP_CLASS_SUCCESS == rc ) && ( SNMP_CLASS_SUCCESS != (*i)->getStatus() ) )
+                    rc = (*i)->getStatus();
+            }
+
+            while( ( SNMP_CLASS_SUCCESS == rc ) && ( running < mConcurrency ) && ( mStreams.size() < columns ) )
+            {
+                vector<Oid>::size_type c = mStreams.size();
+                mStreams.push_back( new SnmpAsyncGetTable<ColumnCollector>( mColumnStarts[c], mCollectors[c], mMaxReps ) );
+                rc = mStreams.back()->start( comm, target, pduTemplate );
+                if( !mStreams.back()->isDone() )
+                    ++running;
+            }
+
+            if( ( SNMP_CLASS_SUCCESS != rc ) || emit_rows() || ( ( 0 == running ) && ( mStreams.size() == columns ) ) )
+                break;
+
+            unsigned long wait_ms = 1000;
+            if( deadline )
+            {
+                long long left = deadline - SnmpComm::now_ms();
+                if( left <= 0 )
+                {
+                    rc = SNMP_CLASS_TIMEOUT;
+                    break;
+                }
+                if( left < static_cast<long long>( wait_ms ) )
+                    wait_ms = static_cast<unsigned long>( left );
+            }
+
+            comm.run_once( wait_ms );
+        }
+
+        // stopped early, failed or timed out - the streams are destroyed with this walk
+        for( typename vector< SnmpAsyncGetTable<ColumnCollector> * >::iterator i = mStreams.begin(); i != mStreams.end(); ++i )
+            comm.cancel( **i );
+
+        SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 5 );
+        LOG( "SnmpParallelGetTable: columns, concurrency, status, rows left" );
+        LOG( columns );
+        LOG( mConcurrency );
+        LOG( rc );
+        LOG( mRows.size() );
+        LOG_END;
+
+        return rc;
+    }
+
+protected:
+    vector<Oid> const &mStart;
+    F &mF;
+    unsigned mConcurrency;
+    int mMaxReps;
+    /**
+     * set when the functor asked to stop
+     */
+    bool mStopped;
+    /**
+     * rows not passed to the functor yet
+     */
+    RowMapType mRows;
+    /**
+     * index of the last row received for each column, empty before the first one
+     */
+    vector<Oid> mPositions;
+    vector< vector<Oid> > mColumnStarts;
+    vector<ColumnCollector> mCollectors;
+    vector< SnmpAsyncGetTable<ColumnCollector> * > mStreams;
+
+    /**
+     * stores a cell received for column c
+     *
+     * @return true when the stream shall stop
+     */
+    bool add_cell( vector<Vb>::size_type c, Vb const &vb )
+    {
+        Oid oid, rowIndex;
+        vb.get_oid( oid );
+        for( unsigned long i = mStart[c].len(); i < oid.len(); ++i )
+            rowIndex += oid[i];
+
+        typename RowMapType::iterator ri = mRows.find( rowIndex );
+        if( ri == mRows.end() )
+            ri = mRows.insert( make_pair( rowIndex, vector<Vb>( mStart.size() ) ) ).first;
+        ri->second[c] = vb;
+        mPositions[c] = rowIndex;
+
+        return mStopped;
+    }
+
+    /**
+     * passes the rows each column is walked beyond to the functor
+     *
+     * @return true when the functor asked to stop
+     */
+    bool emit_rows()
+    {
+        // a row is complete when each column is walked to its end or beyond its index
+        Oid const *bound = NULL;
+        for( vector<Oid>::size_type c = 0; c < mStart.size(); ++c )
+        {
+            if( ( c < mStreams.size() ) && mStreams[c]->isDone() )
+                continue;
+            if( ( c >= mStreams.size() ) || ( 0 == mPositions[c].len() ) )
+                return false;
+            if( ( NULL == bound ) || ( mPositions[c] < *bound ) )
+                bound = &mPositions[c];
+        }
+
+        while( !mRows.empty() && ( ( NULL == bound ) || !( *bound < mRows.begin()->first ) ) )
+        {
+            typename RowMapType::iterator ri = mRows.begin();
+            for( vector<Oid>::size_type c = 0; c < mStart.size(); ++c )
+            {
+                Vb &vb = ri->second[c];
+                if( vb.get_syntax() == sNMP_SYNTAX_NULL )
+                {
+                    Oid oid( mStart[c] );
+                    oid += ri->first;
+                    vb.set_oid( oid );
+                    vb.set_syntax( sNMP_SYNTAX_NOSUCHINSTANCE );
+                }
+            }
+
+            mStopped = mF( ri->second );
+            mRows.erase( ri );
+            if( mStopped )
+                return true;
+        }
+
+        return false;
+    }
+
+private:
+    SnmpParallelGetTable();
+    SnmpParallelGetTable( SnmpParallelGetTable const & );
+    SnmpParallelGetTable & operator = ( SnmpParallelGetTable const & );
+};
+
+/**
+ * walks the columns given by start in parallel streams (see SnmpParallelGetTable)
+ *
+ * The streams are sent by the session of comm (e.g. a pooled one), each
+ * try waits as long as the round trip times measured by comm suggest,
+ * and the walk gives up at the deadline of comm.
+ *
+ * @param comm - communication configured for the target
+ * @param start - the column oids to walk
+ * @param f - functor receiving each row, returns true to stop
+ * @param concurrency - maximum number of outstanding streams
+ *
+ * @return SNMP_CLASS_SUCCESS, SNMP_CLASS_TIMEOUT or the error of the first failed stream
+ */
+template < class F >
+int get_table_parallel( SnmpComm &comm, vector<Oid> const &start, F &f, unsigned concurrency )
+{
+    SnmpTarget &target = *comm.get_target();
+    unsigned long maxTimeout = target.get_timeout();
+    target.set_timeout( ( comm.get_request_timeout() + 9999 ) / 10000 ); // in hundreds of seconds
+
+    int rc;
+    try
+    {
+        SnmpAsyncComm asyncComm( *comm.get_session() );
+        SnmpParallelGetTable<F> walk( start, f, concurrency, comm.get_bulk_repetitions() );
+
+        rc = walk.run( asyncComm, target, comm.get_pdu(), comm.get_deadline() );
+    }
+    catch( ... )
+    {
+        target.set_timeout( maxTimeout );
+        throw;
+    }
+    target.set_timeout( maxTimeout );
+
+    return rc;
+}
+
+#undef loggerModuleName
+
+#endif /* __SMART_SNMPD_NAGIOS_CHECKS_SNMP_ASYNC_COMM_H_INCLUDED__ */
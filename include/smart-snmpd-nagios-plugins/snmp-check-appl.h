@@ -17,10 +17,16 @@
 #ifndef __SMART_SNMPD_NAGIOS_CHECKS_SNMP_CHECK_APPL_H_INCLUDED__
 #define __SMART_SNMPD_NAGIOS_CHECKS_SNMP_CHECK_APPL_H_INCLUDED__
 
+#include <smart-snmpd-nagios-plugins/oids.h>
 #include <smart-snmpd-nagios-plugins/snmp-comm.h>
 #include <smart-snmpd-nagios-plugins/nagios-stats.h>
 #include <smart-snmpd-nagios-plugins/snmp-daemon-identifiers.h>
 #include <smart-snmpd-nagios-plugins/snmp-appl.h>
+#include <smart-snmpd-nagios-plugins/multi-host-check.h>
+
+#include <boost/regex.hpp>
+
+#include <fnmatch.h>
 
 #undef loggerModuleName
 #define loggerModuleName "nagiosplugins.checkappl"
@@ -67,6 +73,8 @@ public:
     FetchStaticObjects()
         : SnmpAppl()
         , mFetchedData()
+        , mFetchSysUpTime(false)
+        , mSysUpTime()
     {}
 
     /**
@@ -93,14 +101,30 @@ public:
      * fetch the data from snmpd
      *
      * @param mibData - the specification which data to fetch
+     * @param extraVbs - additional varbinds to request along with the data, receive their values
      */
-    void fetchData(SupportedMibData &mibData)
+    void fetchData(SupportedMibData &mibData, vector<Vb> *extraVbs = NULL)
     {
         vector<Oid> const &dataOids = mibData.getDataOids();
 
         mFetchedData.assign( dataOids.begin(), dataOids.end() );
+        if( extraVbs )
+            mFetchedData.insert( mFetchedData.end(), extraVbs->begin(), extraVbs->end() );
+        if( mFetchSysUpTime )
+            mFetchedData.push_back( Vb( Oid( SYS_UPTIME ".0" ) ) );
         if( SNMP_CLASS_SUCCESS != mSnmpComm.get( mFetchedData ) )
             throw snmp_bad_request( string( "Cannot fetch values to check from " ) + getDaemonName() );
+        if( mFetchSysUpTime )
+        {
+            mSysUpTime = mFetchedData.back();
+            mFetchedData.pop_back();
+        }
+        if( extraVbs )
+        {
+            vector<Vb>::iterator extraBegin = mFetchedData.end() - extraVbs->size();
+            extraVbs->assign( extraBegin, mFetchedData.end() );
+            mFetchedData.erase( extraBegin, mFetchedData.end() );
+        }
     }
 
     /**
@@ -108,11 +132,31 @@ public:
      */
     vector<Vb> const & getFetchedData() const { return mFetchedData; }
 
+    /**
+     * requests sysUpTime.0 along with the data to check
+     *
+     * @param fetch - true to fetch sysUpTime.0, false otherwise
+     */
+    void setFetchSysUpTime( bool fetch ) { mFetchSysUpTime = fetch; }
+
+    /**
+     * @return sysUpTime.0 fetched along with the data to check
+     */
+    Vb const & getSysUpTime() const { return mSysUpTime; }
+
 protected:
     /**
      *
      */
     vector<Vb> mFetchedData;
+    /**
+     * fetch sysUpTime.0 along with the data to check
+     */
+    bool mFetchSysUpTime;
+    /**
+     * sysUpTime.0 fetched along with the data to check
+     */
+    Vb mSysUpTime;
 };
 
 class FetchTableObjects
@@ -132,9 +176,10 @@ protected:
 
         ~GetBulkSearchMatchingRow() {}
 
-        bool operator () (vector<Vb> const &varBinds)
+        template < class Row >
+        bool operator () (Row const &varBinds)
         {
-            for( vector<Vb>::size_type i = 0; i < varBinds.size(); ++i )
+            for( typename Row::size_type i = 0; i < varBinds.size(); ++i )
             {
                 Oid idxOid;
                 varBinds[i].get_oid( idxOid );
@@ -168,17 +213,186 @@ protected:
         GetBulkSearchMatchingRow();
     };
 
+public:
+    /**
+     * selects table rows by name
+     *
+     * The specification is either "all", a glob pattern (containing one
+     * of "*?["), "~" followed by a regular expression or a plain name -
+     * optionally followed by ";" and arguments for the check of the
+     * selected rows. Nagios object definitions take ";" as the start of a
+     * comment - it has to be written as "\;" there.
+     */
+    class TableRowPattern
+    {
+    public:
+        explicit TableRowPattern( string const &spec )
+            : mPattern( spec )
+            , mArguments()
+            , mType( PlainName )
+            , mRegex()
+        {
+            string::size_type pos = spec.find( ';' );
+            if( pos != string::npos )
+            {
+                mPattern = spec.substr( 0, pos );
+                mArguments = spec.substr( pos + 1 );
+            }
+
+            if( "all" == mPattern )
+                mType = AllRows;
+            else if( ( mPattern.length() > 1 ) && ( '~' == mPattern[0] ) )
+            {
+                mType = RegexPattern;
+                mRegex.assign( mPattern.substr( 1 ) );
+            }
+            else if( mPattern.find_first_of( "*?[" ) != string::npos )
+                mType = GlobPattern;
+        }
+
+        bool matches( string const &name ) const
+        {
+            switch( mType )
+            {
+            case AllRows:
+                return true;
+            case GlobPattern:
+                return 0 == fnmatch( mPattern.c_str(), name.c_str(), 0 );
+            case RegexPattern:
+                return boost::regex_match( name, mRegex );
+            default:
+                return name == mPattern;
+            }
+        }
+
+        /**
+         * @return true when exactly one row is selected by name without arguments
+         */
+        bool isPlainName() const { return ( PlainName == mType ) && mArguments.empty(); }
+
+        /**
+         * @return precedence of the pattern for rows matched by several ones:
+         *         plain names before glob patterns and regular expressions before "all"
+         */
+        int getPrecedence() const
+        {
+            switch( mType )
+            {
+            case PlainName:
+                return 2;
+            case AllRows:
+                return 0;
+            default:
+                return 1;
+            }
+        }
+
+        string const & getPattern() const { return mPattern; }
+        string const & getArguments() const { return mArguments; }
+
+    protected:
+        enum PatternType { PlainName, AllRows, GlobPattern, RegexPattern };
+
+        string mPattern;
+        string mArguments;
+        PatternType mType;
+        boost::regex mRegex;
+    };
+
+    /**
+     * a table row selected by a TableRowPattern
+     */
+    struct MatchedRow
+    {
+        /**
+         * index of the pattern in the list of patterns which selected the row
+         */
+        vector<TableRowPattern>::size_type mPattern;
+        /**
+         * values of the data columns of the row
+         */
+        vector<Vb> mData;
+    };
+
+protected:
+    class GetBulkCollectMatchingRows
+    {
+    public:
+        /**
+         * @param searchColumns - number of leading columns containing the names
+         * @param patterns - the patterns selecting the rows
+         * @param rows - receives the selected rows
+         * @param matched - receives for each pattern whether it matched any row
+         */
+        GetBulkCollectMatchingRows( vector<Oid>::size_type searchColumns, vector<TableRowPattern> const &patterns,
+                                    vector<MatchedRow> &rows, vector<bool> &matched )
+            : mSearchColumns( searchColumns )
+            , mPatterns( patterns )
+            , mRows( rows )
+            , mMatched( matched )
+        {
+            mMatched.assign( mPatterns.size(), false );
+        }
+
+        ~GetBulkCollectMatchingRows() {}
+
+        template < class Row >
+        bool operator () (Row const &varBinds)
+        {
+            // a row matched by several patterns belongs to the one with the highest precedence,
+            // the first given one among equal ones
+            vector<TableRowPattern>::size_type best = mPatterns.size();
+            for( vector<TableRowPattern>::size_type p = 0; p < mPatterns.size(); ++p )
+            {
+                for( vector<Vb>::size_type i = 0; i < mSearchColumns; ++i )
+                {
+                    if( mPatterns[p].matches( varBinds[i].get_printable_value() ) )
+                    {
+                        mMatched[p] = true;
+                        if( ( best == mPatterns.size() ) || ( mPatterns[p].getPrecedence() > mPatterns[best].getPrecedence() ) )
+                            best = p;
+                        break;
+                    }
+                }
+            }
+
+            if( best != mPatterns.size() )
+            {
+                mRows.push_back( MatchedRow() );
+                mRows.back().mPattern = best;
+                for( typename Row::size_type c = mSearchColumns; c < varBinds.size(); ++c )
+                    mRows.back().mData.push_back( varBinds[c] );
+            }
+
+            return false;
+        }
+
+    protected:
+        vector<Oid>::size_type mSearchColumns;
+        vector<TableRowPattern> const &mPatterns;
+        vector<MatchedRow> &mRows;
+        vector<bool> &mMatched;
+
+    private:
+        GetBulkCollectMatchingRows();
+    };
+
 public:
     FetchTableObjects()
         : FetchStaticObjects()
         , mName()
+        , mRowPatterns()
+        , mMatchedRows()
+        , mUnmatchedPatterns()
     {}
 
     virtual void add_check_options(options_description &checkopts) const
     {
         checkopts.add_options()
             ("index,i", value<long>(), "table index of object to check")
-            ("name,n", value<string>(), "name of the object to check")
+            ("name,n", value< vector<string> >()->composing(),
+                "name of the object to check - \"all\", a glob pattern or ~REGEX select several objects (may be repeated), "
+                "optionally followed by ;ARGUMENTS of the plugin (nagios object definitions need \\; since ; starts a comment there)")
             ;
     }
 
@@ -194,7 +408,27 @@ public:
     {
         SnmpAppl::configure();
 
-        mName = mCmndlineValuesMap["name"].as<string>();
+        mRowPatterns.clear();
+        if( mCmndlineValuesMap.count("name") )
+        {
+            vector<string> const &names = mCmndlineValuesMap["name"].as< vector<string> >();
+            for( vector<string>::const_iterator ci = names.begin(); ci != names.end(); ++ci )
+                mRowPatterns.push_back( TableRowPattern( *ci ) );
+        }
+
+        if( ( 1 == mRowPatterns.size() ) && mRowPatterns[0].isPlainName() )
+            mName = mRowPatterns[0].getPattern();
+    }
+
+    /**
+     * @return true when several rows are selected by --name, false when one row is addressed
+     */
+    bool isMultiRow() const
+    {
+        if( mCmndlineValuesMap.count("index") && !mCmndlineValuesMap["index"].defaulted() )
+            return false;
+
+        return !( ( 1 == mRowPatterns.size() ) && mRowPatterns[0].isPlainName() );
     }
 
     void fetchData(SupportedMibDataTable &mibData)
@@ -204,24 +438,152 @@ public:
             mibData.setFoundRowIndex( mCmndlineValuesMap["index"].as<long>() );
             FetchStaticObjects::fetchData(mibData);
         }
+        else if( isMultiRow() )
+        {
+            fetchMatchingRows(mibData);
+        }
         else
         {
             vector<Oid> const & nameSearchOids( mibData.getRowSearchColumnOids() );
 
+            long cachedRowIndex = mSnmpComm.get_cached_row_index( nameSearchOids, mName );
+            if( -1 != cachedRowIndex )
+            {
+                if( fetchDataVerifyingRow( mibData, nameSearchOids, cachedRowIndex ) )
+                {
+                    SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 5 );
+                    LOG( "using remembered row index" );
+                    LOG( mName.c_str() );
+                    LOG( cachedRowIndex );
+                    LOG_END;
+
+                    return;
+                }
+
+                SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 5 );
+                LOG( "remembered row index doesn't match anymore - searching again" );
+                LOG( mName.c_str() );
+                LOG( cachedRowIndex );
+                LOG_END;
+
+                mSnmpComm.remember_row_index( nameSearchOids, mName, -1 );
+            }
+
             GetBulkSearchMatchingRow searchMatchingRow( nameSearchOids, mName );
 
-            if( SNMP_CLASS_SUCCESS != mSnmpComm.get_table( nameSearchOids, searchMatchingRow ) )
+            if( SNMP_CLASS_SUCCESS != mSnmpComm.get_table_snapshot( mibData.getLastUpdateOid(), nameSearchOids, searchMatchingRow ) )
                 throw snmp_bad_request( string( "Cannot fetch values to search for '" ) + mName + "' from " + getDaemonName() );
             if( -1 == searchMatchingRow.getFoundRowIndex() )
                 throw snmp_bad_result( string( "Cannot find row matching '" ) + mName + "' from " + getDaemonName() );
 
             mibData.setFoundRowIndex( searchMatchingRow.getFoundRowIndex() );
             FetchStaticObjects::fetchData(mibData);
+            mSnmpComm.remember_row_index( nameSearchOids, mName, searchMatchingRow.getFoundRowIndex() );
         }
     }
 
+    /**
+     * @return the patterns given by --name
+     */
+    vector<TableRowPattern> const & getRowPatterns() const { return mRowPatterns; }
+
+    /**
+     * @return the rows selected by the patterns given by --name
+     */
+    vector<MatchedRow> const & getMatchedRows() const { return mMatchedRows; }
+
+    /**
+     * @return indices of the patterns given by --name which didn't match any row
+     */
+    vector<vector<TableRowPattern>::size_type> const & getUnmatchedPatterns() const { return mUnmatchedPatterns; }
+
 protected:
     string mName;
+    vector<TableRowPattern> mRowPatterns;
+    vector<MatchedRow> mMatchedRows;
+    vector<vector<TableRowPattern>::size_type> mUnmatchedPatterns;
+
+    /**
+     * walks the search and data columns once and collects the rows matching any of the patterns
+     *
+     * Patterns which don't match any row are remembered to be reported by
+     * the check - only when no pattern matches anything, it fails.
+     *
+     * @param mibData - the specification which data to fetch
+     */
+    void fetchMatchingRows(SupportedMibDataTable &mibData)
+    {
+        vector<Oid> const &searchOids = mibData.getRowSearchColumnOids();
+        vector<Oid> const &columnOids = mibData.getColumnOids();
+        vector<Oid> walkOids( searchOids );
+        walkOids.insert( walkOids.end(), columnOids.begin(), columnOids.end() );
+
+        mMatchedRows.clear();
+        mUnmatchedPatterns.clear();
+        vector<bool> matched;
+        GetBulkCollectMatchingRows collectMatchingRows( searchOids.size(), mRowPatterns, mMatchedRows, matched );
+
+        // the uptime is requested as non-repeater of the first request of the walk
+        vector<Vb> scalars;
+        if( mFetchSysUpTime )
+            scalars.push_back( Vb( Oid( SYS_UPTIME ".0" ) ) );
+
+        if( SNMP_CLASS_SUCCESS != mSnmpComm.get_table_snapshot( mibData.getLastUpdateOid(), scalars, walkOids, collectMatchingRows ) )
+            throw snmp_bad_request( string( "Cannot fetch values to search for matching rows from " ) + getDaemonName() );
+        if( mMatchedRows.empty() )
+            throw snmp_bad_result( string( "Cannot find rows matching the given names from " ) + getDaemonName() );
+
+        for( vector<bool>::size_type p = 0; p < matched.size(); ++p )
+        {
+            if( !matched[p] )
+                mUnmatchedPatterns.push_back( p );
+        }
+
+        if( mFetchSysUpTime )
+            mSysUpTime = scalars.front();
+    }
+
+    /**
+     * fetches the data of the row at rowIndex along with the names of this row
+     *
+     * @param mibData - the specification which data to fetch
+     * @param nameSearchOids - the columns containing the names
+     * @param rowIndex - index of the row remembered by a previous run
+     *
+     * @return true when the row still contains mName, false otherwise
+     */
+    bool fetchDataVerifyingRow( SupportedMibDataTable &mibData, vector<Oid> const &nameSearchOids, long rowIndex )
+    {
+        vector<Vb> nameVbs;
+        for( vector<Oid>::const_iterator ci = nameSearchOids.begin(); ci != nameSearchOids.end(); ++ci )
+        {
+            Oid nameOid = *ci;
+            nameOid += rowIndex;
+            nameVbs.push_back( Vb( nameOid ) );
+        }
+
+        mibData.setFoundRowIndex( rowIndex );
+        try
+        {
+            FetchStaticObjects::fetchData( mibData, &nameVbs );
+        }
+        catch( snmp_error & )
+        {
+            return false;
+        }
+
+        for( vector<Vb>::const_iterator ci = nameVbs.begin(); ci != nameVbs.end(); ++ci )
+        {
+            if( ( ci->get_syntax() != sNMP_SYNTAX_NOSUCHINSTANCE ) &&
+                ( ci->get_syntax() != sNMP_SYNTAX_NOSUCHOBJECT ) &&
+                ( mName == ci->get_printable_value() ) )
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
 };
 
 /**
@@ -250,6 +612,7 @@ public:
         : Fetch()
         , Check()
         , mReported(false)
+        , mIdentifiedFromCache(false)
         , mSupportedSnmpDaemons()
         , mIdentifiedSnmpDaemon( mSupportedSnmpDaemons.end() )
         , mSupportedMibData(0)
@@ -295,6 +658,7 @@ public:
         generalopts.add_options()
             ("alarm-timeout,a", value<unsigned>()->default_value(45), "sets alarm timeout in seconds")
             ("show-performance-data", value<bool>()->default_value(ShowPerformanceData), "enable or disable output of nagios performance data")
+            ("identification-ttl", value<unsigned>()->default_value(86400), "seconds to reuse the snmpd type identified by previous runs (0 to disable)")
             ;
     }
 
@@ -334,11 +698,13 @@ public:
     {
         options_description checkopts("Check options");
         add_check_options( checkopts );
+        options_description multihostopts("Multi host options");
+        MultiHostCheck::add_multi_host_options( multihostopts );
 
         // Declare an options description instance which will include
         // all the options
         options_description all = Fetch::get_options();
-        all.add(checkopts);
+        all.add(checkopts).add(multihostopts);
 
         return all;
     }
@@ -376,6 +742,12 @@ public:
 
     /**
      * configures application
+     *
+     * The alarm timeout isn't installed in a hosted environment - signals
+     * are process wide and the hosting process might run several
+     * applications concurrently. The requests give up a second before
+     * the alarm timeout in any case, so unreachable hosts are reported
+     * by the check itself and don't hold the hosting process.
      */
     void configure()
     {
@@ -386,8 +758,14 @@ public:
 
         if( ( vm.count("alarm-timeout") != 0 ) && ( 0 != vm["alarm-timeout"].as<unsigned>() ) )
         {
-            signal( SIGALRM, alarm_handler );
-            alarm( vm["alarm-timeout"].as<unsigned>() );
+            unsigned alarmTimeout = vm["alarm-timeout"].as<unsigned>();
+            this->mSnmpComm.set_deadline( ( alarmTimeout > 1 ) ? alarmTimeout - 1 : alarmTimeout );
+
+            if( !this->isHosted() )
+            {
+                signal( SIGALRM, alarm_handler );
+                alarm( alarmTimeout );
+            }
         }
     }
 
@@ -398,23 +776,24 @@ public:
         if( !mReported )
         {
             variables_map const &vm = this->mCmndlineValuesMap;
-            if( ( vm.count("alarm-timeout") != 0 ) && ( 0 != vm["alarm-timeout"].as<unsigned>() ) )
+            if( !this->isHosted() && ( vm.count("alarm-timeout") != 0 ) && ( 0 != vm["alarm-timeout"].as<unsigned>() ) )
             {
                 alarm( 0 );
             }
 
-            cout << getCheckName() << " " << (((int)(lengthof(states))) > rc ? states[rc] : "UNKNOWN");
+            ostream &os = this->getOutputStream();
+            os << getCheckName() << " " << (((int)(lengthof(states))) > rc ? states[rc] : "UNKNOWN");
             if( msg.empty() )
             {
                 if( !getResultMessage().empty() )
-                    cout << " - " << getResultMessage();
+                    os << " - " << getResultMessage();
                 if( vm["show-performance-data"].as<bool>() && !getPerformanceMessage().empty() )
-                    cout << "|" << getPerformanceMessage();
-                cout << endl;
+                    os << "|" << getPerformanceMessage();
+                os << endl;
             }
             else
             {
-                cout << " - " << msg << endl;
+                os << " - " << msg << endl;
             }
 
             mReported = true;
@@ -427,18 +806,50 @@ public:
 
     virtual void fetchData()
     {
-        LOG_BEGIN( loggerModuleName, EVENT_LOG | 1 );
+        SSNC_LOG_BEGIN( loggerModuleName, EVENT_LOG | 1 );
         LOG( "fetching data" );
         LOG_END;
 
         if( NULL == mSupportedMibData )
             throw( runtime_error( "out of order execution of SnmpCheckAppl::fetchData()" ) );
+
+        if( mIdentifiedFromCache )
+        {
+            // verify the remembered identification with the data request - no extra round trip
+            bool stale = false;
+            try
+            {
+                fetchData(*mSupportedMibData);
+
+                unsigned long sysUpTime;
+                stale = ( SNMP_CLASS_SUCCESS != this->getSysUpTime().get_value( sysUpTime ) ) ||
+                        this->mSnmpComm.agent_restarted( sysUpTime );
+            }
+            catch( snmp_error & )
+            {
+                stale = true;
+            }
+
+            if( !stale )
+                return;
+
+            SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 5 );
+            LOG( "remembered snmpd type is stale - identifying again" );
+            LOG_END;
+
+            this->mSnmpComm.forget_daemon_name();
+            this->setFetchSysUpTime( false );
+            mIdentifiedFromCache = false;
+            mSupportedMibData = NULL;
+            identifyDaemon();
+        }
+
         fetchData(*mSupportedMibData);
     }
 
     virtual void convert()
     {
-        LOG_BEGIN( loggerModuleName, EVENT_LOG | 1 );
+        SSNC_LOG_BEGIN( loggerModuleName, EVENT_LOG | 1 );
         LOG( "normalizing and converting fetched data" );
         LOG_END;
 
@@ -501,51 +912,50 @@ public:
 
         if( ( 0 == vm.count("snmpd-type") ) || vm["snmpd-type"].defaulted() )
         {
-            if( this->mSnmpComm.can_combine_requests() )
+            unsigned ttl = ( canRememberDaemon() && vm.count("identification-ttl") ) ? vm["identification-ttl"].as<unsigned>() : 0;
+            if( ( 0 != ttl ) && identifyRememberedDaemon( ttl ) )
+                return;
+
+            vector<Vb> daemonIdentifyVarBinds;
+            for( mIdentifiedSnmpDaemon = supportedSnmpDaemons.begin();
+                 mIdentifiedSnmpDaemon != supportedSnmpDaemons.end();
+                 ++mIdentifiedSnmpDaemon )
             {
-                vector<Vb> daemonIdentifyVarBinds;
-                for( mIdentifiedSnmpDaemon = supportedSnmpDaemons.begin();
-                     mIdentifiedSnmpDaemon != supportedSnmpDaemons.end();
-                     ++mIdentifiedSnmpDaemon )
-                {
-                    /*
-                    if( verifyDaemon( *mIdentifiedSnmpDaemon ) )
-                        break;
-                    */
-                    daemonIdentifyVarBinds.push_back( mIdentifiedSnmpDaemon->getProveOid() );
-                }
+                /*
+                if( verifyDaemon( *mIdentifiedSnmpDaemon ) )
+                    break;
+                */
+                daemonIdentifyVarBinds.push_back( mIdentifiedSnmpDaemon->getProveOid() );
+            }
+            daemonIdentifyVarBinds.push_back( Vb( Oid( SYS_UPTIME ".0" ) ) );
+
+            int rc = this->mSnmpComm.get( daemonIdentifyVarBinds );
+            if( SNMP_CLASS_SUCCESS == rc )
+            {
+                typename vector<Vb>::iterator vblistIterator;
 
-                int rc = this->mSnmpComm.get( daemonIdentifyVarBinds );
-                if( SNMP_CLASS_SUCCESS == rc )
+                for( mIdentifiedSnmpDaemon = supportedSnmpDaemons.begin(), vblistIterator = daemonIdentifyVarBinds.begin();
+                     ( mIdentifiedSnmpDaemon != supportedSnmpDaemons.end() ) && ( vblistIterator != daemonIdentifyVarBinds.end() );
+                     ++mIdentifiedSnmpDaemon, ++vblistIterator )
                 {
-                    typename vector<Vb>::iterator vblistIterator;
+                    if( ( vblistIterator->get_syntax() == sNMP_SYNTAX_NOSUCHINSTANCE ) ||
+                        ( vblistIterator->get_syntax() == sNMP_SYNTAX_NOSUCHOBJECT ) )
+                    {
+                        continue;
+                    }
 
-                    for( mIdentifiedSnmpDaemon = supportedSnmpDaemons.begin(), vblistIterator = daemonIdentifyVarBinds.begin();
-                         ( mIdentifiedSnmpDaemon != supportedSnmpDaemons.end() ) && ( vblistIterator != daemonIdentifyVarBinds.end() );
-                         ++mIdentifiedSnmpDaemon, ++vblistIterator )
+                    string s = vblistIterator->get_printable_value();
+                    if( 0 == s.find( mIdentifiedSnmpDaemon->getProveValue() ) ) // must start with ...
                     {
-                        if( ( vblistIterator->get_syntax() == sNMP_SYNTAX_NOSUCHINSTANCE ) ||
-                            ( vblistIterator->get_syntax() == sNMP_SYNTAX_NOSUCHOBJECT ) )
-                        {
-                            continue;
-                        }
-
-                        string s = vblistIterator->get_printable_value();
-                        if( 0 == s.find( mIdentifiedSnmpDaemon->getProveValue() ) ) // must start with ...
-                        {
-                            break;
-                        }
+                        break;
                     }
                 }
-            }
-            else
-            {
-                for( mIdentifiedSnmpDaemon = supportedSnmpDaemons.begin();
-                     mIdentifiedSnmpDaemon != supportedSnmpDaemons.end();
-                     ++mIdentifiedSnmpDaemon )
+
+                unsigned long sysUpTime;
+                if( ( 0 != ttl ) && ( mIdentifiedSnmpDaemon != supportedSnmpDaemons.end() ) &&
+                    ( SNMP_CLASS_SUCCESS == daemonIdentifyVarBinds.back().get_value( sysUpTime ) ) )
                 {
-                    if( verifyDaemon( *mIdentifiedSnmpDaemon ) )
-                        break;
+                    this->mSnmpComm.remember_daemon_name( mIdentifiedSnmpDaemon->getName(), sysUpTime );
                 }
             }
         }
@@ -563,7 +973,7 @@ public:
 
         if( mIdentifiedSnmpDaemon != supportedSnmpDaemons.end() )
         {
-            LOG_BEGIN( loggerModuleName, DEBUG_LOG | 5 );
+            SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 5 );
             LOG( string( string("Using SNMP daemon type ") + mIdentifiedSnmpDaemon->getName() ).c_str() );
             LOG_END;
 
@@ -574,6 +984,53 @@ public:
             throw unknown_daemon();
     }
 
+    /**
+     * @return true when the snmpd type may be taken from previous runs
+     */
+    virtual bool canRememberDaemon() const { return true; }
+
+    /**
+     * takes the snmpd type identified by a previous run
+     *
+     * The identification is verified by the sysUpTime.0 fetched along
+     * with the data to check in fetchData().
+     *
+     * @param ttl - maximum age of the identification in seconds
+     *
+     * @return true when a remembered identification could be used, false otherwise
+     */
+    bool identifyRememberedDaemon( unsigned ttl )
+    {
+        string name = this->mSnmpComm.get_cached_daemon_name( ttl );
+        if( name.empty() )
+            return false;
+
+        vector<SnmpDaemonIdentifier> &supportedSnmpDaemons = getSupportedSnmpDaemons();
+        for( mIdentifiedSnmpDaemon = supportedSnmpDaemons.begin();
+             mIdentifiedSnmpDaemon != supportedSnmpDaemons.end();
+             ++mIdentifiedSnmpDaemon )
+        {
+            if( mIdentifiedSnmpDaemon->getName() == name )
+                break;
+        }
+
+        if( ( mIdentifiedSnmpDaemon == supportedSnmpDaemons.end() ) ||
+            ( NULL == ( mSupportedMibData = getMibData( *mIdentifiedSnmpDaemon ) ) ) )
+        {
+            mIdentifiedSnmpDaemon = supportedSnmpDaemons.end();
+            return false;
+        }
+
+        SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 5 );
+        LOG( string( string("Using remembered SNMP daemon type ") + name ).c_str() );
+        LOG_END;
+
+        mIdentifiedFromCache = true;
+        this->setFetchSysUpTime( true );
+
+        return true;
+    }
+
     virtual string const & getDaemonName() const
     {
         if( mIdentifiedSnmpDaemon != mSupportedSnmpDaemons.end() )
@@ -587,7 +1044,7 @@ public:
 
     void createMessages()
     {
-        LOG_BEGIN( loggerModuleName, EVENT_LOG | 1 );
+        SSNC_LOG_BEGIN( loggerModuleName, EVENT_LOG | 1 );
         LOG( "creating result messages" );
         LOG_END;
 
@@ -612,7 +1069,7 @@ public:
     template < class Cmp >
     int prove( Cmp const &cmp = Cmp() ) const
     {
-        LOG_BEGIN( loggerModuleName, EVENT_LOG | 1 );
+        SSNC_LOG_BEGIN( loggerModuleName, EVENT_LOG | 1 );
         LOG( "proving values" );
         LOG_END;
 
@@ -625,6 +1082,10 @@ protected:
      * already reported?
      */
     bool mReported;
+    /**
+     * snmpd type was taken from a previous run and is not yet verified
+     */
+    bool mIdentifiedFromCache;
     /**
      * supported snmp daemons
      */
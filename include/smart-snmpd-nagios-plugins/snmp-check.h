@@ -76,9 +76,25 @@ public:
     template < class Cmp >
     int prove( T const &val, Cmp const &cmp = Cmp() ) const
     {
-        if( cmp( val, mCrit ) )
+        return prove( val, mWarn, mCrit, cmp );
+    }
+
+    /**
+     * prove values got from snmpd against the given thresholds
+     *
+     * @param val - the value from snmpd
+     * @param warn - warn threshold
+     * @param crit - crit threshold
+     * @param cmp - comparator returning true when val exceeds a threshold
+     *
+     * @return nagios status code
+     */
+    template < class Cmp >
+    static int prove( T const &val, T const &warn, T const &crit, Cmp const &cmp )
+    {
+        if( cmp( val, crit ) )
             return STATE_CRITICAL;
-        if( cmp( val, mWarn  ) )
+        if( cmp( val, warn ) )
             return STATE_WARNING;
 
         return STATE_OK;
@@ -109,6 +125,46 @@ public:
     }
 };
 
+/**
+ * warn/crit check which takes its thresholds from the options
+ * NAME-warn and NAME-crit, so that several of them can be
+ * combined into one check application
+ */
+template < class T >
+class SnmpNamedWarnCritCheck
+    : public SnmpWarnCritCheck<T>
+{
+public:
+    explicit SnmpNamedWarnCritCheck( string const &name )
+        : SnmpWarnCritCheck<T>()
+        , mName( name )
+    {}
+
+    virtual ~SnmpNamedWarnCritCheck() {}
+
+    void add_check_options(options_description &checkopts) const
+    {
+        checkopts.add_options()
+            ( ( mName + "-warn" ).c_str(), value<T>(), ( mName + " warn threshold" ).c_str() )
+            ( ( mName + "-crit" ).c_str(), value<T>(), ( mName + " crit threshold" ).c_str() )
+            ;
+    }
+
+    void configure(variables_map const &vm)
+    {
+        string warn = mName + "-warn", crit = mName + "-crit";
+        if( ( vm.count(warn) != 0 ) && !vm[warn].defaulted() )
+            this->mWarn = vm[warn].as<T>();
+        if( ( vm.count(crit) != 0 ) && !vm[crit].defaulted() )
+            this->mCrit = vm[crit].as<T>();
+    }
+
+    string const & getName() const { return mName; }
+
+protected:
+    string mName;
+};
+
 class SnmpBoolCritCheck
 {
 public:
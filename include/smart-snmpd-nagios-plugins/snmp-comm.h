@@ -20,6 +20,12 @@
 #include <smart-snmpd-nagios-plugins/snmp-pp-std.h>
 #include <smart-snmpd-nagios-plugins/snmp-comm-types.h>
 #include <smart-snmpd-nagios-plugins/program-options.h>
+#include <smart-snmpd-nagios-plugins/snmp-session-pool.h>
+#include <smart-snmpd-nagios-plugins/host-state-store.h>
+#include <smart-snmpd-nagios-plugins/vb-cache.h>
+#include <smart-snmpd-nagios-plugins/table-snapshot.h>
+#include <smart-snmpd-nagios-plugins/snmp-tcp-transport.h>
+#include <smart-snmpd-nagios-plugins/smart-snmpd-nagios-plugins.h>
 
 #include <boost/lexical_cast.hpp>
 
@@ -28,6 +34,8 @@ using namespace boost;
 #include <string>
 #include <iostream>
 #include <iomanip>
+#include <sys/file.h>
+#include <sys/time.h>
 
 using namespace std;
 
@@ -37,9 +45,227 @@ using namespace std;
  */
 static const int BulkMax = 16;
 
+/**
+ * largest udp payload fitting into an ethernet frame without fragmentation
+ */
+static const int DefaultMaxMsgSize = 1472;
+
+/**
+ * estimated size of a request/response message without the varbinds
+ */
+static const int PduOverheadEstimate = 96;
+
+/**
+ * estimated size of a varbind in a response without its oid
+ */
+static const int VbValueEstimate = 32;
+
 #undef loggerModuleName
 #define loggerModuleName "nagiosplugins.snmpcomm"
 
+/**
+ * controls the max-repetitions of get-bulk requests
+ *
+ * The repetitions are increased as long as the responses of the agent
+ * are complete (the agent returned as many rows as requested) and a
+ * response with more rows would still fit into the maximum message
+ * size. They're decreased when the agent answers tooBig, when a request
+ * timed out or when the rows got larger.
+ */
+class BulkRepetitionController
+{
+public:
+    /**
+     * upper limit of max-repetitions
+     */
+    static const int MaxRepetitions = 1024;
+
+    /**
+     * constructor
+     *
+     * @param repetitions - initial max-repetitions
+     * @param maxMsgSize - maximum size of a response message in bytes
+     */
+    BulkRepetitionController( int repetitions = BulkMax, int maxMsgSize = DefaultMaxMsgSize )
+        : mRepetitions( repetitions )
+        , mMaxMsgSize( maxMsgSize )
+        , mRoundTrips( 0 )
+    {}
+
+    /**
+     * @return max-repetitions to use for the next request
+     */
+    inline int getRepetitions() const { return mRepetitions; }
+
+    /**
+     * @return number of get-bulk requests sent so far
+     */
+    inline unsigned getRoundTrips() const { return mRoundTrips; }
+
+    /**
+     * sets the max-repetitions, e.g. from the host state of previous runs
+     */
+    void setRepetitions( int repetitions )
+    {
+        mRepetitions = ( repetitions < 1 ) ? 1 : ( repetitions > MaxRepetitions ) ? MaxRepetitions : repetitions;
+    }
+
+    /**
+     * sets maximum size of a response message
+     */
+    void setMaxMsgSize( int maxMsgSize ) { mMaxMsgSize = maxMsgSize; }
+
+    /**
+     * adapts the max-repetitions after a successful response
+     *
+     * @param columns - number of varbinds per row (non-repeaters excluded)
+     * @param vbCount - number of varbinds received
+     * @param msgLength - encoded length of the response
+     */
+    void responded( int columns, int vbCount, int msgLength )
+    {
+        ++mRoundTrips;
+
+        if( ( columns <= 0 ) || ( vbCount <= 0 ) || ( msgLength <= 0 ) )
+            return;
+
+        int rows = vbCount / columns;
+        if( 0 == rows )
+            return;
+
+        int bytesPerRow = msgLength / rows;
+        if( bytesPerRow < 1 )
+            bytesPerRow = 1;
+        int fitting = mMaxMsgSize / bytesPerRow;
+
+        if( fitting < mRepetitions )
+            setRepetitions( fitting ); // rows got larger - stay below the limit
+        else if( rows >= mRepetitions )
+            setRepetitions( ( 2 * mRepetitions < fitting ) ? 2 * mRepetitions : fitting );
+        // else: the agent limits the response itself - growing is useless
+    }
+
+    /**
+     * halves the max-repetitions after a failed request (tooBig or timeout)
+     *
+     * @return true when the request shall be retried with less repetitions
+     */
+    bool failed()
+    {
+        ++mRoundTrips;
+
+        if( mRepetitions <= 1 )
+            return false;
+
+        setRepetitions( mRepetitions / 2 );
+        return true;
+    }
+
+protected:
+    int mRepetitions;
+    int mMaxMsgSize;
+    unsigned mRoundTrips;
+};
+
+/**
+ * estimates the round trip time to a host and derives the retransmit timeout
+ *
+ * Follows RFC 6298: the smoothed round trip time and its variance are
+ * updated by each response received without a retransmission, the
+ * timeout is SRTT + 4 * RTTVAR bounded by MinTimeout and the maximum
+ * given (--timeout). Until the first sample the maximum is used.
+ */
+class RttEstimator
+{
+public:
+    /**
+     * lower limit of the retransmit timeout in microseconds
+     */
+    static const long MinTimeout = 100000;
+
+    RttEstimator( long maxTimeout = 5000000 )
+        : mSmoothedRtt( 0 )
+        , mRttVariance( 0 )
+        , mMaxTimeout( maxTimeout )
+        , mSampled( false )
+    {}
+
+    /**
+     * @param smoothedRtt - SRTT remembered by a previous run in microseconds, 0 when unknown
+     * @param rttVariance - RTTVAR remembered by a previous run in microseconds
+     */
+    void setState( long smoothedRtt, long rttVariance )
+    {
+        mSmoothedRtt = smoothedRtt;
+        mRttVariance = rttVariance;
+    }
+
+    inline long getSmoothedRtt() const { return mSmoothedRtt; }
+    inline long getRttVariance() const { return mRttVariance; }
+
+    /**
+     * @return true when samples were taken since setState()
+     */
+    inline bool sampled() const { return mSampled; }
+
+    void setMaxTimeout( long maxTimeout ) { mMaxTimeout = maxTimeout; }
+    inline long getMaxTimeout() const { return mMaxTimeout; }
+
+    /**
+     * @return retransmit timeout for the first try of a request in microseconds
+     */
+    long getTimeout() const
+    {
+        if( 0 == mSmoothedRtt )
+            return mMaxTimeout;
+
+        long timeout = mSmoothedRtt + 4 * mRttVariance;
+        if( timeout < MinTimeout )
+            timeout = MinTimeout;
+
+        return ( timeout > mMaxTimeout ) ? mMaxTimeout : timeout;
+    }
+
+    /**
+     * @return timeout for the retry following a try timed out after timeout
+     */
+    long backoff( long timeout ) const
+    {
+        return ( 2 * timeout > mMaxTimeout ) ? mMaxTimeout : 2 * timeout;
+    }
+
+    /**
+     * updates the estimation by a response to a request sent once
+     *
+     * @param rtt - measured round trip time in microseconds
+     */
+    void sample( long rtt )
+    {
+        if( rtt < 1 )
+            rtt = 1;
+
+        if( 0 == mSmoothedRtt )
+        {
+            mSmoothedRtt = rtt;
+            mRttVariance = rtt / 2;
+        }
+        else
+        {
+            long delta = ( mSmoothedRtt > rtt ) ? mSmoothedRtt - rtt : rtt - mSmoothedRtt;
+            mRttVariance = ( 3 * mRttVariance + delta ) / 4;
+            mSmoothedRtt = ( 7 * mSmoothedRtt + rtt ) / 8;
+        }
+
+        mSampled = true;
+    }
+
+protected:
+    long mSmoothedRtt;
+    long mRttVariance;
+    long mMaxTimeout;
+    bool mSampled;
+};
+
 /**
  * overloaded parser helper for snmp_version command line specification
  */
@@ -138,6 +364,52 @@ public:
     virtual ~snmp_bad_result() throw() {}
 };
 
+/**
+ * view of one row of a table walk - the varbinds remain in the response pdu
+ *
+ * Offers the read interface of vector<Vb>, so row functors can be written
+ * once for walked rows and rows replayed from snapshots:
+ * template < class Row > bool operator () ( Row const &row ). A row is
+ * only valid while it's passed - functors copy what they keep.
+ */
+class SnmpTableRow
+{
+public:
+    typedef vector<Vb>::size_type size_type;
+
+    SnmpTableRow()
+        : mPdu( 0 )
+        , mFirst( 0 )
+        , mColumns( 0 )
+    {}
+
+    SnmpTableRow( Pdu const &pdu, int first, size_type columns )
+        : mPdu( &pdu )
+        , mFirst( first )
+        , mColumns( columns )
+    {}
+
+    size_type size() const { return mColumns; }
+    bool empty() const { return 0 == mColumns; }
+
+    Vb const & operator [] ( size_type i ) const { return mPdu->get_vb( mFirst + i ); }
+
+    /**
+     * copies the varbinds of the row
+     */
+    void copy_to( vector<Vb> &vbs ) const
+    {
+        vbs.resize( mColumns );
+        for( size_type i = 0; i < mColumns; ++i )
+            vbs[i] = (*this)[i];
+    }
+
+protected:
+    Pdu const *mPdu;
+    int mFirst;
+    size_type mColumns;
+};
+
 class GetBulkFetchHelper
 {
 public:
@@ -161,12 +433,47 @@ public:
     }
 protected:
     Oid const mStart;
-    vector<Vb> mResultBuf;
+    vector<Vb> &mResultBuf;
 
 private:
     GetBulkFetchHelper();
 };
 
+/**
+ * stores the varbinds of a walked subtree in a VbCache
+ */
+class GetBulkCacheSubtreeHelper
+{
+public:
+    GetBulkCacheSubtreeHelper( Oid const &subtree, VbCache &cache )
+        : mSubtree( subtree )
+        , mCache( cache )
+        , mCount( 0 )
+    {}
+
+    ~GetBulkCacheSubtreeHelper() {}
+
+    bool operator () (Vb const &varBind)
+    {
+        Oid idxOid;
+        varBind.get_oid( idxOid );
+        if( mSubtree.nCompare( mSubtree.len(), idxOid ) != 0 )
+            return true; // left the subtree
+
+        mCache.store( varBind );
+
+        return ++mCount >= VbCache::MaxPrefetchValues;
+    }
+
+protected:
+    Oid const mSubtree;
+    VbCache &mCache;
+    unsigned long mCount;
+
+private:
+    GetBulkCacheSubtreeHelper();
+};
+
 class GetBulkFetchTableHelper
 {
 public:
@@ -176,25 +483,133 @@ public:
 
     ~GetBulkFetchTableHelper() {}
 
-    bool operator () (vector<Vb> const &varBind)
+    template < class Row >
+    bool operator () (Row const &row)
     {
-        mResultBuf.push_back( varBind );
+        mResultBuf.push_back( vector<Vb>() );
+        for( typename Row::size_type i = 0; i < row.size(); ++i )
+            mResultBuf.back().push_back( row[i] );
 
         return false;
     }
 
 protected:
-    vector< vector<Vb> > mResultBuf;
+    vector< vector<Vb> > &mResultBuf;
 
 private:
     GetBulkFetchTableHelper();
 };
 
+class SnmpComm;
+
+template < class F >
+int get_table_parallel( SnmpComm &comm, vector<Oid> const &start, F &f, unsigned concurrency );
+
+/**
+ * passes the rows of a table walk to a functor and appends them to a snapshot
+ */
+template < class F >
+class SnapshotWritingRows
+{
+public:
+    SnapshotWritingRows( TableSnapshot::Writer &snapshot, F &f )
+        : mSnapshot( snapshot )
+        , mF( f )
+        , mStopped( false )
+    {}
+
+    template < class Row >
+    bool operator () (Row const &row)
+    {
+        mSnapshot.add( row );
+        return mStopped = mF( row );
+    }
+
+    /**
+     * @return true when the functor stopped the walk
+     */
+    bool stopped() const { return mStopped; }
+
+protected:
+    TableSnapshot::Writer &mSnapshot;
+    F &mF;
+    bool mStopped;
+
+private:
+    SnapshotWritingRows();
+};
+
+/**
+ * cursor walking the columns of a table row by row using get-bulk requests
+ *
+ * Only the response to the last request is held, next() requests further
+ * rows when its rows are consumed - the memory needed doesn't depend on
+ * the size of the table. The walk can be left at any row.
+ */
+class SnmpTableCursor
+{
+public:
+    /**
+     * @param comm - the communication to send the requests with
+     * @param columns - the column oids to walk, must live as long as the cursor
+     * @param max_reps - max-repetitions, 0 to adapt them automatically
+     * @param scalars - scalars to fetch as non-repeaters of the first request, receive the values
+     */
+    SnmpTableCursor( SnmpComm &comm, vector<Oid> const &columns, int max_reps = 0, vector<Vb> *scalars = 0 );
+
+    ~SnmpTableCursor() { finish(); }
+
+    /**
+     * advances to the next row
+     *
+     * @return true when positioned at a row, false at the end of the table or on errors (see getStatus())
+     */
+    bool next();
+
+    /**
+     * @return the current row, valid until next() is called
+     */
+    SnmpTableRow const & row() const { return mRow; }
+
+    /**
+     * @return value from Snmp::get_bulk of the last request
+     */
+    int getStatus() const { return mStatus; }
+
+    /**
+     * ends the walk - next() returns false afterwards
+     */
+    void finish();
+
+protected:
+    SnmpComm &mComm;
+    vector<Oid> const &mColumns;
+    int mMaxReps;
+    vector<Vb> *mScalars;
+    Pdu mPdu;
+    int mReceived;
+    int mNext;
+    SnmpTableRow mRow;
+    int mStatus;
+    bool mStarted;
+    bool mFinished;
+    unsigned mRoundTrips;
+
+    bool request();
+    void receive_scalars( int nonReps );
+
+private:
+    SnmpTableCursor( SnmpTableCursor const & );
+    SnmpTableCursor & operator = ( SnmpTableCursor const & );
+};
+
 /**
  * snmp communication helper class
  */
 class SnmpComm
 {
+    friend class SnmpTableCursor;
+
 public:
     /**
      * default constructor
@@ -203,16 +618,137 @@ public:
         : mSnmp(0)
         , mTarget(0)
         , mPdu()
-    {}
+        , mSessionPool(0)
+        , mSessionKey()
+        , mCacheDir()
+        , mHostStateStore(0)
+        , mHostState()
+        , mBulkControl()
+        , mGetMaxMsgSize( DefaultMaxMsgSize )
+        , mUsmKeyStore(0)
+        , mUsmKeys()
+        , mUsmKeyState( UsmKeysNone )
+        , mUsmSecurityName()
+        , mVbCache()
+        , mRowIndexStore(0)
+        , mParallelWalk(0)
+        , mIpv6(false)
+        , mTcpTransport(0)
+        , mRtt()
+        , mRetries(0)
+        , mDeadline(0)
+    {
+        memset( &mHostState, 0, sizeof(mHostState) );
+        memset( &mUsmKeys, 0, sizeof(mUsmKeys) );
+    }
 
     /**
      * destructor - releases mSnmp and mTarget members, if allocated
+     *
+     * When a session pool is used, mSnmp and mTarget are given back to
+     * the pool instead of being destroyed.
      */
     virtual ~SnmpComm()
     {
+        save_rtt_state();
+
+        if( mSessionPool && mSnmp && mTarget )
+        {
+            mSessionPool->release( mSessionKey, mSnmp, mTarget );
+            mSnmp = 0;
+            mTarget = 0;
+        }
+
         delete mSnmp; mSnmp = 0;
         delete mTarget; mTarget = 0;
+        delete mTcpTransport; mTcpTransport = 0;
+    }
+
+    /**
+     * sets the pool to borrow snmp sessions from
+     *
+     * Must be called before configure(). The pool isn't owned by the
+     * SnmpComm instance and must live longer than it.
+     *
+     * @param sessionPool - pool of reusable sessions, NULL to disable pooling
+     */
+    void set_session_pool( SnmpSessionPool *sessionPool )
+    {
+        mSessionPool = sessionPool;
+    }
+
+#ifdef _SNMPv3
+    /**
+     * initializes the process wide v3MP instance
+     *
+     * SNMP++ allows only one v3MP instance per process, so it's created
+     * once and reused for each subsequent configure(). Processes running
+     * several threads must call this once before the threads are started.
+     *
+     * @param cacheDir - directory containing the persisted engine boots counter
+     *
+     * @return the v3MP instance
+     */
+    static v3MP * init_v3mp( string const &cacheDir = SSNC_DEFAULT_CACHE_DIR )
+    {
+        static v3MP *v3_MP = 0;
+
+        if( 0 == v3_MP )
+        {
+            const char *engineId = "smart-snmpd-nagios-plugins";
+            unsigned int snmpEngineBoots = next_engine_boots( cacheDir, engineId );
+            int status;
+
+            v3_MP = new v3MP(engineId, snmpEngineBoots, status);
+            if (status != SNMPv3_MP_OK)
+            {
+                delete v3_MP; v3_MP = 0;
+                throw runtime_error( string("Error initializing v3MP: ") + to_string(status) );
+            }
+        }
+
+        return v3_MP;
+    }
+
+    /**
+     * increments the persisted engine boots counter of the plugins
+     *
+     * @param cacheDir - directory containing the counter file, empty to disable
+     * @param engineId - local engine id
+     *
+     * @return the new engine boots value
+     */
+    static unsigned int next_engine_boots( string const &cacheDir, OctetStr const &engineId )
+    {
+        unsigned int boots = 0;
+
+        if( cacheDir.empty() )
+            return boots;
+
+        make_directories( cacheDir );
+        string fileName = cacheDir + "/snmpv3-boot-counter";
+
+        // saveBootCounter() rewrites the file - serialize concurrent plugins using a separate lock file
+        int lockFd = open( ( fileName + ".lock" ).c_str(), O_RDWR | O_CREAT, 0660 );
+        if( -1 != lockFd )
+            flock( lockFd, LOCK_EX );
+
+        getBootCounter( fileName.c_str(), engineId, boots ); // leaves boots untouched when there's no entry
+        ++boots;
+        if( SNMPv3_OK != saveBootCounter( fileName.c_str(), engineId, boots ) )
+        {
+            SSNC_LOG_BEGIN( loggerModuleName, WARNING_LOG | 1 );
+            LOG( "Can't save engine boots counter" );
+            LOG( fileName.c_str() );
+            LOG_END;
+        }
+
+        if( -1 != lockFd )
+            close( lockFd );
+
+        return boots;
     }
+#endif
 
     /**
      * helper function to extract a signed long integer from snmp vb object
@@ -299,7 +835,15 @@ public:
                 "timeout in seconds")
             ("retries,r", value<unsigned int>()->default_value(2),
                 "amount of retries")
+            ("cache-dir", value<string>()->default_value(SSNC_DEFAULT_CACHE_DIR),
+                "directory for data remembered per host between runs (empty to disable)")
+            ("parallel-walk", value<unsigned int>()->default_value(0),
+                "walk the columns of tables in up to N parallel streams (0 to walk them together)")
+            ("transport", value<string>()->default_value("udp"),
+                ( "transport to send the requests by: udp or tcp (RFC 3430, SNMPv1/v2c only; "
+                  "responses over tcp are limited to the " + to_string( TcpMaxMsgSize ) + " bytes SNMP++ was built for)" ).c_str())
             ;
+        VbCache::add_cache_options( snmpg );
 
         options_description snmpv1v2("SNMP V1/V2 options");
         snmpv1v2.add_options()
@@ -334,6 +878,15 @@ public:
      */
     void validate_options(variables_map const &vm) const
     {
+        if( vm.count("transport") )
+        {
+            string transport = vm["transport"].as<string>();
+            if( ( transport != "udp" ) && ( transport != "tcp" ) )
+                throw validation_error( validation_error::invalid_option_value, transport, "transport" );
+            if( ( transport == "tcp" ) && vm.count("snmp-version") && ( vm["snmp-version"].as<snmp_version>() > version2c ) )
+                throw option_error( "Option 'transport' with the value 'tcp' requires SNMPv1 or SNMPv2c" );
+        }
+
         if( vm.count("snmp-version") && ( vm["snmp-version"].as<snmp_version>() <= version2c ) )
         {
             if( vm.count("community") == 0 || vm["community"].defaulted() )
@@ -407,46 +960,137 @@ public:
     {
 #ifdef _SNMPv3
         //---------[ init SnmpV3 ]--------------------------------------------
-        v3MP *v3_MP;
-        if (vm["snmp-version"].as<snmp_version>() == version3)
-        {
-            const char *engineId = "smart-snmpd-nagios-plugins";
-            unsigned int snmpEngineBoots = 0;
-            int status;
+        // MUST create a v3MP object if _SNMPv3 is enabled - even for v1/v2c
+        init_v3mp( vm["cache-dir"].as<string>() );
+#endif
 
-            v3_MP = new v3MP(engineId, snmpEngineBoots, status);
-            if (status != SNMPv3_MP_OK)
-                throw runtime_error( string("Error initializing v3MP: ") + to_string(status) );
+        mParallelWalk = vm.count("parallel-walk") ? vm["parallel-walk"].as<unsigned int>() : 0;
+        mIpv6 = ( vm["host"].as<UdpAddress>().get_ip_version() == Address::version_ipv6 );
 
-            USM *usm = v3_MP->get_usm();
-            usm->add_usm_user( vm["security-name"].as<string>().c_str(),
-                               vm["auth-protocol"].as<SnmpV3AuthProtocol>(), vm["priv-protocol"].as<SnmpV3PrivProtocol>(),
-                               vm["auth-password"].as<string>().c_str(), vm["priv-password"].as<string>().c_str() );
-        }
-        else
+        if( mSessionPool )
         {
-            // MUST create a dummy v3MP object if _SNMPv3 is enabled!
-            int construct_status;
-            v3_MP = new v3MP("dummy", 0, construct_status);
+            mSessionKey = get_session_key( vm );
+            if( mSessionPool->acquire( mSessionKey, mSnmp, mTarget ) )
+            {
+                SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 5 );
+                LOG( "configure: reusing pooled session (host) (port) (security name)" );
+                LOG( vm["host"].as<UdpAddress>().get_printable() );
+                LOG( vm["port"].as<unsigned int>() );
+                LOG( get_session_principal( vm ).c_str() );
+                LOG_END;
+
+                mTarget->set_retry( vm["retries"].as<unsigned int>() );
+                mTarget->set_timeout( 100 * vm["timeout"].as<unsigned int>() );
+                configure_retries( vm );
+                configure_pdu( vm );
+                configure_transport( vm );
+                load_host_state( vm );
+
+                return;
+            }
         }
-#endif
 
         //----------[ create a SNMP++ session ]-----------------------------------
-        UdpAddress srv = vm["host"].as<UdpAddress>();
-        srv.set_port( vm["port"].as<unsigned int>() );
-
         int status = 0;
-        mSnmp = new Snmp( status, 0, (srv.get_ip_version() == Address::version_ipv6) );
+        mSnmp = new Snmp( status, 0, mIpv6 );
 
         if ( status != SNMP_CLASS_SUCCESS)
         {
             throw runtime_error( string("SNMP++ Session Create Fail, ") + mSnmp->error_msg(status) );
         }
 
+        configure_target( vm );
+        configure_transport( vm );
+        load_host_state( vm );
+    }
+
+    /**
+     * sets up the retransmissions of the requests
+     *
+     * Each try waits for the retransmit timeout estimated from the round
+     * trip times to the target (see RttEstimator), bounded by --timeout.
+     * Retries double the timeout of the previous try. --retries limits
+     * the number of retries, set_deadline() the time spent in total.
+     *
+     * @param vm - map of values specified on command line
+     */
+    void configure_retries(variables_map const &vm)
+    {
+        mRetries = vm["retries"].as<unsigned int>();
+        mRtt.setMaxTimeout( 1000000L * vm["timeout"].as<unsigned int>() );
+    }
+
+    /**
+     * limits the time spent sending requests
+     *
+     * Requests aren't sent anymore after the deadline - they fail with
+     * SNMP_CLASS_TIMEOUT - and the timeout of a try is shortened to end
+     * at the deadline.
+     *
+     * @param seconds - seconds from now to give up at, 0 for no deadline
+     */
+    void set_deadline( unsigned seconds )
+    {
+        mDeadline = seconds ? now_ms() + 1000LL * seconds : 0;
+    }
+
+    /**
+     * sets up the tcp transport when requested by --transport tcp
+     *
+     * The requests are sent over one tcp connection to the port of the
+     * agent instead of the snmp session then. Messages don't get
+     * fragmented, so get-bulk requests may ask for as many rows as
+     * SNMP++ can encode into one message.
+     *
+     * @param vm - map of values specified on command line
+     */
+    void configure_transport(variables_map const &vm)
+    {
+        delete mTcpTransport;
+        mTcpTransport = 0;
+
+        if( !vm.count("transport") || ( vm["transport"].as<string>() != "tcp" ) )
+            return;
+
+        UdpAddress srv = vm["host"].as<UdpAddress>();
+        IpAddress const &ip = srv;
+        mTcpTransport = new SnmpTcpTransport( ip.IpAddress::get_printable(), vm["port"].as<unsigned int>() );
+        mBulkControl.setMaxMsgSize( TcpMaxMsgSize );
+    }
+
+    /**
+     * configure target and pdu template upon specified command line parameters
+     *
+     * Unlike configure(), no snmp session is created. This allows sending
+     * the requests to the configured target via a session shared with
+     * other targets (see SnmpAsyncComm).
+     *
+     * @param vm - map of values specified on command line
+     */
+    void configure_target(variables_map const &vm)
+    {
+        UdpAddress srv = vm["host"].as<UdpAddress>();
+        srv.set_port( vm["port"].as<unsigned int>() );
+
+#ifdef _SNMPv3
+        v3MP *v3_MP = init_v3mp();
+        mUsmKeyState = UsmKeysNone;
+        if( ( vm["snmp-version"].as<snmp_version>() == version3 ) && !add_remembered_usm_user( vm, srv ) )
+        {
+            USM *usm = v3_MP->get_usm();
+            usm->add_usm_user( vm["security-name"].as<string>().c_str(),
+                               vm["auth-protocol"].as<SnmpV3AuthProtocol>(), vm["priv-protocol"].as<SnmpV3PrivProtocol>(),
+                               vm["auth-password"].as<string>().c_str(), vm["priv-password"].as<string>().c_str() );
+        }
+#endif
+
         //--------[ build up SNMP++ object needed ]-------------------------------
 
         int retries = vm["retries"].as<unsigned int>();
         int timeout = 100 * vm["timeout"].as<unsigned int>(); // in hundreds of seconds
+        configure_retries( vm );
+
+        delete mTarget;
 #ifdef _SNMPv3
         if (vm["snmp-version"].as<snmp_version>() == version3)
         {
@@ -457,9 +1101,8 @@ public:
 
             static_cast<UTarget *>(mTarget)->set_security_model(SNMP_SECURITY_MODEL_USM);
             static_cast<UTarget *>(mTarget)->set_security_name(vm["security-name"].as<string>().c_str());
-            mPdu.set_security_level(vm["security-level"].as<SnmpV3SecurityLevel>());
-            mPdu.set_context_name(vm["context-name"].as<string>().c_str());
-            mPdu.set_context_engine_id(""); // vm["context-engine-id"]
+            if( UsmKeysRemembered == mUsmKeyState )
+                static_cast<UTarget *>(mTarget)->set_engine_id( OctetStr( mUsmKeys.mEngineId, mUsmKeys.mEngineIdLength ) );
         }
         else
         {
@@ -472,16 +1115,158 @@ public:
 #ifdef _SNMPv3
         }
 #endif
+
+        configure_pdu( vm );
+    }
+
+    /**
+     * @return configured target, NULL before configure()/configure_target()
+     */
+    inline SnmpTarget * get_target() const { return mTarget; }
+
+    /**
+     * @return pdu template to start each request with
+     */
+    inline Pdu const & get_pdu() const { return mPdu; }
+
+    /**
+     * @return true when the target is addressed by ipv6
+     */
+    inline bool is_ipv6() const { return mIpv6; }
+
+    /**
+     * @return max-repetitions of get-bulk requests adapted to the target so far
+     */
+    inline int get_bulk_repetitions() const { return mBulkControl.getRepetitions(); }
+
+    /**
+     * @return the session the requests are sent by, NULL before configure()
+     */
+    inline Snmp * get_session() const { return mSnmp; }
+
+    /**
+     * @return timeout of a single try in microseconds as the round trip times measured so far suggest
+     */
+    inline long get_request_timeout() const { return mRtt.getTimeout(); }
+
+    /**
+     * @return time in milliseconds since the epoch to give up sending requests at, 0 for none
+     */
+    inline long long get_deadline() const { return mDeadline; }
+
+    /**
+     * @return milliseconds since the epoch
+     */
+    static long long now_ms()
+    {
+        struct timeval tv;
+        gettimeofday( &tv, NULL );
+        return tv.tv_sec * 1000LL + tv.tv_usec / 1000;
+    }
+
+    /**
+     * returns the name of the daemon identified by a previous run
+     *
+     * @param ttl - maximum age of the identification in seconds
+     *
+     * @return the daemon name or an empty string when unknown or expired
+     */
+    string get_cached_daemon_name( time_t ttl ) const
+    {
+        if( ( 0 == mHostState.mDaemonName[0] ) || ( time( NULL ) - mHostState.mIdentified > ttl ) )
+            return string();
+
+        return mHostState.mDaemonName;
+    }
+
+    /**
+     * remembers the identified daemon for following runs
+     *
+     * @param name - name of the identified daemon
+     * @param sysUpTime - sysUpTime.0 of the agent at identification
+     */
+    void remember_daemon_name( string const &name, unsigned long sysUpTime )
+    {
+        memset( mHostState.mDaemonName, 0, sizeof(mHostState.mDaemonName) );
+        strncpy( mHostState.mDaemonName, name.c_str(), sizeof(mHostState.mDaemonName) - 1 );
+        mHostState.mSysUpTime = sysUpTime;
+        mHostState.mIdentified = time( NULL );
+        save_host_state( mHostState.mDaemonName, mHostState.mIdentified );
+    }
+
+    /**
+     * drops the remembered daemon identification
+     */
+    void forget_daemon_name()
+    {
+        memset( mHostState.mDaemonName, 0, sizeof(mHostState.mDaemonName) );
+        mHostState.mIdentified = 0;
+        save_host_state( mHostState.mDaemonName, mHostState.mDaemonName );
+        save_host_state( mHostState.mIdentified, mHostState.mIdentified );
+    }
+
+    /**
+     * checks whether the agent was restarted since the last run
+     *
+     * @param sysUpTime - current sysUpTime.0 of the agent
+     *
+     * @return true when sysUpTime regressed, false otherwise
+     */
+    bool agent_restarted( unsigned long sysUpTime )
+    {
+        bool restarted = sysUpTime < mHostState.mSysUpTime;
+
+        mHostState.mSysUpTime = sysUpTime;
+        save_host_state( mHostState.mSysUpTime, mHostState.mSysUpTime );
+
+        return restarted;
+    }
+
+    /**
+     * returns the index of the row containing name found by a previous run
+     *
+     * @param columns - the searched columns
+     * @param name - the searched name
+     *
+     * @return the row index or -1 when unknown
+     */
+    long get_cached_row_index( vector<Oid> const &columns, string const &name ) const
+    {
+        RowIndexRecord rec;
+        if( !mRowIndexStore || !mRowIndexStore->load( make_row_index_key( columns, name ), rec ) )
+            return -1;
+
+        return static_cast<long>( rec.mRowIndex );
     }
 
-    inline bool can_combine_requests() const { return mTarget->get_version() > version1; }
+    /**
+     * remembers the index of the row containing name for following runs
+     *
+     * @param columns - the searched columns
+     * @param name - the searched name
+     * @param rowIndex - index of the row containing name, -1 to forget it
+     */
+    void remember_row_index( vector<Oid> const &columns, string const &name, long rowIndex )
+    {
+        if( !mRowIndexStore )
+            return;
+
+        RowIndexRecord rec;
+        memset( &rec, 0, sizeof(rec) );
+        rec.mKey = make_row_index_key( columns, name );
+        rec.mRowIndex = rowIndex;
+        mRowIndexStore->save( rec );
+    }
 
     int get( Vb &varBind )
     {
+        if( mVbCache.lookup( varBind ) || prefetch( varBind ) )
+            return SNMP_CLASS_SUCCESS;
+
         Pdu pdu( mPdu ); // start fresh
         pdu.set_vblist( &varBind, 1 );
 
-        LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
+        SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
         LOG( "get( oid )" );
         LOG( varBind.get_printable_oid() );
         LOG_END;
@@ -489,7 +1274,7 @@ public:
         int rc = get( pdu );
         if( SNMP_CLASS_SUCCESS != rc )
         {
-            LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
+            SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
             LOG( "get( oid ): rc, error_index" );
             LOG( rc );
             LOG( pdu.get_error_index() );
@@ -498,8 +1283,10 @@ public:
 
         if( !pdu.get_vb( varBind, 0 ) )
             throw snmp_bad_result( "Can't extract varBind after successful get request" );
+        if( SNMP_CLASS_SUCCESS == rc )
+            mVbCache.store( varBind );
 
-        LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
+        SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
         LOG( "get( oid ): " );
         LOG( string( string( varBind.get_printable_oid() ) + "=" + string( varBind.get_printable_value() ) ).c_str() );
         LOG_END;
@@ -507,12 +1294,25 @@ public:
         return rc;
     }
     
+    /**
+     * requests the given varbinds
+     *
+     * The varbinds are packed into as few requests as the learned maximum
+     * message size of the agent allows. Requests answered with tooBig are
+     * split and resent, for SNMPv1 varbinds rejected with noSuchName are
+     * marked as noSuchObject and the remaining ones are resent.
+     * Values of subtrees configured with --cache-ttl are taken from the
+     * cache shared with the other plugins when they're fresh enough. A
+     * value missing there makes the whole subtree walked and cached once
+     * (see prefetch()).
+     *
+     * @param vblist - the varbinds to request, receive the values
+     *
+     * @return value from Snmp::get of the last request sent
+     */
     int get( vector<Vb> &vblist )
     {
-        Pdu pdu( mPdu ); // start fresh
-        pdu.set_vblist( &vblist[0], vblist.size() );
-
-        LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
+        SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
         LOG( "get( vbs )" );
         for( vector<Vb>::iterator i = vblist.begin(); i != vblist.end(); ++i )
         {
@@ -520,24 +1320,46 @@ public:
         }
         LOG_END;
 
-        int rc = get( pdu );
-        if( SNMP_CLASS_SUCCESS != rc )
+        vector<vector<Vb>::size_type> uncached;
+        for( vector<Vb>::size_type i = 0; i < vblist.size(); ++i )
         {
-            LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
-            LOG( "get( list ): rc, error_index" );
-            LOG( rc );
-            LOG( pdu.get_error_index() );
-            LOG_END;
+            if( !mVbCache.lookup( vblist[i] ) && !prefetch( vblist[i] ) )
+                uncached.push_back( i );
         }
 
-        if( !pdu.get_vblist( &vblist[0], vblist.size() ) )
+        int rc = SNMP_CLASS_SUCCESS;
+        if( uncached.empty() )
         {
-            throw snmp_bad_result( "Can't extract varBinds after successful get request" );
+            SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 5 );
+            LOG( "get( vbs ): all values cached, no request sent" );
+            LOG_END;
+        }
+        else if( uncached.size() == vblist.size() )
+        {
+            rc = get_planned( vblist );
+        }
+        else if( !uncached.empty() )
+        {
+            vector<Vb> request;
+            for( vector<vector<Vb>::size_type>::iterator i = uncached.begin(); i != uncached.end(); ++i )
+                request.push_back( vblist[*i] );
+
+            if( SNMP_CLASS_SUCCESS == ( rc = get_planned( request ) ) )
+            {
+                for( vector<Vb>::size_type i = 0; i < uncached.size(); ++i )
+                    vblist[uncached[i]] = request[i];
+            }
         }
 
+        if( SNMP_CLASS_SUCCESS != rc )
+            return rc;
+
+        for( vector<vector<Vb>::size_type>::iterator i = uncached.begin(); i != uncached.end(); ++i )
+            mVbCache.store( vblist[*i] );
+
         for( vector<Vb>::iterator i = vblist.begin(); i != vblist.end(); ++i )
         {
-            LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
+            SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
             LOG( "received: " );
             LOG( string( string( i->get_printable_oid() ) + "=" + string( i->get_printable_value() ) ).c_str() );
             LOG_END;
@@ -546,12 +1368,42 @@ public:
         return rc;
     }
 
+    /**
+     * walks the configured cache subtree containing the oid of vb unless it was walked before
+     *
+     * Other plugins querying the same host mostly request different
+     * objects of the same subtree - caching the whole subtree lets them
+     * find their values without sending any request.
+     *
+     * @param vb - the varbind missing in the cache, receives the value when found
+     *
+     * @return true when vb was found in the cache afterwards
+     */
+    bool prefetch( Vb &vb )
+    {
+        Oid oid, subtree;
+        vb.get_oid( oid );
+        if( !mVbCache.begin_prefetch( oid, subtree ) )
+            return false;
+
+        SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 5 );
+        LOG( "prefetch: walking cached subtree" );
+        LOG( subtree.get_printable() );
+        LOG_END;
+
+        // values stored before a failure are fine - the missing ones are requested as usual
+        GetBulkCacheSubtreeHelper cacheSubtree( subtree, mVbCache );
+        get_bulk( subtree, cacheSubtree );
+
+        return mVbCache.lookup( vb );
+    }
+
     int get_next( Vb &varBind )
     {
         Pdu pdu( mPdu ); // start fresh
         pdu.set_vblist( &varBind, 1 );
 
-        LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
+        SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
         LOG( "get_next( oid )" );
         LOG( varBind.get_printable_oid() );
         LOG_END;
@@ -559,7 +1411,7 @@ public:
         int rc = get_next( pdu );
         if( SNMP_CLASS_SUCCESS == rc )
         {
-            LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
+            SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
             LOG( "get_next( oid ): rc, error_index" );
             LOG( rc );
             LOG( pdu.get_error_index() );
@@ -569,7 +1421,7 @@ public:
         if( !pdu.get_vb( varBind, 0 ) )
             throw snmp_bad_result( "Can't extract varBind after successful get_next request" );
 
-        LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
+        SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
         LOG( "get_next( oid ): " );
         LOG( string( string( varBind.get_printable_oid() ) + "=" + string( varBind.get_printable_value() ) ).c_str() );
         LOG_END;
@@ -582,7 +1434,7 @@ public:
         Pdu pdu( mPdu ); // start fresh
         pdu.set_vblist( &vblist[0], vblist.size() );
 
-        LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
+        SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
         LOG( "get_next( vbs )" );
         for( vector<Vb>::iterator i = vblist.begin(); i != vblist.end(); ++i )
         {
@@ -593,7 +1445,7 @@ public:
         int rc = get_next( pdu );
         if( SNMP_CLASS_SUCCESS == rc )
         {
-            LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
+            SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
             LOG( "get_next( list ): rc, error_index" );
             LOG( rc );
             LOG( pdu.get_error_index() );
@@ -605,7 +1457,7 @@ public:
 
         for( vector<Vb>::iterator i = vblist.begin(); i != vblist.end(); ++i )
         {
-            LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
+            SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
             LOG( "received: " );
             LOG( string( string( i->get_printable_oid() ) + "=" + string( i->get_printable_value() ) ).c_str() );
             LOG_END;
@@ -614,20 +1466,31 @@ public:
         return rc;
     }
 
+    /**
+     * walks the subtree below start using get-bulk requests
+     *
+     * @param start - the oid to start the walk at
+     * @param f - functor receiving each varbind, returns true to stop the walk
+     * @param max_reps - max-repetitions, 0 to adapt them automatically
+     *
+     * @return value from Snmp::get_bulk
+     */
     template < class F >
-    int get_bulk( Oid const &start, F &f, int max_reps = BulkMax )
+    int get_bulk( Oid const &start, F &f, int max_reps = 0 )
     {
         Pdu pdu( mPdu ); // start fresh
         Vb varBind(start);
         pdu.set_vblist( &varBind, 1 );
         int rc, num_vbs_received;
 
-        LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
+        SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
         LOG( "get_bulk( oid )" );
         LOG( varBind.get_printable_oid() );
         LOG_END;
 
-        while( ( SNMP_CLASS_SUCCESS == ( rc = get_bulk( pdu, max_reps ) ) )
+        unsigned roundTrips = mBulkControl.getRoundTrips();
+
+        while( ( SNMP_CLASS_SUCCESS == ( rc = request_bulk( pdu, 1, max_reps ) ) )
             && ( 0 != (num_vbs_received = pdu.get_vb_count() ) ) )
         {
 	    for( int z = 0; z < num_vbs_received; ++z )
@@ -635,7 +1498,7 @@ public:
                 if( !pdu.get_vb( varBind, z ) )
                     throw snmp_bad_result( "Can't extract varBind after successful get_next request" );
 
-                LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
+                SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
                 LOG( "received: " );
                 LOG( string( string( varBind.get_printable_oid() ) + "=" + string( varBind.get_printable_value() ) ).c_str() );
                 LOG_END;
@@ -663,7 +1526,7 @@ public:
 
         if( SNMP_CLASS_SUCCESS == rc )
         {
-            LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
+            SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
             LOG( "get_bulk( oid ): rc, error_index" );
             LOG( rc );
             LOG( pdu.get_error_index() );
@@ -671,100 +1534,201 @@ public:
         }
 
 finish:
+        finish_bulk_walk( "get_bulk", roundTrips, max_reps );
         return rc;
     }
 
-    int get_bulk( Oid const &start, vector<Vb> &result, int max_reps = BulkMax )
+    int get_bulk( Oid const &start, vector<Vb> &result, int max_reps = 0 )
     {
         GetBulkFetchHelper fetchHelper( start, result );
         return get_bulk<GetBulkFetchHelper>( start, fetchHelper, max_reps );
     }
 
+    /**
+     * walks the columns given by start using get-bulk requests
+     *
+     * @param start - the column oids to walk
+     * @param f - functor receiving each row as SnmpTableRow, returns true to stop the walk
+     * @param max_reps - max-repetitions, 0 to adapt them automatically
+     *
+     * @return value from Snmp::get_bulk
+     */
     template < class F >
-    int get_table( vector<Oid> const &start, F &f, int max_reps = BulkMax )
+    int get_table( vector<Oid> const &start, F &f, int max_reps = 0 )
     {
-        Pdu pdu( mPdu ); // start fresh
-        vector<Vb> vbVec;
+        if( walk_parallel( start ) )
+            return get_table_parallel( *this, start, f, mParallelWalk );
 
-        vbVec.assign( start.begin(), start.end() );
+        SnmpTableCursor cursor( *this, start, max_reps );
 
-        LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
-        LOG( "get_table( vbs )" );
-        for( vector<Vb>::iterator i = vbVec.begin(); i != vbVec.end(); ++i )
-        {
-            LOG( i->get_printable_oid() );
-        }
-        LOG_END;
+        return walk_rows( cursor, cursor.next(), f );
+    }
 
-        pdu.set_vblist( &vbVec[0], vbVec.size() );
-        int rc, num_vbs_received;
+    /**
+     * walks the columns given by start and fetches scalars along with the first rows
+     *
+     * The scalars are sent as non-repeaters of the first get-bulk request,
+     * which saves the separate get request for them.
+     *
+     * @param scalars - the scalars to fetch, receive the values
+     * @param start - the column oids to walk
+     * @param f - functor receiving each row as SnmpTableRow, returns true to stop the walk
+     * @param max_reps - max-repetitions, 0 to adapt them automatically
+     *
+     * @return value from Snmp::get_bulk
+     */
+    template < class F >
+    int get_table( vector<Vb> &scalars, vector<Oid> const &start, F &f, int max_reps = 0 )
+    {
+        if( scalars.empty() )
+            return get_table( start, f, max_reps );
 
-        while( ( SNMP_CLASS_SUCCESS == ( rc = get_bulk( pdu, max_reps ) ) )
-            && ( 0 != (num_vbs_received = pdu.get_vb_count() ) ) )
+        if( start.empty() || walk_parallel( start ) )
         {
-            if( ( 1 == num_vbs_received ) && ( pdu.get_vb( 0 ).get_syntax() == sNMP_SYNTAX_ENDOFMIBVIEW ) )
-                break;
+            int rc = get( scalars );
+            if( ( SNMP_CLASS_SUCCESS != rc ) || start.empty() )
+                return rc;
+            return get_table( start, f, max_reps );
+        }
 
-            if( num_vbs_received % vbVec.size() )
-            {
-                throw snmp_bad_result( string("Invalid number of results (") + to_string(num_vbs_received) + "), " +
-                                       "expected multiple of " + to_string(vbVec.size()) );
-            }
+        SnmpTableCursor cursor( *this, start, max_reps, &scalars );
 
-            for( int z = 0; z < num_vbs_received; z += vbVec.size() )
-            {
-                for( typename vector<Vb>::size_type i = 0; i < vbVec.size(); ++i )
-                {
-                    if( !pdu.get_vb( vbVec[i], z + i ) )
-                        throw snmp_bad_result( "Can't extract varBind after successful get_next request" );
+        return walk_rows( cursor, cursor.next(), f );
+    }
 
-                    if( start[i].nCompare( start[i].len(), vbVec[i].get_oid() ) != 0 )
-                        goto finish;
-                }
+    /**
+     * walks the columns given by start and copies all rows
+     *
+     * Needs memory for the whole table - prefer get_table with a functor.
+     */
+    int get_table( vector<Oid> const &start, vector< vector<Vb> > &result, int max_reps = 0 )
+    {
+        GetBulkFetchTableHelper fetchTableHelper( result );
+        return get_table<GetBulkFetchTableHelper>( start, fetchTableHelper, max_reps );
+    }
 
-                for( vector<Vb>::iterator i = vbVec.begin(); i != vbVec.end(); ++i )
-                {
-                    LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
-                    LOG( "received: " );
-                    LOG( string( string( i->get_printable_oid() ) + "=" + string( i->get_printable_value() ) ).c_str() );
-                    LOG_END;
-                }
+    /**
+     * walks the columns given by start unless the agent didn't update them since the last walk
+     *
+     * Requests the last update stamp of the table along with the first
+     * rows. When a snapshot of a previous walk taken at the same stamp
+     * exists, its rows are passed to f instead of walking the table any
+     * further. Without a stamp (other daemons, no cache directory) the
+     * table is simply walked. A walk stopped by f isn't kept as snapshot.
+     * The snapshots are named by the host key, thus they're disabled
+     * without the key of the stores, too.
+     *
+     * @param lastUpdate - oid of the last update stamp of the table, empty for none
+     * @param scalars - further scalars to fetch along with the first rows, receive the values
+     * @param start - the column oids to walk
+     * @param f - functor receiving each row (SnmpTableRow or vector<Vb>), returns true to stop
+     * @param max_reps - max-repetitions, 0 to adapt them automatically
+     *
+     * @return value from Snmp::get_bulk
+     */
+    template < class F >
+    int get_table_snapshot( Oid const &lastUpdate, vector<Vb> &scalars, vector<Oid> const &start, F &f, int max_reps = 0 )
+    {
+        if( ( 0 == mHostState.mKey ) || ( 0 == lastUpdate.len() ) || start.empty() )
+            return get_table( scalars, start, f, max_reps );
 
-                if( f( vbVec ) )
-                {
-                    goto finish;
-                }
-            }
+        vector<Vb> request( scalars );
+        request.push_back( Vb( lastUpdate ) );
 
-            for( vector<Vb>::iterator i = vbVec.begin(); i != vbVec.end(); ++i )
-                i->set_null();
-            pdu.set_vblist( &vbVec[0], vbVec.size() );
+        // the parallel streams can't carry non-repeaters
+        bool parallel = walk_parallel( start );
+        SnmpTableCursor cursor( *this, start, max_reps, parallel ? 0 : &request );
+        bool haveRow = false;
+        int rc;
+
+        if( parallel )
+        {
+            rc = get( request );
         }
+        else
+        {
+            haveRow = cursor.next();
+            rc = cursor.getStatus();
+        }
+        if( SNMP_CLASS_SUCCESS != rc )
+            return rc;
 
-        if( SNMP_CLASS_SUCCESS == rc )
+        scalars.assign( request.begin(), request.end() - 1 );
+
+        string stamp;
+        uint32_t syntax;
+        if( !VbCache::encode_value( request.back(), syntax, stamp ) )
+            return parallel ? get_table( start, f, max_reps ) : walk_rows( cursor, haveRow, f );
+        stamp = to_string( syntax ) + ":" + stamp;
+
+        string key = to_string( mHostState.mKey );
+        for( vector<Oid>::const_iterator ci = start.begin(); ci != start.end(); ++ci )
+            key += string( "|" ) + ci->get_printable();
+        char fileName[32];
+        snprintf( fileName, sizeof(fileName), "%016llx.snap", (unsigned long long)HostStateStore::make_key( key ) );
+        string path = mCacheDir + "/snapshots/" + fileName;
+
+        if( TableSnapshot::replay( path, stamp, start.size(), f ) )
         {
-            LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
-            LOG( "get_table( list ): rc, error_index" );
-            LOG( rc );
-            LOG( pdu.get_error_index() );
+            SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 5 );
+            LOG( "get_table_snapshot: table unchanged, rows from snapshot" );
             LOG_END;
+
+            return SNMP_CLASS_SUCCESS;
         }
 
-finish:
-        return rc;
+        // write the snapshot while walking - it's only kept when the table was walked completely
+        TableSnapshot::Writer snapshot( path, stamp, start.size() );
+        SnapshotWritingRows<F> snapshotWritingRows( snapshot, f );
+
+        rc = parallel ? get_table( start, snapshotWritingRows, max_reps ) : walk_rows( cursor, haveRow, snapshotWritingRows );
+        if( SNMP_CLASS_SUCCESS != rc )
+            return rc;
+
+        if( !snapshotWritingRows.stopped() )
+            snapshot.commit();
+
+        return SNMP_CLASS_SUCCESS;
     }
 
-    int get_table( vector<Oid> const &start, vector< vector<Vb> > &result, int max_reps = BulkMax )
+    template < class F >
+    int get_table_snapshot( Oid const &lastUpdate, vector<Oid> const &start, F &f, int max_reps = 0 )
     {
-        GetBulkFetchTableHelper fetchTableHelper( result );
-        return get_table<GetBulkFetchTableHelper>( start, fetchTableHelper, max_reps );
+        vector<Vb> scalars;
+        return get_table_snapshot( lastUpdate, scalars, start, f, max_reps );
     }
 
-protected:
     /**
-     * snmp session object
-     */
-    Snmp *mSnmp;
+     * computes the oid to request as non-repeater of a get-bulk request to receive scalar
+     *
+     * Non-repeaters are answered like get-next requests, so the oid right
+     * before the scalar is requested: the object of an instance ".0" or
+     * the greatest possible oid below the preceding sibling.
+     *
+     * @param scalar - oid of the scalar instance
+     *
+     * @return oid preceding scalar
+     */
+    static Oid non_repeater_oid( Oid const &scalar )
+    {
+        Oid oid( scalar );
+        unsigned long last = oid.len() ? oid[oid.len() - 1] : 0;
+
+        oid.trim( 1 );
+        if( 0 != last )
+        {
+            oid += last - 1;
+            oid += 0xFFFFFFFFUL;
+        }
+
+        return oid;
+    }
+
+protected:
+    /**
+     * snmp session object
+     */
+    Snmp *mSnmp;
     /**
      * target server identifier
      */
@@ -773,6 +1737,756 @@ protected:
      * protocol data unit to parametrize snmp requests
      */
     Pdu mPdu;
+    /**
+     * pool to borrow the session from (not owned)
+     */
+    SnmpSessionPool *mSessionPool;
+    /**
+     * key of the session in mSessionPool
+     */
+    string mSessionKey;
+
+    /**
+     * directory for data remembered between runs, empty when disabled
+     */
+    string mCacheDir;
+    /**
+     * store of the per host state, NULL when caching is disabled
+     */
+    HostStateStore *mHostStateStore;
+    /**
+     * state of the queried host, loaded at configure()
+     */
+    HostStateRecord mHostState;
+    /**
+     * adapts max-repetitions of get-bulk requests
+     */
+    BulkRepetitionController mBulkControl;
+
+    /**
+     * loads the state of the queried host remembered by previous runs
+     *
+     * @param vm - map of values specified on command line
+     */
+    void load_host_state(variables_map const &vm)
+    {
+        mCacheDir = vm.count("cache-dir") ? vm["cache-dir"].as<string>() : string();
+        // the session key contains the credentials - without a keyed hash, nothing is remembered
+        StoreKeyHasher const *hasher = StoreKeyHasher::instance( mCacheDir );
+        mHostStateStore = hasher ? HostStateStore::instance( mCacheDir ) : NULL;
+        mRowIndexStore = hasher ? RowIndexStore::instance( mCacheDir ) : NULL;
+
+        memset( &mHostState, 0, sizeof(mHostState) );
+        mHostState.mKey = hasher ? hasher->hash( get_session_key( vm ) ) : 0;
+        strncpy( mHostState.mHost, mTarget->get_address().get_printable(), sizeof(mHostState.mHost) - 1 );
+
+        if( mHostStateStore && mHostStateStore->load( mHostState.mKey, mHostState ) )
+        {
+            mHostState.mHost[sizeof(mHostState.mHost) - 1] = 0;
+            mHostState.mDaemonName[sizeof(mHostState.mDaemonName) - 1] = 0;
+
+            SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 5 );
+            LOG( "load_host_state: bulk max-repetitions" );
+            LOG( mHostState.mBulkMaxRepetitions );
+            LOG( "load_host_state: get max message size" );
+            LOG( mHostState.mGetMaxMsgSize );
+            LOG( "load_host_state: daemon" );
+            LOG( mHostState.mDaemonName );
+            LOG_END;
+        }
+
+        if( mHostState.mBulkMaxRepetitions )
+            mBulkControl.setRepetitions( mHostState.mBulkMaxRepetitions );
+        mRtt.setState( mHostState.mSmoothedRtt, mHostState.mRttVariance );
+        mGetMaxMsgSize = mHostState.mGetMaxMsgSize ? (int)mHostState.mGetMaxMsgSize : DefaultMaxMsgSize;
+
+        mVbCache.configure( vm, mHostState.mKey ? to_string( mHostState.mKey ) : string() );
+    }
+
+    /**
+     * writes the members first up to last of the host state back to the store
+     *
+     * Only the given members are updated - other plugins checking the same
+     * host concurrently might have changed the other ones.
+     *
+     * @param first - first member of mHostState to store
+     * @param last - last member of mHostState to store
+     */
+    template < class First, class Last >
+    void save_host_state( First const &first, Last const &last )
+    {
+        if( mHostStateStore )
+            mHostStateStore->save_members( mHostState, &first, reinterpret_cast<char const *>( &last + 1 ) - reinterpret_cast<char const *>( &first ) );
+    }
+
+    /**
+     * remembers the round trip time estimated by this run for the following runs
+     */
+    void save_rtt_state()
+    {
+        if( !mRtt.sampled() || ( 0 == mHostState.mKey ) )
+            return;
+
+        mHostState.mSmoothedRtt = mRtt.getSmoothedRtt();
+        mHostState.mRttVariance = mRtt.getRttVariance();
+        save_host_state( mHostState.mSmoothedRtt, mHostState.mRttVariance );
+    }
+
+    /**
+     * sends a request, retrying timed out tries with increasing timeouts
+     *
+     * Each try is sent as a request of its own (with a new request id),
+     * so the round trip time of each answered try can be sampled.
+     *
+     * @param pdu - the request, receives the response
+     * @param type - sNMP_PDU_GET, sNMP_PDU_GETNEXT or sNMP_PDU_GETBULK
+     * @param non_reps - non-repeaters of get-bulk requests
+     * @param max_reps - max-repetitions of get-bulk requests
+     *
+     * @return value from Snmp::get, Snmp::get_next or Snmp::get_bulk of the last try
+     */
+    int send_request( Pdu &pdu, unsigned short type, int non_reps = 0, int max_reps = 0 )
+    {
+        if( mTcpTransport )
+            return send_tcp_request( pdu, type, non_reps, max_reps );
+
+        int rc = SNMP_CLASS_TIMEOUT;
+        long timeout = mRtt.getTimeout();
+        for( unsigned attempt = 0; attempt <= mRetries; ++attempt, timeout = mRtt.backoff( timeout ) )
+        {
+            long long sent = now_ms();
+            if( mDeadline )
+            {
+                long left = static_cast<long>( mDeadline - sent ) * 1000;
+                if( left < RttEstimator::MinTimeout )
+                    break;
+                if( timeout > left )
+                    timeout = left;
+            }
+
+            Pdu request( pdu );
+            mTarget->set_retry( 0 );
+            mTarget->set_timeout( ( timeout + 9999 ) / 10000 ); // in hundreds of seconds
+
+            switch( type )
+            {
+            case sNMP_PDU_GETNEXT:
+                rc = mSnmp->get_next( request, *mTarget );
+                break;
+
+            case sNMP_PDU_GETBULK:
+                rc = mSnmp->get_bulk( request, *mTarget, non_reps, max_reps );
+                break;
+
+            default:
+                rc = mSnmp->get( request, *mTarget );
+                break;
+            }
+
+            if( SNMP_CLASS_TIMEOUT == rc )
+            {
+                SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 5 );
+                LOG( "send_request: try timed out, timeout (us)" );
+                LOG( attempt );
+                LOG( timeout );
+                LOG_END;
+
+                continue;
+            }
+
+            // local failures say nothing about the round trip
+            if( ( SNMP_CLASS_SUCCESS == rc ) || ( rc > 0 ) )
+                mRtt.sample( static_cast<long>( now_ms() - sent ) * 1000 );
+            pdu = request;
+            break;
+        }
+
+        // the target is shared with asynchronous requests which retry on their own
+        mTarget->set_retry( mRetries );
+        mTarget->set_timeout( mRtt.getMaxTimeout() / 10000 );
+
+        return check_usm_keys( rc );
+    }
+
+    /**
+     * sends a request over the tcp transport
+     *
+     * Retransmissions are up to tcp - the request waits as long as all
+     * tries over udp would, but not beyond the deadline of the plugin.
+     *
+     * @see send_request()
+     */
+    int send_tcp_request( Pdu &pdu, unsigned short type, int non_reps, int max_reps )
+    {
+        long long sent = now_ms();
+        long long deadline = sent + mRtt.getMaxTimeout() / 1000 * ( mRetries + 1 );
+        if( mDeadline && ( mDeadline < deadline ) )
+            deadline = mDeadline;
+        if( deadline - sent < RttEstimator::MinTimeout / 1000 )
+            return SNMP_CLASS_TIMEOUT;
+
+        int rc = mTcpTransport->request( pdu, *static_cast<CTarget *>( mTarget ), type, non_reps, max_reps, deadline );
+        if( ( SNMP_CLASS_SUCCESS == rc ) || ( rc > 0 ) )
+            mRtt.sample( static_cast<long>( now_ms() - sent ) * 1000 );
+
+        return rc;
+    }
+
+    /**
+     * @return true when the columns given by start are walked in parallel streams (see get_table_parallel())
+     */
+    bool walk_parallel( vector<Oid> const &start ) const
+    {
+        // the streams are sent asynchronously by the udp session - not over the tcp transport
+        return ( mParallelWalk > 1 ) && ( start.size() > 1 ) && !mTcpTransport;
+    }
+
+    /**
+     * passes the rows of cursor to f until f returns true or the table ends
+     *
+     * @param cursor - cursor to walk
+     * @param haveRow - true when the cursor is positioned at a row
+     * @param f - functor receiving each row as SnmpTableRow, returns true to stop the walk
+     *
+     * @return value from Snmp::get_bulk of the last request
+     */
+    template < class F >
+    int walk_rows( SnmpTableCursor &cursor, bool haveRow, F &f )
+    {
+        for( ; haveRow; haveRow = cursor.next() )
+        {
+            if( f( cursor.row() ) )
+            {
+                cursor.finish();
+                break;
+            }
+        }
+
+        return cursor.getStatus();
+    }
+
+    /**
+     * sends a get-bulk request, adapting the max-repetitions when requested
+     *
+     * On tooBig responses the request is resent with halved max-repetitions,
+     * on timeouts only once and only when the repetitions were increased
+     * beyond the default before.
+     *
+     * @param pdu - the request, receives the response
+     * @param columns - number of repeated varbinds in the request
+     * @param max_reps - fixed max-repetitions, 0 to adapt them
+     * @param non_reps - number of non-repeaters in front of the repeated varbinds
+     *
+     * @return value from Snmp::get_bulk
+     */
+    int request_bulk( Pdu &pdu, int columns, int max_reps, int non_reps = 0 )
+    {
+        if( max_reps > 0 )
+            return get_bulk( pdu, max_reps, non_reps );
+
+        bool retriedTimeout = false;
+        for(;;)
+        {
+            Pdu request( pdu );
+            int rc = get_bulk( request, mBulkControl.getRepetitions(), non_reps );
+
+            if( ( SNMP_ERROR_TOO_BIG == rc ) && mBulkControl.failed() )
+                continue;
+            if( ( SNMP_CLASS_TIMEOUT == rc ) && !retriedTimeout &&
+                ( mBulkControl.getRepetitions() > BulkMax ) && mBulkControl.failed() )
+            {
+                retriedTimeout = true;
+                continue;
+            }
+            if( SNMP_CLASS_SUCCESS == rc )
+                mBulkControl.responded( columns, request.get_vb_count() - non_reps, request.get_asn1_length() );
+
+            pdu = request;
+            return rc;
+        }
+    }
+
+    /**
+     * logs the statistics of a bulk walk and remembers the adapted max-repetitions
+     */
+    void finish_bulk_walk( const char *what, unsigned roundTripsBefore, int max_reps )
+    {
+        SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 5 );
+        LOG( what );
+        LOG( "max-repetitions, round trips" );
+        LOG( max_reps > 0 ? max_reps : mBulkControl.getRepetitions() );
+        LOG( mBulkControl.getRoundTrips() - roundTripsBefore );
+        LOG_END;
+
+        if( ( 0 == max_reps ) && ( mHostState.mBulkMaxRepetitions != (uint32_t)mBulkControl.getRepetitions() ) )
+        {
+            mHostState.mBulkMaxRepetitions = mBulkControl.getRepetitions();
+            save_host_state( mHostState.mBulkMaxRepetitions, mHostState.mBulkMaxRepetitions );
+        }
+    }
+
+    /**
+     * learned maximum size of get requests (as estimated by estimate_vb_size)
+     */
+    int mGetMaxMsgSize;
+
+    /**
+     * requests the given varbinds in as few requests as possible
+     *
+     * @param vblist - the varbinds to request, receive the values
+     *
+     * @return value from Snmp::get of the last request sent
+     */
+    int get_planned( vector<Vb> &vblist )
+    {
+        int rc = SNMP_CLASS_SUCCESS;
+        vector<Vb>::size_type first = 0;
+        while( first < vblist.size() )
+        {
+            int estimatedSize = 0;
+            vector<Vb>::size_type count = plan_get( vblist, first, estimatedSize );
+
+            rc = get_packed( vblist, first, count );
+            if( ( SNMP_ERROR_TOO_BIG == rc ) && ( count > 1 ) )
+            {
+                learn_get_msg_size( estimatedSize / 2 );
+                continue;
+            }
+
+            if( SNMP_CLASS_SUCCESS != rc )
+            {
+                SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
+                LOG( "get( list ): rc" );
+                LOG( rc );
+                LOG_END;
+
+                return rc;
+            }
+
+            first += count;
+        }
+
+        return rc;
+    }
+
+    /**
+     * estimates the size of a varbind in the response to a get request
+     *
+     * @param vb - the requested varbind
+     *
+     * @return estimated size in bytes
+     */
+    static int estimate_vb_size( Vb const &vb )
+    {
+        Oid oid;
+        vb.get_oid( oid );
+
+        int size = VbValueEstimate + 1; // first two sub-identifiers are encoded in one byte
+        for( unsigned long i = 2; i < oid.len(); ++i )
+        {
+            unsigned long subId = oid[i];
+            do
+            {
+                ++size;
+                subId >>= 7;
+            } while( subId );
+        }
+
+        return size;
+    }
+
+    /**
+     * determines how many varbinds fit into the next get request
+     *
+     * @param vblist - all varbinds to request
+     * @param first - index of the first varbind of the next request
+     * @param estimatedSize - receives the estimated size of the request
+     *
+     * @return number of varbinds to request, at least 1
+     */
+    vector<Vb>::size_type plan_get( vector<Vb> const &vblist, vector<Vb>::size_type first, int &estimatedSize ) const
+    {
+        vector<Vb>::size_type last = first;
+
+        estimatedSize = PduOverheadEstimate;
+        while( last < vblist.size() )
+        {
+            int vbSize = estimate_vb_size( vblist[last] );
+            if( ( last > first ) && ( estimatedSize + vbSize > mGetMaxMsgSize ) )
+                break;
+            estimatedSize += vbSize;
+            ++last;
+        }
+
+        return last - first;
+    }
+
+    /**
+     * lowers the maximum size of get requests after a tooBig response
+     *
+     * @param maxMsgSize - size of a request that probably fits
+     */
+    void learn_get_msg_size( int maxMsgSize )
+    {
+        if( maxMsgSize < PduOverheadEstimate + VbValueEstimate )
+            maxMsgSize = PduOverheadEstimate + VbValueEstimate;
+        if( maxMsgSize >= mGetMaxMsgSize )
+            return;
+
+        SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 5 );
+        LOG( "learn_get_msg_size: tooBig - reduced get request size" );
+        LOG( maxMsgSize );
+        LOG_END;
+
+        mGetMaxMsgSize = maxMsgSize;
+        mHostState.mGetMaxMsgSize = maxMsgSize;
+        save_host_state( mHostState.mGetMaxMsgSize, mHostState.mGetMaxMsgSize );
+    }
+
+    /**
+     * requests count varbinds of vblist beginning at first in one pdu
+     *
+     * SNMPv1 agents reject the entire request when one of the varbinds
+     * doesn't exist - those are marked as noSuchObject (like SNMPv2c
+     * agents would answer) and the request is resent without them.
+     *
+     * @return value from Snmp::get
+     */
+    int get_packed( vector<Vb> &vblist, vector<Vb>::size_type first, vector<Vb>::size_type count )
+    {
+        vector<vector<Vb>::size_type> positions;
+        for( vector<Vb>::size_type i = first; i < first + count; ++i )
+            positions.push_back( i );
+
+        for(;;)
+        {
+            vector<Vb> request;
+            for( vector<vector<Vb>::size_type>::iterator i = positions.begin(); i != positions.end(); ++i )
+                request.push_back( vblist[*i] );
+
+            Pdu pdu( mPdu ); // start fresh
+            pdu.set_vblist( &request[0], request.size() );
+
+            int rc = get( pdu );
+            int errorIndex = pdu.get_error_index();
+            if( ( SNMP_ERROR_NO_SUCH_NAME == rc ) && ( version1 == mTarget->get_version() ) &&
+                ( errorIndex > 0 ) && ( errorIndex <= (int)positions.size() ) )
+            {
+                SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
+                LOG( "get( list ): noSuchName - resending without" );
+                LOG( vblist[positions[errorIndex - 1]].get_printable_oid() );
+                LOG_END;
+
+                vblist[positions[errorIndex - 1]].set_syntax( sNMP_SYNTAX_NOSUCHOBJECT );
+                positions.erase( positions.begin() + ( errorIndex - 1 ) );
+                if( positions.empty() )
+                    return SNMP_CLASS_SUCCESS;
+                continue;
+            }
+
+            if( SNMP_CLASS_SUCCESS != rc )
+            {
+                SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
+                LOG( "get( list ): rc, error_index" );
+                LOG( rc );
+                LOG( errorIndex );
+                LOG_END;
+
+                return rc;
+            }
+
+            if( !pdu.get_vblist( &request[0], request.size() ) )
+                throw snmp_bad_result( "Can't extract varBinds after successful get request" );
+
+            for( vector<Vb>::size_type i = 0; i < positions.size(); ++i )
+                vblist[positions[i]] = request[i];
+
+            return rc;
+        }
+    }
+
+    /**
+     * state of the SNMPv3 keys of the current target
+     */
+    enum UsmKeyState
+    {
+        UsmKeysNone,       //!< nothing to do
+        UsmKeysToRemember, //!< store the keys after the first successful request
+        UsmKeysRemembered  //!< keys taken from the store, not yet verified by a request
+    };
+
+    /**
+     * store of the localized SNMPv3 keys, NULL when caching is disabled
+     */
+    UsmKeyStore *mUsmKeyStore;
+    /**
+     * localized SNMPv3 keys of the current target
+     */
+    UsmKeyRecord mUsmKeys;
+    UsmKeyState mUsmKeyState;
+    /**
+     * security name of the current target
+     */
+    string mUsmSecurityName;
+    /**
+     * values shared with other plugins querying the same host
+     */
+    VbCache mVbCache;
+    /**
+     * store of the row indices found by name, NULL when caching is disabled
+     */
+    RowIndexStore *mRowIndexStore;
+    /**
+     * maximum number of parallel streams to walk tables with, 0 or 1 to walk all columns together
+     */
+    unsigned mParallelWalk;
+    /**
+     * set when the target is addressed by ipv6
+     */
+    bool mIpv6;
+    /**
+     * transport for the requests when --transport tcp is given, NULL to use the snmp session
+     */
+    SnmpTcpTransport *mTcpTransport;
+    /**
+     * round trip time estimation of the target, derives the timeout of each try
+     */
+    RttEstimator mRtt;
+    /**
+     * number of retries after a try timed out (--retries)
+     */
+    unsigned mRetries;
+    /**
+     * time in milliseconds since the epoch to give up sending requests at, 0 for none
+     */
+    long long mDeadline;
+
+    /**
+     * @return key of the row containing name in the table searched by columns
+     */
+    uint64_t make_row_index_key( vector<Oid> const &columns, string const &name ) const
+    {
+        string key = to_string( mHostState.mKey );
+        for( vector<Oid>::const_iterator ci = columns.begin(); ci != columns.end(); ++ci )
+            key += string( "|" ) + ci->get_printable();
+        key += "|" + name;
+
+        return RowIndexStore::make_key( key );
+    }
+
+#ifdef _SNMPv3
+    /**
+     * adds the SNMPv3 user with the keys localized by a previous run
+     *
+     * Avoids the engine id discovery and the expensive password to key
+     * localization.
+     *
+     * @param vm - map of values specified on command line
+     * @param srv - address of the target
+     *
+     * @return true when remembered keys were found and added, false otherwise
+     */
+    bool add_remembered_usm_user( variables_map const &vm, UdpAddress const &srv )
+    {
+        string cacheDir = vm.count("cache-dir") ? vm["cache-dir"].as<string>() : string();
+        StoreKeyHasher const *hasher = StoreKeyHasher::instance( cacheDir );
+        mUsmKeyStore = hasher ? UsmKeyStore::instance( cacheDir ) : 0;
+        mUsmSecurityName = vm["security-name"].as<string>();
+
+        memset( &mUsmKeys, 0, sizeof(mUsmKeys) );
+        mUsmKeys.mKey = hasher ? hasher->hash( get_session_key( vm ) ) : 0;
+
+        if( NULL == mUsmKeyStore )
+            return false;
+
+        mUsmKeyState = UsmKeysToRemember;
+        if( !mUsmKeyStore->load( mUsmKeys.mKey, mUsmKeys ) ||
+            ( 0 == mUsmKeys.mEngineIdLength ) || ( mUsmKeys.mEngineIdLength > sizeof(mUsmKeys.mEngineId) ) ||
+            ( mUsmKeys.mAuthKeyLength > sizeof(mUsmKeys.mAuthKey) ) || ( mUsmKeys.mPrivKeyLength > sizeof(mUsmKeys.mPrivKey) ) )
+        {
+            return false;
+        }
+
+        OctetStr engineId( mUsmKeys.mEngineId, mUsmKeys.mEngineIdLength );
+        OctetStr securityName( mUsmSecurityName.c_str() );
+        IpAddress ip( srv );
+        v3MP *v3_MP = init_v3mp();
+
+        v3_MP->add_to_engine_id_table( engineId, ip.get_printable(), srv.get_port() );
+        int rc = v3_MP->get_usm()->add_localized_user( engineId, securityName, securityName,
+                                                       vm["auth-protocol"].as<SnmpV3AuthProtocol>(),
+                                                       OctetStr( mUsmKeys.mAuthKey, mUsmKeys.mAuthKeyLength ),
+                                                       vm["priv-protocol"].as<SnmpV3PrivProtocol>(),
+                                                       OctetStr( mUsmKeys.mPrivKey, mUsmKeys.mPrivKeyLength ) );
+        if( SNMPv3_USM_OK != rc )
+        {
+            SSNC_LOG_BEGIN( loggerModuleName, WARNING_LOG | 1 );
+            LOG( "add_remembered_usm_user: can't add localized user" );
+            LOG( rc );
+            LOG_END;
+
+            return false;
+        }
+
+        SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 5 );
+        LOG( "add_remembered_usm_user: using remembered engine id" );
+        LOG( engineId.get_printable_hex() );
+        LOG_END;
+
+        mUsmKeyState = UsmKeysRemembered;
+        return true;
+    }
+
+    /**
+     * stores the discovered engine id and the localized keys of the current target
+     */
+    void remember_usm_keys()
+    {
+        v3MP *v3_MP = init_v3mp();
+        USM *usm = v3_MP->get_usm();
+        UdpAddress addr;
+        OctetStr engineId;
+
+        if( !mTarget->get_address( addr ) ||
+            ( SNMPv3_MP_OK != v3_MP->get_from_engine_id_table( engineId, addr.get_printable() ) ) )
+        {
+            return;
+        }
+
+        struct UsmUser *user = usm->get_user( engineId, mUsmSecurityName.c_str() );
+        if( NULL == user )
+            return;
+
+        if( ( user->engineIDLength > 0 ) && ( user->engineIDLength <= (long)sizeof(mUsmKeys.mEngineId) ) &&
+            ( user->authKeyLength <= (long)sizeof(mUsmKeys.mAuthKey) ) &&
+            ( user->privKeyLength <= (long)sizeof(mUsmKeys.mPrivKey) ) )
+        {
+            mUsmKeys.mEngineIdLength = user->engineIDLength;
+            memcpy( mUsmKeys.mEngineId, user->engineID, user->engineIDLength );
+            mUsmKeys.mAuthKeyLength = user->authKeyLength;
+            if( user->authKeyLength )
+                memcpy( mUsmKeys.mAuthKey, user->authKey, user->authKeyLength );
+            mUsmKeys.mPrivKeyLength = user->privKeyLength;
+            if( user->privKeyLength )
+                memcpy( mUsmKeys.mPrivKey, user->privKey, user->privKeyLength );
+
+            mUsmKeyStore->save( mUsmKeys );
+
+            SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 5 );
+            LOG( "remember_usm_keys: stored localized keys for engine id" );
+            LOG( engineId.get_printable_hex() );
+            LOG_END;
+        }
+
+        usm->free_user( user );
+    }
+#endif
+
+    /**
+     * remembers or verifies the SNMPv3 keys after the first request
+     *
+     * @param rc - result of the request
+     *
+     * @return rc
+     */
+    int check_usm_keys( int rc )
+    {
+#ifdef _SNMPv3
+        if( ( UsmKeysToRemember == mUsmKeyState ) && ( SNMP_CLASS_SUCCESS == rc ) )
+        {
+            mUsmKeyState = UsmKeysNone;
+            remember_usm_keys();
+        }
+        else if( UsmKeysRemembered == mUsmKeyState )
+        {
+            mUsmKeyState = UsmKeysNone;
+
+            // anything but an error-status of the agent might be caused by stale keys
+            if( ( SNMP_CLASS_SUCCESS != rc ) && ( ( rc < 0 ) || ( rc > SNMP_ERROR_INCONSIST_NAME ) ) )
+            {
+                SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 5 );
+                LOG( "check_usm_keys: request with remembered keys failed - dropping them" );
+                LOG( rc );
+                LOG_END;
+
+                mUsmKeys.mEngineIdLength = 0;
+                mUsmKeyStore->save( mUsmKeys );
+            }
+        }
+#endif
+
+        return rc;
+    }
+
+    /**
+     * names the principal of a session without revealing any secret
+     *
+     * @param vm - map of values specified on command line
+     *
+     * @return security name for SNMPv3, "community" otherwise
+     */
+    static string get_session_principal(variables_map const &vm)
+    {
+#ifdef _SNMPv3
+        if (vm["snmp-version"].as<snmp_version>() == version3)
+            return vm["security-name"].as<string>();
+#endif
+        return "community";
+    }
+
+    /**
+     * builds the key identifying a reusable session for given parameters
+     *
+     * The key contains credentials in plain text and must never be logged.
+     *
+     * @param vm - map of values specified on command line
+     *
+     * @return string containing address, protocol version and credentials
+     */
+    static string get_session_key(variables_map const &vm)
+    {
+        string key = string( vm["host"].as<UdpAddress>().get_printable() ) + "|"
+                   + to_string( vm["port"].as<unsigned int>() ) + "|"
+                   + to_string( vm["snmp-version"].as<snmp_version>() ) + "|";
+
+#ifdef _SNMPv3
+        if (vm["snmp-version"].as<snmp_version>() == version3)
+        {
+            key += vm["security-name"].as<string>() + "|"
+                 + to_string( vm["auth-protocol"].as<SnmpV3AuthProtocol>() ) + "|"
+                 + to_string( vm["priv-protocol"].as<SnmpV3PrivProtocol>() ) + "|"
+                 + ( vm.count("auth-password") ? vm["auth-password"].as<string>() : string() ) + "|"
+                 + ( vm.count("priv-password") ? vm["priv-password"].as<string>() : string() );
+        }
+        else
+#endif
+            key += vm["community"].as<string>();
+
+        // the bulk repetitions adapted over tcp don't fit through udp
+        if( vm.count("transport") && ( vm["transport"].as<string>() == "tcp" ) )
+            key += "|tcp";
+
+        return key;
+    }
+
+    /**
+     * sets up the pdu template used for each request
+     *
+     * @param vm - map of values specified on command line
+     */
+    void configure_pdu(variables_map const &vm)
+    {
+#ifdef _SNMPv3
+        if (vm["snmp-version"].as<snmp_version>() == version3)
+        {
+            mPdu.set_security_level(vm["security-level"].as<SnmpV3SecurityLevel>());
+            mPdu.set_context_name(vm["context-name"].as<string>().c_str());
+            mPdu.set_context_engine_id(""); // vm["context-engine-id"]
+        }
+#else
+        (void)vm;
+#endif
+    }
 
     /**
      * requests and fetches configured values
@@ -781,7 +2495,7 @@ protected:
      */
     int get( Pdu &pdu )
     {
-        return mSnmp->get( pdu, *mTarget );
+        return send_request( pdu, sNMP_PDU_GET );
     }
 
     /**
@@ -791,20 +2505,211 @@ protected:
      */
     int get_next( Pdu &pdu )
     {
-        return mSnmp->get_next( pdu, *mTarget );
+        return send_request( pdu, sNMP_PDU_GETNEXT );
     }
 
     /**
      * bulk-requests and fetches configured values
      *
+     * @param pdu - the request, receives the response
+     * @param max_reps - max-repetitions of the repeated varbinds
+     * @param non_reps - number of leading varbinds requested only once
+     *
      * @return value from Snmp::get_bulk
      */
-    int get_bulk( Pdu &pdu, int max_reps = BulkMax )
+    int get_bulk( Pdu &pdu, int max_reps = BulkMax, int non_reps = 0 )
     {
-        return mSnmp->get_bulk( pdu, *mTarget, 0, max_reps );
+        return send_request( pdu, sNMP_PDU_GETBULK, non_reps, max_reps );
     }
 };
 
+inline
+SnmpTableCursor::SnmpTableCursor( SnmpComm &comm, vector<Oid> const &columns, int max_reps, vector<Vb> *scalars )
+    : mComm( comm )
+    , mColumns( columns )
+    , mMaxReps( max_reps )
+    , mScalars( ( scalars && !scalars->empty() ) ? scalars : 0 )
+    , mPdu( comm.mPdu )
+    , mReceived( 0 )
+    , mNext( 0 )
+    , mRow()
+    , mStatus( SNMP_CLASS_SUCCESS )
+    , mStarted( false )
+    , mFinished( columns.empty() )
+    , mRoundTrips( comm.mBulkControl.getRoundTrips() )
+{
+    SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
+    LOG( "get_table( vbs )" );
+    for( vector<Oid>::const_iterator i = mColumns.begin(); i != mColumns.end(); ++i )
+    {
+        LOG( i->get_printable() );
+    }
+    LOG_END;
+}
+
+inline bool
+SnmpTableCursor::next()
+{
+    if( mFinished )
+        return false;
+
+    if( ( mNext >= mReceived ) && !request() )
+    {
+        finish();
+        return false;
+    }
+
+    int columns = mColumns.size();
+    for( int i = 0; i < columns; ++i )
+    {
+        Vb const &vb = mPdu.get_vb( mNext + i );
+        if( ( vb.get_syntax() == sNMP_SYNTAX_ENDOFMIBVIEW ) ||
+            ( mColumns[i].nCompare( mColumns[i].len(), vb.get_oid() ) != 0 ) )
+        {
+            // walked beyond the table
+            finish();
+            return false;
+        }
+
+        SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
+        LOG( "received: " );
+        LOG( string( string( vb.get_printable_oid() ) + "=" + string( vb.get_printable_value() ) ).c_str() );
+        LOG_END;
+    }
+
+    mRow = SnmpTableRow( mPdu, mNext, columns );
+    mNext += columns;
+
+    return true;
+}
+
+inline void
+SnmpTableCursor::finish()
+{
+    if( mFinished )
+        return;
+
+    mFinished = true;
+    mComm.finish_bulk_walk( "get_table", mRoundTrips, mMaxReps );
+}
+
+/**
+ * requests the rows following the last received one
+ *
+ * @return true when rows were received
+ */
+inline bool
+SnmpTableCursor::request()
+{
+    int columns = mColumns.size();
+    // the scalars are requested along with the first rows only
+    int nonReps = ( !mStarted && mScalars ) ? mScalars->size() : 0;
+    vector<Vb> vbVec( nonReps + columns );
+
+    for( int i = 0; i < nonReps; ++i )
+        vbVec[i].set_oid( SnmpComm::non_repeater_oid( (*mScalars)[i].get_oid() ) );
+    for( int i = 0; i < columns; ++i )
+    {
+        if( mStarted )
+            vbVec[nonReps + i].set_oid( mPdu.get_vb( mReceived - columns + i ).get_oid() );
+        else
+            vbVec[nonReps + i].set_oid( mColumns[i] );
+    }
+
+    mStarted = true;
+    mPdu.set_vblist( &vbVec[0], vbVec.size() );
+    mReceived = mNext = 0;
+
+    if( SNMP_CLASS_SUCCESS != ( mStatus = mComm.request_bulk( mPdu, columns, mMaxReps, nonReps ) ) )
+        return false;
+
+    mReceived = mPdu.get_vb_count();
+    if( nonReps )
+    {
+        if( mReceived < nonReps )
+        {
+            throw snmp_bad_result( string("Invalid number of results (") + to_string(mReceived) + "), " +
+                                   "expected at least " + to_string(nonReps) );
+        }
+
+        receive_scalars( nonReps );
+        if( SNMP_CLASS_SUCCESS != mStatus )
+            return false;
+        mNext = nonReps;
+    }
+
+    if( ( mNext == mReceived ) || ( ( mNext + 1 == mReceived ) && ( mPdu.get_vb( mNext ).get_syntax() == sNMP_SYNTAX_ENDOFMIBVIEW ) ) )
+    {
+        SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
+        LOG( "get_table( list ): rc, error_index" );
+        LOG( mStatus );
+        LOG( mPdu.get_error_index() );
+        LOG_END;
+
+        return false;
+    }
+
+    if( ( mReceived - mNext ) % columns )
+    {
+        throw snmp_bad_result( string("Invalid number of results (") + to_string(mReceived - mNext) + "), " +
+                               "expected multiple of " + to_string(columns) );
+    }
+
+    return true;
+}
+
+/**
+ * copies the non-repeaters of the first response into the scalars
+ *
+ * Scalars answered by another object (the agent has objects between the
+ * requested oid and the scalar) are fetched by a get request instead.
+ *
+ * @param nonReps - number of non-repeaters in front of the rows
+ */
+inline void
+SnmpTableCursor::receive_scalars( int nonReps )
+{
+    vector<Vb> missing;
+    vector<int> missingAt;
+
+    for( int i = 0; i < nonReps; ++i )
+    {
+        Vb const &vb = mPdu.get_vb( i );
+        Vb &scalar = (*mScalars)[i];
+        Oid oid;
+        scalar.get_oid( oid );
+
+        if( ( vb.get_syntax() != sNMP_SYNTAX_ENDOFMIBVIEW ) && ( oid == vb.get_oid() ) )
+        {
+            scalar = vb;
+        }
+        else
+        {
+            missing.push_back( Vb( oid ) );
+            missingAt.push_back( i );
+        }
+    }
+
+    SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
+    LOG( "get_table( vbs ): non-repeaters, refetched" );
+    LOG( nonReps );
+    LOG( missing.size() );
+    LOG_END;
+
+    if( missing.empty() )
+        return;
+
+    mStatus = mComm.get( missing );
+    if( SNMP_CLASS_SUCCESS != mStatus )
+        return;
+
+    for( vector<Vb>::size_type i = 0; i < missing.size(); ++i )
+        (*mScalars)[missingAt[i]] = missing[i];
+}
+
 #undef loggerModuleName
 
+// defines get_table_parallel()
+#include <smart-snmpd-nagios-plugins/snmp-async-comm.h>
+
 #endif /* __SMART_SNMPD_NAGIOS_CHECKS_SNMP_COMM_H_INCLUDED__ */
@@ -18,6 +18,7 @@
 #define __SMART_SNMPD_NAGIOS_CHECKS_SNMP_SUPPORTED_MIB_MAP_H_INCLUDED__
 
 #include <smart-snmpd-nagios-plugins/snmp-pp-std.h>
+#include <smart-snmpd-nagios-plugins/oid-table.h>
 
 #include <map>
 #include <functional>
@@ -94,8 +95,9 @@ operator > (SnmpDaemonIdentifier const &x, SnmpDaemonIdentifier const &y)
     return x.getName() > y.getName();
 }
 
-static const SnmpDaemonIdentifier IdentifySmartSnmpdMib( "smart-snmpd", SYS_OBJECT_ID ".0", SM_MAHAAG_MIB );
-static const SnmpDaemonIdentifier IdentifyNetSnmpd( "net-snmpd", SYS_OBJECT_ID ".0", "1.3.6.1.4.1.8072" );
+static const unsigned long SysObjectIdInstance[] = { SYS_OBJECT_ID_IDS, 0 };
+static const SnmpDaemonIdentifier IdentifySmartSnmpdMib( "smart-snmpd", Oid( SysObjectIdInstance, lengthof(SysObjectIdInstance) ), SM_MAHAAG_MIB );
+static const SnmpDaemonIdentifier IdentifyNetSnmpd( "net-snmpd", Oid( SysObjectIdInstance, lengthof(SysObjectIdInstance) ), "1.3.6.1.4.1.8072" );
 
 class AnyDataType
     : public boost::any
@@ -142,6 +144,10 @@ public:
         : mDataOids( dataOids )
     {}
 
+    SupportedMibData( StaticOidTable const &dataOids )
+        : mDataOids( dataOids.to_vector() )
+    {}
+
     virtual ~SupportedMibData() {}
 
     virtual vector<Oid> const & getDataOids() const { return mDataOids; }
@@ -158,9 +164,18 @@ class SupportedMibDataTable
     : public SupportedMibData
 {
 public:
-    SupportedMibDataTable( vector<Oid> const &dataOids, vector<Oid> const &rowSearchColumnOids )
+    SupportedMibDataTable( vector<Oid> const &dataOids, vector<Oid> const &rowSearchColumnOids, Oid const &lastUpdateOid = Oid() )
         : SupportedMibData( dataOids )
         , mRowSearchColumnOids( rowSearchColumnOids )
+        , mLastUpdateOid( lastUpdateOid )
+        , mFoundRowIndex( -1 )
+        , mTableOids()
+    {}
+
+    SupportedMibDataTable( StaticOidTable const &dataOids, StaticOidTable const &rowSearchColumnOids, Oid const &lastUpdateOid = Oid() )
+        : SupportedMibData( dataOids )
+        , mRowSearchColumnOids( rowSearchColumnOids.to_vector() )
+        , mLastUpdateOid( lastUpdateOid )
         , mFoundRowIndex( -1 )
         , mTableOids()
     {}
@@ -185,10 +200,21 @@ public:
 
     virtual vector<Oid> const & getDataOids() const { return mTableOids; }
 
+    /**
+     * @return oids of the data columns (without row index)
+     */
+    vector<Oid> const & getColumnOids() const { return mDataOids; }
+
     vector<Oid> const & getRowSearchColumnOids() const { return mRowSearchColumnOids; }
 
+    /**
+     * @return oid of the last update stamp of the searched table, empty when unknown
+     */
+    Oid const & getLastUpdateOid() const { return mLastUpdateOid; }
+
 protected:
     const vector<Oid> mRowSearchColumnOids;
+    const Oid mLastUpdateOid;
     long mFoundRowIndex;
     vector<Oid> mTableOids;
 
@@ -0,0 +1,190 @@
+/*
+ * Copyright 2010,2011 Matthias Haag, Jens Rehsack
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ *
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __SMART_SNMPD_NAGIOS_CHECKS_SNMP_SESSION_POOL_H_INCLUDED__
+#define __SMART_SNMPD_NAGIOS_CHECKS_SNMP_SESSION_POOL_H_INCLUDED__
+
+#include <smart-snmpd-nagios-plugins/snmp-pp-std.h>
+
+#include <map>
+#include <string>
+
+using namespace std;
+
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
+/**
+ * pool of idle snmp sessions and their targets
+ *
+ * A long running process (e.g. the check daemon) hosts many check
+ * applications after each other, usually querying the same hosts again
+ * and again. Instead of creating a new Snmp session and SnmpTarget for
+ * each check, SnmpComm borrows them from this pool and gives them back
+ * when it's destroyed.
+ *
+ * Sessions are keyed by everything which influences the session and
+ * target setup (address, port, protocol version, credentials). A
+ * session is only used by one SnmpComm instance at a time.
+ */
+class SnmpSessionPool
+{
+public:
+    /**
+     * default constructor
+     *
+     * @param maxIdlePerKey - maximum number of idle sessions kept per key
+     */
+    SnmpSessionPool( unsigned maxIdlePerKey = 8 )
+        : mMaxIdlePerKey( maxIdlePerKey )
+        , mIdleSessions()
+    {
+#ifdef HAVE_PTHREAD
+        pthread_mutex_init( &mMutex, NULL );
+#endif
+    }
+
+    /**
+     * destructor - releases all idle sessions
+     */
+    virtual ~SnmpSessionPool()
+    {
+        for( SessionMapType::iterator i = mIdleSessions.begin(); i != mIdleSessions.end(); ++i )
+        {
+            delete i->second.mSnmp;
+            delete i->second.mTarget;
+        }
+        mIdleSessions.clear();
+#ifdef HAVE_PTHREAD
+        pthread_mutex_destroy( &mMutex );
+#endif
+    }
+
+    /**
+     * borrows an idle session for the given key
+     *
+     * @param key - session key as built by SnmpComm
+     * @param snmp - receives the snmp session on success
+     * @param target - receives the target on success
+     *
+     * @return true when an idle session has been found, false otherwise
+     */
+    bool acquire( string const &key, Snmp *&snmp, SnmpTarget *&target )
+    {
+        bool found = false;
+
+        lock();
+        SessionMapType::iterator i = mIdleSessions.find( key );
+        if( i != mIdleSessions.end() )
+        {
+            snmp = i->second.mSnmp;
+            target = i->second.mTarget;
+            mIdleSessions.erase( i );
+            found = true;
+        }
+        unlock();
+
+        return found;
+    }
+
+    /**
+     * gives a borrowed (or newly created) session back to the pool
+     *
+     * When there're already enough idle sessions for the given key,
+     * the session is destroyed instead of being kept.
+     *
+     * @param key - session key as built by SnmpComm
+     * @param snmp - the snmp session to give back
+     * @param target - the target belonging to the session
+     */
+    void release( string const &key, Snmp *snmp, SnmpTarget *target )
+    {
+        bool keep = false;
+
+        lock();
+        if( mIdleSessions.count( key ) < mMaxIdlePerKey )
+        {
+            mIdleSessions.insert( make_pair( key, PooledSession( snmp, target ) ) );
+            keep = true;
+        }
+        unlock();
+
+        if( !keep )
+        {
+            delete snmp;
+            delete target;
+        }
+    }
+
+protected:
+    /**
+     * idle session entry
+     */
+    struct PooledSession
+    {
+        PooledSession( Snmp *snmp, SnmpTarget *target )
+            : mSnmp( snmp )
+            , mTarget( target )
+        {}
+
+        Snmp *mSnmp;
+        SnmpTarget *mTarget;
+    };
+
+    typedef multimap<string, PooledSession> SessionMapType;
+
+    /**
+     * maximum number of idle sessions per key
+     */
+    unsigned mMaxIdlePerKey;
+    /**
+     * idle sessions by their key
+     */
+    SessionMapType mIdleSessions;
+#ifdef HAVE_PTHREAD
+    /**
+     * protects mIdleSessions against concurrent access of worker threads
+     */
+    pthread_mutex_t mMutex;
+#endif
+
+    inline void lock()
+    {
+#ifdef HAVE_PTHREAD
+        pthread_mutex_lock( &mMutex );
+#endif
+    }
+
+    inline void unlock()
+    {
+#ifdef HAVE_PTHREAD
+        pthread_mutex_unlock( &mMutex );
+#endif
+    }
+
+private:
+    /**
+     * forbidden copy constructor
+     */
+    SnmpSessionPool( SnmpSessionPool const & );
+    /**
+     * forbidden assignment operator
+     */
+    SnmpSessionPool & operator = ( SnmpSessionPool const & );
+};
+
+#endif /* __SMART_SNMPD_NAGIOS_CHECKS_SNMP_SESSION_POOL_H_INCLUDED__ */
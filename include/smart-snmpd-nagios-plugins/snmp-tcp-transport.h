@@ -0,0 +1,401 @@
+/*
+ * Copyright 2010,2011 Matthias Haag, Jens Rehsack
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ *
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __SMART_SNMPD_NAGIOS_CHECKS_SNMP_TCP_TRANSPORT_H_INCLUDED__
+#define __SMART_SNMPD_NAGIOS_CHECKS_SNMP_TCP_TRANSPORT_H_INCLUDED__
+
+#include <smart-snmpd-nagios-plugins/snmp-pp-std.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netdb.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <string>
+
+using namespace std;
+
+#ifndef MSG_NOSIGNAL
+# define MSG_NOSIGNAL 0
+#endif
+
+#undef loggerModuleName
+#define loggerModuleName "nagiosplugins.snmptcptransport"
+
+/**
+ * largest message sent or received over tcp - limited by the message
+ * buffers of SNMP++ (MAX_SNMP_PACKET, usually 4096 bytes), not by the
+ * transport. Rebuild SNMP++ with a larger MAX_SNMP_PACKET to get larger
+ * get-bulk responses over tcp.
+ */
+static const int TcpMaxMsgSize = MAX_SNMP_PACKET;
+
+/**
+ * sends snmp messages over a persistent tcp connection (RFC 3430)
+ *
+ * Each message is sent as it would be sent in a udp datagram, the
+ * messages are delimited by their BER encoded length. Only community
+ * based targets (SNMPv1/v2c) are supported - SNMPv3 messages need the
+ * message processing of the Snmp session.
+ */
+class SnmpTcpTransport
+{
+public:
+    /**
+     * constructor - the connection is established by the first request
+     *
+     * @param host - printable address of the agent (without port)
+     * @param port - tcp port the agent listens on
+     */
+    SnmpTcpTransport( string const &host, unsigned short port )
+        : mFd( -1 )
+        , mHost( host )
+        , mPort( port )
+        , mRequestId( static_cast<unsigned long>( time( NULL ) ) & 0x7FFFFF )
+    {}
+
+    virtual ~SnmpTcpTransport()
+    {
+        close();
+    }
+
+    /**
+     * connects to the agent
+     *
+     * @param timeout_ms - milliseconds to wait for the connection
+     *
+     * @return SNMP_CLASS_SUCCESS, SNMP_CLASS_TIMEOUT or SNMP_CLASS_TL_FAILED
+     */
+    int connect( long timeout_ms )
+    {
+        struct addrinfo hints, *res = NULL;
+        char service[8];
+
+        close();
+
+        memset( &hints, 0, sizeof(hints) );
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = AI_NUMERICHOST;
+        snprintf( service, sizeof(service), "%u", (unsigned)mPort );
+
+        if( 0 != getaddrinfo( mHost.c_str(), service, &hints, &res ) )
+            return SNMP_CLASS_TL_FAILED;
+
+        int rc = SNMP_CLASS_TL_FAILED;
+        if( -1 != ( mFd = ::socket( res->ai_family, res->ai_socktype, res->ai_protocol ) ) )
+        {
+            fcntl( mFd, F_SETFL, fcntl( mFd, F_GETFL ) | O_NONBLOCK );
+
+            if( ( 0 == ::connect( mFd, res->ai_addr, res->ai_addrlen ) ) || ( EINPROGRESS == errno ) )
+                rc = wait_for( mFd, POLLOUT, now_ms() + timeout_ms );
+
+            if( SNMP_CLASS_SUCCESS == rc )
+            {
+                int err = 0;
+                socklen_t len = sizeof(err);
+                if( ( 0 != getsockopt( mFd, SOL_SOCKET, SO_ERROR, &err, &len ) ) || ( 0 != err ) )
+                    rc = SNMP_CLASS_TL_FAILED;
+            }
+
+            if( SNMP_CLASS_SUCCESS == rc )
+            {
+                int one = 1;
+                setsockopt( mFd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one) );
+            }
+            else
+            {
+                close();
+            }
+        }
+
+        freeaddrinfo( res );
+
+        SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 5 );
+        LOG( "SnmpTcpTransport::connect: host, port, rc" );
+        LOG( mHost.c_str() );
+        LOG( mPort );
+        LOG( rc );
+        LOG_END;
+
+        return rc;
+    }
+
+    /**
+     * closes the connection
+     */
+    void close()
+    {
+        if( -1 != mFd )
+        {
+            ::close( mFd );
+            mFd = -1;
+        }
+    }
+
+    /**
+     * @return true while connected
+     */
+    bool is_connected() const { return -1 != mFd; }
+
+    /**
+     * sends a request and receives the response, reconnects once when the connection was lost
+     *
+     * @param pdu - the request, receives the response
+     * @param target - community based target (timeout and retries are used for the deadline)
+     * @param type - sNMP_PDU_GET, sNMP_PDU_GETNEXT or sNMP_PDU_GETBULK
+     * @param non_reps - non-repeaters of get-bulk requests
+     * @param max_reps - max-repetitions of get-bulk requests
+     * @param deadline - now_ms() to give up at, 0 to derive it from the timeout and retries of target
+     *
+     * @return SNMP_CLASS_SUCCESS, the error status of the response or a SNMP_CLASS_* error
+     */
+    int request( Pdu &pdu, CTarget const &target, unsigned short type, int non_reps = 0, int max_reps = 0, long long deadline = 0 )
+    {
+        OctetStr community;
+        target.get_readcommunity( community );
+
+        // SNMPv1 knows no get-bulk - the Snmp session sends get-next then as well
+        if( ( sNMP_PDU_GETBULK == type ) && ( version1 == target.get_version() ) )
+            type = sNMP_PDU_GETNEXT;
+
+        Pdu request( pdu );
+        request.set_type( type );
+        request.set_request_id( ++mRequestId );
+        if( sNMP_PDU_GETBULK == type )
+        {
+            request.set_error_status( non_reps );
+            request.set_error_index( max_reps );
+        }
+
+        SnmpMessage msg;
+        if( SNMP_CLASS_SUCCESS != msg.load( request, community, target.get_version() ) )
+            return SNMP_CLASS_INTERNAL_ERROR;
+
+        // retransmissions are up to tcp - the retries extend the deadline only
+        if( 0 == deadline )
+            deadline = now_ms() + 10LL * target.get_timeout() * ( target.get_retry() + 1 );
+
+        int rc = SNMP_CLASS_TL_FAILED;
+        for( int attempt = 0; ( attempt < 2 ) && ( SNMP_CLASS_TL_FAILED == rc ); ++attempt )
+        {
+            if( !is_connected() && ( SNMP_CLASS_SUCCESS != ( rc = connect( deadline - now_ms() ) ) ) )
+                continue;
+
+            rc = send_message( mFd, msg.data(), msg.len(), deadline );
+            if( SNMP_CLASS_SUCCESS == rc )
+                rc = receive_response( pdu, deadline );
+            if( SNMP_CLASS_SUCCESS > rc )
+                close();
+        }
+
+        return rc;
+    }
+
+    /**
+     * @return milliseconds since the epoch
+     */
+    static long long now_ms()
+    {
+        struct timeval tv;
+        gettimeofday( &tv, NULL );
+        return tv.tv_sec * 1000LL + tv.tv_usec / 1000;
+    }
+
+    /**
+     * sends one encoded message
+     *
+     * @param fd - connected stream socket
+     * @param data - the BER encoded message
+     * @param len - length of the message
+     * @param deadline - now_ms() to give up at, negative to wait forever
+     *
+     * @return SNMP_CLASS_SUCCESS, SNMP_CLASS_TIMEOUT or SNMP_CLASS_TL_FAILED
+     */
+    static int send_message( int fd, unsigned char const *data, unsigned long len, long long deadline )
+    {
+        while( len > 0 )
+        {
+            int rc = wait_for( fd, POLLOUT, deadline );
+            if( SNMP_CLASS_SUCCESS != rc )
+                return rc;
+
+            ssize_t sent = ::send( fd, data, len, MSG_NOSIGNAL );
+            if( ( -1 == sent ) && ( ( EINTR == errno ) || ( EAGAIN == errno ) ) )
+                continue;
+            if( sent <= 0 )
+                return SNMP_CLASS_TL_FAILED;
+
+            data += sent;
+            len -= sent;
+        }
+
+        return SNMP_CLASS_SUCCESS;
+    }
+
+    /**
+     * receives one message, delimited by its BER encoded length
+     *
+     * @param fd - connected stream socket
+     * @param msg - receives the BER encoded message
+     * @param deadline - now_ms() to give up at, negative to wait forever
+     *
+     * @return SNMP_CLASS_SUCCESS, SNMP_CLASS_TIMEOUT or SNMP_CLASS_TL_FAILED
+     */
+    static int receive_message( int fd, string &msg, long long deadline )
+    {
+        unsigned char head[6];
+        int rc;
+
+        // SEQUENCE tag and first length octet
+        if( SNMP_CLASS_SUCCESS != ( rc = receive_all( fd, head, 2, deadline ) ) )
+            return rc;
+        if( 0x30 != head[0] )
+            return SNMP_CLASS_TL_FAILED;
+
+        unsigned long headLen = 2, bodyLen = head[1];
+        if( head[1] & 0x80 )
+        {
+            unsigned lenOctets = head[1] & 0x7F;
+            if( ( 0 == lenOctets ) || ( lenOctets > sizeof(head) - 2 ) )
+                return SNMP_CLASS_TL_FAILED;
+            if( SNMP_CLASS_SUCCESS != ( rc = receive_all( fd, head + 2, lenOctets, deadline ) ) )
+                return rc;
+
+            bodyLen = 0;
+            for( unsigned i = 0; i < lenOctets; ++i )
+                bodyLen = ( bodyLen << 8 ) | head[2 + i];
+            headLen += lenOctets;
+        }
+
+        if( headLen + bodyLen > (unsigned long)TcpMaxMsgSize )
+            return SNMP_CLASS_TL_FAILED;
+
+        msg.assign( reinterpret_cast<char *>( head ), headLen );
+        msg.resize( headLen + bodyLen );
+
+        return receive_all( fd, reinterpret_cast<unsigned char *>( &msg[headLen] ), bodyLen, deadline );
+    }
+
+protected:
+    int mFd;
+    string mHost;
+    unsigned short mPort;
+    unsigned long mRequestId;
+
+    /**
+     * receives messages until the response to the last request arrives
+     *
+     * Responses to earlier requests (which timed out) are skipped.
+     */
+    int receive_response( Pdu &pdu, long long deadline )
+    {
+        for(;;)
+        {
+            string data;
+            int rc = receive_message( mFd, data, deadline );
+            if( SNMP_CLASS_SUCCESS != rc )
+                return rc;
+
+            SnmpMessage msg;
+            Pdu response;
+            OctetStr community;
+            snmp_version version;
+            if( ( SNMP_CLASS_SUCCESS != msg.load( reinterpret_cast<unsigned char const *>( data.data() ), data.length() ) ) ||
+                ( SNMP_CLASS_SUCCESS != msg.unload( response, community, version ) ) )
+            {
+                return SNMP_CLASS_TL_FAILED;
+            }
+
+            if( response.get_request_id() != mRequestId )
+            {
+                SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 5 );
+                LOG( "SnmpTcpTransport: skipping late response" );
+                LOG( response.get_request_id() );
+                LOG_END;
+
+                continue;
+            }
+
+            pdu = response;
+
+            return response.get_error_status() ? response.get_error_status() : SNMP_CLASS_SUCCESS;
+        }
+    }
+
+    static int receive_all( int fd, unsigned char *buf, unsigned long len, long long deadline )
+    {
+        while( len > 0 )
+        {
+            int rc = wait_for( fd, POLLIN, deadline );
+            if( SNMP_CLASS_SUCCESS != rc )
+                return rc;
+
+            ssize_t got = ::recv( fd, buf, len, 0 );
+            if( ( -1 == got ) && ( ( EINTR == errno ) || ( EAGAIN == errno ) ) )
+                continue;
+            if( got <= 0 )
+                return SNMP_CLASS_TL_FAILED;
+
+            buf += got;
+            len -= got;
+        }
+
+        return SNMP_CLASS_SUCCESS;
+    }
+
+    static int wait_for( int fd, short events, long long deadline )
+    {
+        for(;;)
+        {
+            struct pollfd pfd;
+            pfd.fd = fd;
+            pfd.events = events;
+            pfd.revents = 0;
+
+            long long wait = ( deadline < 0 ) ? -1 : deadline - now_ms();
+            if( ( deadline >= 0 ) && ( wait <= 0 ) )
+                return SNMP_CLASS_TIMEOUT;
+
+            int rc = poll( &pfd, 1, static_cast<int>( wait ) );
+            if( ( -1 == rc ) && ( EINTR == errno ) )
+                continue;
+            if( 0 == rc )
+                return SNMP_CLASS_TIMEOUT;
+            if( ( rc < 0 ) || ( pfd.revents & ( POLLERR | POLLNVAL ) ) )
+                return SNMP_CLASS_TL_FAILED;
+
+            return SNMP_CLASS_SUCCESS;
+        }
+    }
+
+private:
+    SnmpTcpTransport( SnmpTcpTransport const & );
+    SnmpTcpTransport & operator = ( SnmpTcpTransport const & );
+};
+
+#undef loggerModuleName
+
+#endif /* __SMART_SNMPD_NAGIOS_CHECKS_SNMP_TCP_TRANSPORT_H_INCLUDED__ */
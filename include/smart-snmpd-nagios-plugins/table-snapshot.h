@@ -0,0 +1,531 @@
+/*
+ * Copyright 2010,2011 Matthias Haag, Jens Rehsack
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ *
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __SMART_SNMPD_NAGIOS_CHECKS_TABLE_SNAPSHOT_H_INCLUDED__
+#define __SMART_SNMPD_NAGIOS_CHECKS_TABLE_SNAPSHOT_H_INCLUDED__
+
+#include <smart-snmpd-nagios-plugins/snmp-pp-std.h>
+#include <smart-snmpd-nagios-plugins/vb-cache.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+#undef loggerModuleName
+#define loggerModuleName "nagiosplugins.tablesnapshot"
+
+/**
+ * snapshot of a walked table, valid as long as the agent didn't update it
+ *
+ * smart-snmpd refreshes its tables periodically and publishes the time
+ * of the last refresh (SM_LAST_UPDATE_*). A snapshot stores the rows of
+ * a walk together with that stamp - as long as the agent reports the same
+ * stamp, the rows are taken from the snapshot instead of walking again.
+ *
+ * Each snapshot is a file of its own, replaced atomically by rename(), so
+ * concurrent plugins never see a partially written one and need no locks.
+ * Rows are written while walking and read back one by one, so neither
+ * needs memory growing with the size of the table. A trailer holding the
+ * row count and a checksum of the file lets replay() validate the whole
+ * snapshot before passing the first row on.
+ */
+class TableSnapshot
+{
+public:
+    static const uint32_t FormatVersion = 2;
+    static const size_t TrailerSize = sizeof(uint32_t) + sizeof(uint64_t);
+
+    /**
+     * passes the rows of a snapshot to a functor
+     *
+     * @param fileName - path of the snapshot file
+     * @param stamp - last update stamp reported by the agent
+     * @param columns - number of columns of each row
+     * @param f - functor receiving each row as vector<Vb>, returns true to stop
+     *
+     * @return true when the snapshot exists, is intact and was taken at stamp, false otherwise
+     */
+    template < class F >
+    static bool replay( string const &fileName, string const &stamp, size_t columns, F &f )
+    {
+        // the file stays open - a snapshot renamed over it meanwhile doesn't matter
+        Reader reader( fileName );
+        uint32_t rowCount;
+        if( !validate( reader, fileName, stamp, columns, rowCount ) || !reader.rewind() || !read_header( reader, stamp, columns ) )
+            return false;
+
+        vector<Vb> row( columns );
+        for( uint32_t r = 0; r < rowCount; ++r )
+        {
+            for( size_t c = 0; c < columns; ++c )
+            {
+                if( !reader.get_vb( row[c] ) )
+                    return false; // unreachable - the validated file is never modified, only replaced by rename()
+            }
+
+            if( f( row ) )
+                break;
+        }
+
+        return true;
+    }
+
+    /**
+     * writes a snapshot while the table is walked
+     *
+     * The snapshot becomes visible by commit() only - a writer destroyed
+     * before (the walk failed or was stopped early) leaves no file behind.
+     */
+    class Writer
+    {
+    public:
+        /**
+         * @param fileName - path of the snapshot file
+         * @param stamp - last update stamp reported by the agent before walking
+         * @param columns - number of columns of each row
+         */
+        Writer( string const &fileName, string const &stamp, size_t columns )
+            : mFileName( fileName )
+            , mTmpName()
+            , mFd( -1 )
+            , mColumns( columns )
+            , mRowCount( 0 )
+            , mChecksum( ChecksumInit )
+            , mBuf()
+        {
+            string::size_type pos = fileName.find_last_of( '/' );
+            if( pos != string::npos )
+                make_directories( fileName.substr( 0, pos ) ); // creating the file fails and reports otherwise
+
+            // the snapshots contain table values, they are shared with the group only
+            mFd = create_unique_file( fileName, 0660, mTmpName );
+            if( -1 == mFd )
+            {
+                SSNC_LOG_BEGIN( loggerModuleName, WARNING_LOG | 1 );
+                LOG( "Can't create table snapshot" );
+                LOG( fileName.c_str() );
+                LOG( strerror(errno) );
+                LOG_END;
+                return;
+            }
+
+            mBuf.assign( "SSNCSNP", 8 );
+            put_uint32( mBuf, FormatVersion );
+            put_string( mBuf, stamp );
+            put_uint32( mBuf, columns );
+        }
+
+        ~Writer() { abort(); }
+
+        /**
+         * appends a row - a row which isn't representable discards the snapshot
+         *
+         * @param row - vector<Vb> or SnmpTableRow
+         */
+        template < class Row >
+        void add( Row const &row )
+        {
+            if( -1 == mFd )
+                return;
+
+            for( size_t c = 0; c < mColumns; ++c )
+            {
+                if( ( c >= row.size() ) || !put_vb( mBuf, row[c] ) )
+                {
+                    abort();
+                    return;
+                }
+            }
+            ++mRowCount;
+
+            if( ( mBuf.length() >= 8192 ) && !flush() )
+                abort();
+        }
+
+        /**
+         * publishes the snapshot
+         */
+        void commit()
+        {
+            if( -1 == mFd )
+                return;
+
+            // the checksum covers everything before it, including the row count
+            put_uint32( mBuf, mRowCount );
+            bool ok = flush();
+            uint64_t sum = mChecksum;
+            mBuf.assign( reinterpret_cast<const char *>( &sum ), sizeof(sum) );
+            if( !ok || !flush() )
+            {
+                abort();
+                return;
+            }
+
+            close( mFd );
+            mFd = -1;
+
+            if( 0 != rename( mTmpName.c_str(), mFileName.c_str() ) )
+                unlink( mTmpName.c_str() );
+        }
+
+        /**
+         * discards the snapshot
+         */
+        void abort()
+        {
+            if( -1 == mFd )
+                return;
+
+            close( mFd );
+            mFd = -1;
+            unlink( mTmpName.c_str() );
+        }
+
+    protected:
+        string mFileName;
+        string mTmpName;
+        int mFd;
+        size_t mColumns;
+        uint32_t mRowCount;
+        uint64_t mChecksum;
+        string mBuf;
+
+        /**
+         * writes the buffer, adding it to the checksum
+         */
+        bool flush()
+        {
+            mChecksum = checksum( mChecksum, mBuf.data(), mBuf.length() );
+
+            for( size_t off = 0; off < mBuf.length(); )
+            {
+                ssize_t n = write( mFd, mBuf.data() + off, mBuf.length() - off );
+                if( n > 0 )
+                    off += n;
+                else if( ( -1 == n ) && ( EINTR == errno ) )
+                    continue;
+                else
+                    return false;
+            }
+
+            mBuf.erase();
+            return true;
+        }
+
+    private:
+        Writer( Writer const & );
+        Writer & operator = ( Writer const & );
+    };
+
+protected:
+    static const uint64_t ChecksumInit = 14695981039346656037ULL;
+
+    /**
+     * continues the 64 bit FNV-1a hash sum over len bytes of data
+     */
+    static uint64_t checksum( uint64_t sum, char const *data, size_t len )
+    {
+        for( size_t i = 0; i < len; ++i )
+        {
+            sum ^= static_cast<unsigned char>( data[i] );
+            sum *= 1099511628211ULL;
+        }
+        return sum;
+    }
+
+    class Reader;
+
+    /**
+     * reads and checks the header of a snapshot
+     *
+     * @return true when the snapshot was taken at stamp with the given number of columns
+     */
+    static bool read_header( Reader &reader, string const &stamp, size_t columns )
+    {
+        string magic, fileStamp;
+        uint32_t version, fileColumns;
+
+        return reader.get_bytes( 8, magic ) && ( 0 == memcmp( magic.data(), "SSNCSNP", 8 ) ) &&
+               reader.get_uint32( version ) && ( FormatVersion == version ) &&
+               reader.get_string( fileStamp ) && ( fileStamp == stamp ) &&
+               reader.get_uint32( fileColumns ) && ( columns == fileColumns );
+    }
+
+    /**
+     * checks a snapshot completely - row structure, row count and checksum
+     *
+     * Neither a snapshot taken at another stamp nor a corrupt one is
+     * removed - the path might refer to a fresh snapshot renamed into place
+     * meanwhile, so the next writer replaces it by rename().
+     *
+     * @param reader - reader of the snapshot, positioned at its beginning
+     * @param rowCount - receives the number of rows
+     *
+     * @return true when the snapshot can be replayed
+     */
+    static bool validate( Reader &reader, string const &fileName, string const &stamp, size_t columns, uint32_t &rowCount )
+    {
+        if( !reader.isOpen() || ( 0 == columns ) || !read_header( reader, stamp, columns ) )
+            return false;
+
+        Vb vb;
+        uint32_t rows = 0;
+        bool ok = true;
+        while( ok && ( reader.remaining() > TrailerSize ) )
+        {
+            for( size_t c = 0; ok && ( c < columns ); ++c )
+                ok = reader.get_vb( vb );
+            ++rows;
+        }
+
+        uint64_t sum = 0;
+        if( ok )
+        {
+            ok = reader.get_uint32( rowCount ) && ( rows == rowCount );
+            uint64_t expected = reader.checksum();
+            ok = ok && reader.get_uint64( sum ) && ( sum == expected ) && ( 0 == reader.remaining() );
+        }
+
+        if( !ok )
+        {
+            SSNC_LOG_BEGIN( loggerModuleName, WARNING_LOG | 1 );
+            LOG( "Ignoring corrupt table snapshot" );
+            LOG( fileName.c_str() );
+            LOG_END;
+        }
+
+        return ok;
+    }
+
+    /**
+     * reads a snapshot file in chunks
+     */
+    class Reader
+    {
+    public:
+        explicit Reader( string const &fileName )
+            : mFd( open( fileName.c_str(), O_RDONLY ) )
+            , mSize( 0 )
+            , mConsumed( 0 )
+            , mChecksum( ChecksumInit )
+            , mBuf()
+            , mPos( 0 )
+        {
+            struct stat st;
+            if( ( -1 != mFd ) && ( 0 == fstat( mFd, &st ) ) )
+                mSize = st.st_size;
+        }
+
+        bool isOpen() const { return -1 != mFd; }
+
+        /**
+         * restarts reading at the beginning of the file
+         */
+        bool rewind()
+        {
+            if( ( -1 == mFd ) || ( 0 != lseek( mFd, 0, SEEK_SET ) ) )
+                return false;
+
+            mConsumed = 0;
+            mChecksum = ChecksumInit;
+            mBuf.erase();
+            mPos = 0;
+
+            return true;
+        }
+
+        /**
+         * @return number of bytes not consumed yet
+         */
+        uint64_t remaining() const { return mSize - mConsumed; }
+
+        /**
+         * @return checksum of the bytes consumed so far
+         */
+        uint64_t checksum() const { return mChecksum; }
+
+        ~Reader()
+        {
+            if( -1 != mFd )
+                close( mFd );
+        }
+
+        bool get_bytes( size_t len, string &bytes )
+        {
+            if( !ensure( len ) )
+                return false;
+
+            bytes.assign( mBuf, mPos, len );
+            consume( len );
+
+            return true;
+        }
+
+        bool get_uint32( uint32_t &u )
+        {
+            if( !ensure( sizeof(u) ) )
+                return false;
+
+            memcpy( &u, mBuf.data() + mPos, sizeof(u) );
+            consume( sizeof(u) );
+
+            return true;
+        }
+
+        bool get_uint64( uint64_t &u )
+        {
+            if( !ensure( sizeof(u) ) )
+                return false;
+
+            memcpy( &u, mBuf.data() + mPos, sizeof(u) );
+            consume( sizeof(u) );
+
+            return true;
+        }
+
+        bool get_string( string &s )
+        {
+            uint32_t len;
+            return get_uint32( len ) && get_bytes( len, s );
+        }
+
+        bool get_vb( Vb &vb )
+        {
+            uint32_t oidLen, syntax;
+            if( !get_uint32( oidLen ) || ( 0 == oidLen ) || ( oidLen > 128 ) )
+                return false;
+
+            unsigned long ids[128];
+            for( uint32_t i = 0; i < oidLen; ++i )
+            {
+                uint32_t id;
+                if( !get_uint32( id ) )
+                    return false;
+                ids[i] = id;
+            }
+
+            string value;
+            if( !get_uint32( syntax ) || !get_string( value ) )
+                return false;
+
+            vb.set_oid( Oid( ids, oidLen ) );
+            if( ( sNMP_SYNTAX_NOSUCHOBJECT == syntax ) || ( sNMP_SYNTAX_NOSUCHINSTANCE == syntax ) || ( sNMP_SYNTAX_NULL == syntax ) )
+            {
+                vb.set_syntax( syntax );
+                return true;
+            }
+
+            return VbCache::decode_value( syntax, reinterpret_cast<const unsigned char *>( value.data() ), value.length(), vb );
+        }
+
+    protected:
+        int mFd;
+        uint64_t mSize;
+        uint64_t mConsumed;
+        uint64_t mChecksum;
+        string mBuf;
+        size_t mPos;
+
+        void consume( size_t len )
+        {
+            mChecksum = TableSnapshot::checksum( mChecksum, mBuf.data() + mPos, len );
+            mConsumed += len;
+            mPos += len;
+        }
+
+        /**
+         * makes len bytes available at mPos
+         */
+        bool ensure( size_t len )
+        {
+            if( mBuf.length() - mPos >= len )
+                return true;
+            if( -1 == mFd )
+                return false;
+
+            mBuf.erase( 0, mPos );
+            mPos = 0;
+
+            char chunk[8192];
+            while( mBuf.length() < len )
+            {
+                ssize_t n = read( mFd, chunk, sizeof(chunk) );
+                if( n > 0 )
+                    mBuf.append( chunk, n );
+                else if( ( -1 == n ) && ( EINTR == errno ) )
+                    continue;
+                else
+                    return false;
+            }
+
+            return true;
+        }
+
+    private:
+        Reader( Reader const & );
+        Reader & operator = ( Reader const & );
+    };
+
+    static void put_uint32( string &buf, uint32_t u )
+    {
+        buf.append( reinterpret_cast<const char *>( &u ), sizeof(u) );
+    }
+
+    static void put_string( string &buf, string const &s )
+    {
+        put_uint32( buf, s.length() );
+        buf.append( s );
+    }
+
+    static bool put_vb( string &buf, Vb const &vb )
+    {
+        Oid oid;
+        vb.get_oid( oid );
+        string value;
+        uint32_t syntax;
+
+        if( !VbCache::encode_value( vb, syntax, value ) )
+        {
+            // keep the exceptions (noSuchInstance, ...) the walk returned
+            syntax = vb.get_syntax();
+            if( ( sNMP_SYNTAX_NOSUCHOBJECT != syntax ) && ( sNMP_SYNTAX_NOSUCHINSTANCE != syntax ) && ( sNMP_SYNTAX_NULL != syntax ) )
+                return false;
+            value.erase();
+        }
+
+        put_uint32( buf, oid.len() );
+        for( unsigned long i = 0; i < oid.len(); ++i )
+            put_uint32( buf, oid[i] );
+        put_uint32( buf, syntax );
+        put_string( buf, value );
+
+        return true;
+    }
+};
+
+#undef loggerModuleName
+
+#endif /* __SMART_SNMPD_NAGIOS_CHECKS_TABLE_SNAPSHOT_H_INCLUDED__ */
@@ -0,0 +1,546 @@
+/*
+ * Copyright 2010,2011 Matthias Haag, Jens Rehsack
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ *
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __SMART_SNMPD_NAGIOS_CHECKS_VB_CACHE_H_INCLUDED__
+#define __SMART_SNMPD_NAGIOS_CHECKS_VB_CACHE_H_INCLUDED__
+
+#include <smart-snmpd-nagios-plugins/snmp-pp-std.h>
+#include <smart-snmpd-nagios-plugins/host-state-store.h>
+
+#include <stdlib.h>
+
+#include <string>
+#include <vector>
+#include <utility>
+
+using namespace std;
+
+#undef loggerModuleName
+#define loggerModuleName "nagiosplugins.vbcache"
+
+/**
+ * value of one object fetched by a plugin, shared with the other plugins
+ *
+ * Plain old data - it's directly stored in the memory mapped file.
+ */
+struct VbCacheRecord
+{
+    static const uint32_t FormatVersion = 1;
+    static const uint32_t SlotCount = 65536;
+    static const mode_t FileMode = 0660;
+    static const char * fileName() { return "vb-cache.db"; }
+
+    static const uint32_t MaxValueLength = 232;
+
+    /**
+     * hash of the host key and the oid, 0 for an unused slot
+     */
+    uint64_t mKey;
+    /**
+     * time the value was fetched
+     */
+    time_t mUpdated;
+    /**
+     * syntax of the value
+     */
+    uint32_t mSyntax;
+    /**
+     * length of the encoded value
+     */
+    uint32_t mLength;
+    /**
+     * encoded value
+     */
+    unsigned char mValue[MaxValueLength];
+};
+
+/**
+ * store of the values shared between the plugins
+ */
+typedef PersistentRecordStore<VbCacheRecord> VbCacheStore;
+
+/**
+ * cache of fetched values shared by all plugins querying the same host
+ *
+ * Values are cached only for the subtrees configured with --cache-ttl.
+ * Counters and time ticks (e.g. sysUpTime.0, which detects agent
+ * restarts) are used to compute deltas between runs, so the default ttl
+ * doesn't apply to them - they're cached only below a configured subtree.
+ * Each value is stored in its own slot of VbCacheStore, so concurrent
+ * plugins only contend when accessing neighbouring slots.
+ *
+ * Plugins mostly request different objects of the same subtree, thus a
+ * value missing below a configured subtree makes SnmpComm walk and cache
+ * the whole subtree (up to MaxPrefetchValues values) once per run.
+ */
+class VbCache
+{
+public:
+    /**
+     * maximum number of values cached by the walk of a subtree
+     */
+    static const unsigned long MaxPrefetchValues = 1024;
+
+    /**
+     * default constructor
+     */
+    VbCache()
+        : mStore(0)
+        , mHostKey()
+        , mDefaultTtl(0)
+        , mSubtreeTtls()
+        , mPrefetched()
+    {}
+
+    /**
+     * destructor
+     */
+    virtual ~VbCache() {}
+
+    /**
+     * adds the cache options to the given options_description instance
+     *
+     * @param opts - options_description instance to add the cache options to
+     */
+    static void add_cache_options(options_description &opts)
+    {
+        opts.add_options()
+            ("cache-ttl", value< vector<string> >()->composing(),
+                "seconds to reuse values fetched by other plugins: [OID=]SECONDS, "
+                "the most specific subtree wins, counters and time ticks are reused "
+                "below a given OID only (repeatable, disabled by default)")
+            ;
+    }
+
+    /**
+     * configures the cache for a host
+     *
+     * @param vm - map of values specified on command line
+     * @param hostKey - string identifying the host, must not contain secrets, empty to disable the store
+     */
+    void configure(variables_map const &vm, string const &hostKey)
+    {
+        mHostKey = hostKey;
+        mDefaultTtl = 0;
+        mSubtreeTtls.clear();
+        mPrefetched.clear();
+        mStore = 0;
+
+        if( 0 == vm.count("cache-ttl") )
+            return;
+
+        vector<string> const &ttls = vm["cache-ttl"].as< vector<string> >();
+        for( vector<string>::const_iterator ci = ttls.begin(); ci != ttls.end(); ++ci )
+        {
+            string::size_type pos = ci->find( '=' );
+            string seconds = ( pos == string::npos ) ? *ci : ci->substr( pos + 1 );
+            char *end = NULL;
+            unsigned long ttl = strtoul( seconds.c_str(), &end, 10 );
+
+            if( seconds.empty() || ( 0 != *end ) )
+                throw validation_error( validation_error::invalid_option_value, *ci, "cache-ttl" );
+
+            if( pos == string::npos )
+            {
+                mDefaultTtl = ttl;
+            }
+            else
+            {
+                Oid subtree( ci->substr( 0, pos ).c_str() );
+                if( !subtree.valid() )
+                    throw validation_error( validation_error::invalid_option_value, *ci, "cache-ttl" );
+                mSubtreeTtls.push_back( make_pair( subtree, ttl ) );
+            }
+        }
+
+        if( vm.count("cache-dir") && !mHostKey.empty() )
+            mStore = VbCacheStore::instance( vm["cache-dir"].as<string>() );
+    }
+
+    /**
+     * @return true when values might be cached at all
+     */
+    inline bool enabled() const { return 0 != mStore; }
+
+    /**
+     * looks up a value fetched before
+     *
+     * @param vb - the varbind to look up, receives the value when found
+     *
+     * @return true when a value younger than the ttl of its subtree was found
+     */
+    bool lookup(Vb &vb) const
+    {
+        if( !enabled() )
+            return false;
+
+        Oid oid;
+        vb.get_oid( oid );
+        if( 0 == get_ttl( oid, sNMP_SYNTAX_NULL ) )
+            return false;
+
+        VbCacheRecord rec;
+        if( !mStore->load( make_key( oid ), rec ) )
+            return false;
+
+        // the syntax is known now - counters and time ticks don't get the default ttl
+        unsigned long ttl = get_ttl( oid, rec.mSyntax );
+        if( ( 0 == ttl ) ||
+            ( static_cast<unsigned long>( time( NULL ) - rec.mUpdated ) > ttl ) ||
+            !decode( rec, vb ) )
+        {
+            return false;
+        }
+
+        SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 13 );
+        LOG( "lookup: cached" );
+        LOG( vb.get_printable_oid() );
+        LOG_END;
+
+        return true;
+    }
+
+    /**
+     * finds the configured subtree to walk for a value missing in the cache
+     *
+     * Each subtree is returned once only - afterwards it's expected to be
+     * cached as a whole.
+     *
+     * @param oid - oid of the missing value
+     * @param subtree - receives the most specific configured subtree containing oid
+     *
+     * @return true when subtree shall be walked, false when there's none or it was walked before
+     */
+    bool begin_prefetch(Oid const &oid, Oid &subtree)
+    {
+        if( !enabled() )
+            return false;
+
+        unsigned long matchLen = 0;
+        for( vector< pair<Oid, unsigned long> >::const_iterator ci = mSubtreeTtls.begin(); ci != mSubtreeTtls.end(); ++ci )
+        {
+            unsigned long len = ci->first.len();
+            if( ( len > matchLen ) && ( len <= oid.len() ) && ( 0 == ci->first.nCompare( len, oid ) ) )
+            {
+                subtree = ci->first;
+                matchLen = len;
+            }
+        }
+
+        if( ( 0 == matchLen ) || ( 0 == get_ttl( subtree, sNMP_SYNTAX_NULL ) ) )
+            return false;
+
+        for( vector<Oid>::const_iterator ci = mPrefetched.begin(); ci != mPrefetched.end(); ++ci )
+        {
+            if( *ci == subtree )
+                return false;
+        }
+        mPrefetched.push_back( subtree );
+
+        return true;
+    }
+
+    /**
+     * stores a fetched value for the other plugins
+     *
+     * @param vb - the fetched varbind
+     */
+    void store(Vb const &vb)
+    {
+        if( !enabled() )
+            return;
+
+        Oid oid;
+        vb.get_oid( oid );
+        if( 0 == get_ttl( oid, vb.get_syntax() ) )
+            return;
+
+        VbCacheRecord rec;
+        memset( &rec, 0, sizeof(rec) );
+        if( !encode( vb, rec ) )
+            return;
+
+        rec.mKey = make_key( oid );
+        mStore->save( rec );
+    }
+
+protected:
+    /**
+     * the shared store, NULL when caching is disabled
+     */
+    VbCacheStore *mStore;
+    /**
+     * string identifying the host and the credentials
+     */
+    string mHostKey;
+    /**
+     * ttl for objects without a configured subtree
+     */
+    unsigned long mDefaultTtl;
+    /**
+     * ttls of the configured subtrees
+     */
+    vector< pair<Oid, unsigned long> > mSubtreeTtls;
+    /**
+     * subtrees walked since configure()
+     */
+    vector<Oid> mPrefetched;
+
+    /**
+     * @param oid - oid of the value
+     * @param syntax - syntax of the value
+     *
+     * @return ttl of the most specific subtree containing oid, the default
+     *         ttl when there's none and the value isn't used for deltas
+     */
+    unsigned long get_ttl(Oid const &oid, uint32_t syntax) const
+    {
+        unsigned long ttl = is_delta_source( syntax ) ? 0 : mDefaultTtl, matchLen = 0;
+
+        for( vector< pair<Oid, unsigned long> >::const_iterator ci = mSubtreeTtls.begin(); ci != mSubtreeTtls.end(); ++ci )
+        {
+            unsigned long len = ci->first.len();
+            if( ( len > matchLen ) && ( len <= oid.len() ) && ( 0 == ci->first.nCompare( len, oid ) ) )
+            {
+                ttl = ci->second;
+                matchLen = len;
+            }
+        }
+
+        return ttl;
+    }
+
+    /**
+     * @return true when values of syntax are compared between runs
+     */
+    static inline bool is_delta_source(uint32_t syntax)
+    {
+        return ( sNMP_SYNTAX_CNTR32 == syntax ) || ( sNMP_SYNTAX_CNTR64 == syntax ) || ( sNMP_SYNTAX_TIMETICKS == syntax );
+    }
+
+    /**
+     * @return key of the value of oid on the configured host
+     */
+    uint64_t make_key(Oid const &oid) const
+    {
+        return VbCacheStore::make_key( mHostKey + "|" + oid.get_printable() );
+    }
+
+    /**
+     * encodes the value of vb into rec
+     *
+     * @return true when the value can be cached, false otherwise
+     */
+    static bool encode(Vb const &vb, VbCacheRecord &rec)
+    {
+        string value;
+        if( !encode_value( vb, rec.mSyntax, value ) || ( value.length() > VbCacheRecord::MaxValueLength ) )
+            return false;
+
+        rec.mLength = value.length();
+        if( !value.empty() )
+            memcpy( rec.mValue, value.data(), value.length() );
+
+        return true;
+    }
+
+    /**
+     * decodes the value stored in rec into vb
+     *
+     * @return true on success, false when rec is corrupt
+     */
+    static bool decode(VbCacheRecord const &rec, Vb &vb)
+    {
+        if( rec.mLength > VbCacheRecord::MaxValueLength )
+            return false;
+
+        return decode_value( rec.mSyntax, rec.mValue, rec.mLength, vb );
+    }
+
+public:
+    /**
+     * encodes the value of a varbind into a byte string
+     *
+     * @param vb - the varbind
+     * @param syntax - receives the syntax of the value
+     * @param value - receives the encoded value
+     *
+     * @return true when the value can be encoded, false otherwise
+     */
+    static bool encode_value(Vb const &vb, uint32_t &syntax, string &value)
+    {
+        syntax = vb.get_syntax();
+
+        switch( syntax )
+        {
+        case sNMP_SYNTAX_INT32:
+            {
+                SnmpInt32 i32;
+                if( SNMP_CLASS_SUCCESS != vb.get_value( i32 ) )
+                    return false;
+                long l = i32;
+                value.assign( reinterpret_cast<const char *>( &l ), sizeof(l) );
+                return true;
+            }
+
+        case sNMP_SYNTAX_CNTR32:
+        case sNMP_SYNTAX_GAUGE32:
+        case sNMP_SYNTAX_TIMETICKS:
+            {
+                SnmpUInt32 ui32;
+                if( SNMP_CLASS_SUCCESS != vb.get_value( ui32 ) )
+                    return false;
+                unsigned long ul = ui32;
+                value.assign( reinterpret_cast<const char *>( &ul ), sizeof(ul) );
+                return true;
+            }
+
+        case sNMP_SYNTAX_CNTR64:
+            {
+                Counter64 ui64;
+                if( SNMP_CLASS_SUCCESS != vb.get_value( ui64 ) )
+                    return false;
+                unsigned long long ull = ui64;
+                value.assign( reinterpret_cast<const char *>( &ull ), sizeof(ull) );
+                return true;
+            }
+
+        case sNMP_SYNTAX_OCTETS:
+            {
+                OctetStr octstr;
+                if( SNMP_CLASS_SUCCESS != vb.get_value( octstr ) )
+                    return false;
+                value.assign( reinterpret_cast<const char *>( octstr.data() ), octstr.len() );
+                return true;
+            }
+
+        case sNMP_SYNTAX_OID:
+            {
+                Oid oid;
+                if( SNMP_CLASS_SUCCESS != vb.get_value( oid ) || ( 0 == oid.len() ) )
+                    return false;
+                value.erase();
+                for( unsigned long i = 0; i < oid.len(); ++i )
+                {
+                    unsigned long id = oid[i];
+                    value.append( reinterpret_cast<const char *>( &id ), sizeof(id) );
+                }
+                return true;
+            }
+
+        case sNMP_SYNTAX_IPADDR:
+            {
+                IpAddress ip;
+                if( SNMP_CLASS_SUCCESS != vb.get_value( ip ) )
+                    return false;
+                value = ip.get_printable();
+                return true;
+            }
+
+        default:
+            // exceptions (noSuchObject, ...) and rarely used types aren't encoded
+            return false;
+        }
+    }
+
+    /**
+     * decodes a value encoded by encode_value() into a varbind
+     *
+     * @param syntax - syntax of the value
+     * @param data - the encoded value
+     * @param len - length of the encoded value
+     * @param vb - receives the value
+     *
+     * @return true on success, false when the encoded value is corrupt
+     */
+    static bool decode_value(uint32_t syntax, unsigned char const *data, size_t len, Vb &vb)
+    {
+        switch( syntax )
+        {
+        case sNMP_SYNTAX_INT32:
+            {
+                long l;
+                if( len != sizeof(l) )
+                    return false;
+                memcpy( &l, data, sizeof(l) );
+                vb.set_value( SnmpInt32( l ) );
+                return true;
+            }
+
+        case sNMP_SYNTAX_CNTR32:
+        case sNMP_SYNTAX_GAUGE32:
+        case sNMP_SYNTAX_TIMETICKS:
+            {
+                unsigned long ul;
+                if( len != sizeof(ul) )
+                    return false;
+                memcpy( &ul, data, sizeof(ul) );
+                if( sNMP_SYNTAX_CNTR32 == syntax )
+                    vb.set_value( Counter32( ul ) );
+                else if( sNMP_SYNTAX_GAUGE32 == syntax )
+                    vb.set_value( Gauge32( ul ) );
+                else
+                    vb.set_value( TimeTicks( ul ) );
+                return true;
+            }
+
+        case sNMP_SYNTAX_CNTR64:
+            {
+                unsigned long long ull;
+                if( len != sizeof(ull) )
+                    return false;
+                memcpy( &ull, data, sizeof(ull) );
+                vb.set_value( Counter64( ull ) );
+                return true;
+            }
+
+        case sNMP_SYNTAX_OCTETS:
+            vb.set_value( OctetStr( data, len ) );
+            return true;
+
+        case sNMP_SYNTAX_OID:
+            {
+                vector<unsigned long> ids( len / sizeof(unsigned long) );
+                if( ids.empty() || ( ids.size() * sizeof(unsigned long) != len ) )
+                    return false;
+                memcpy( &ids[0], data, len );
+                vb.set_value( Oid( &ids[0], ids.size() ) );
+                return true;
+            }
+
+        case sNMP_SYNTAX_IPADDR:
+            vb.set_value( IpAddress( string( reinterpret_cast<const char *>( data ), len ).c_str() ) );
+            return true;
+
+        default:
+            return false;
+        }
+    }
+
+private:
+    /**
+     * forbidden copy constructor
+     */
+    VbCache( VbCache const & );
+    /**
+     * forbidden assignment operator
+     */
+    VbCache & operator = ( VbCache const & );
+};
+
+#undef loggerModuleName
+
+#endif /* __SMART_SNMPD_NAGIOS_CHECKS_VB_CACHE_H_INCLUDED__ */
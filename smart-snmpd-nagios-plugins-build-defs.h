@@ -267,6 +267,25 @@ int flock(int fd, int op);
 # include <snmp_pp/config_snmp_pp.h>
 # include <snmp_pp/log.h>
 
+/*
+ * Log classes above SSNC_LOG_CLASS_MAX are removed at compile time - the
+ * condition of SSNC_LOG_BEGIN is constant, the compiler drops the whole
+ * log statement. Debug output is removed when configured with
+ * --disable-debug, override with -DSSNC_LOG_CLASS_MAX=WARNING_LOG etc.
+ */
+# ifndef _NO_LOGGING
+#  ifndef SSNC_LOG_CLASS_MAX
+#   ifdef _NDEBUG
+#    define SSNC_LOG_CLASS_MAX INFO_LOG
+#   else
+#    define SSNC_LOG_CLASS_MAX USER_LOG
+#   endif
+#  endif
+#  define SSNC_LOG_BEGIN(name,level) if( ( (level) & LOG_CLASS_MASK ) <= (SSNC_LOG_CLASS_MAX) ) LOG_BEGIN(name,level)
+# else
+#  define SSNC_LOG_BEGIN(name,level) LOG_BEGIN(name,level)
+# endif
+
 # ifdef _THREADS
 #  ifndef _WIN32THREADS
 #   include <pthread.h>
@@ -0,0 +1,163 @@
+/*
+ * Copyright 2010,2011 Matthias Haag, Jens Rehsack
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ *
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * benchmark of the command line setup of the check plugins
+ *
+ * Measures the time from argv to the stored and validated options of
+ * check_procs_by_snmp (the plugin with the most options) - once with
+ * boost's command line parser and once with parse_command_line_fast().
+ * Both have to result in the same options, a command line the fast path
+ * doesn't handle is reported:
+ *
+ *   make bench_cmdline
+ *   ./bench_cmdline -i 10000 -- -H 127.0.0.1 -C public -V 2C -P sshd -w 1: -c 1:
+ */
+
+#include "check_procs_by_snmp.h"
+
+#include <sys/time.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static double
+now()
+{
+    struct timeval tv;
+    gettimeofday( &tv, NULL );
+    return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+/**
+ * sets up the options from the command line like SnmpAppl::setupFromCommandLine()
+ */
+static void
+setup( int argc, char *argv[], bool fast, variables_map &vm )
+{
+    SnmpProcsCheckAppl checkAppl;
+    checkAppl.initSupportedSnmpDaemons();
+
+    options_description all = checkAppl.get_options();
+    parsed_options parsed( &all );
+    if( !fast || !parse_command_line_fast( argc, argv, all, parsed ) )
+        parsed = parse_command_line( argc, argv, all );
+    store( parsed, vm );
+    notify( vm );
+}
+
+/**
+ * @return description of the differences, empty when equal
+ */
+static string
+compare( variables_map const &a, variables_map const &b )
+{
+    string diff;
+    variables_map::const_iterator ai = a.begin(), bi = b.begin();
+    for( ; ( ai != a.end() ) && ( bi != b.end() ); ++ai, ++bi )
+    {
+        if( ai->first != bi->first )
+            break;
+        if( ( ai->second.defaulted() != bi->second.defaulted() ) ||
+            ( ai->second.value().type() != bi->second.value().type() ) )
+            diff += " " + ai->first;
+    }
+    if( ( ai != a.end() ) || ( bi != b.end() ) )
+        diff += " (different options)";
+
+    return diff;
+}
+
+int
+main(int argc, char *argv[])
+{
+    unsigned iterations = 1000;
+    int argi = 1;
+
+    if( ( argi + 1 < argc ) && ( string( "-i" ) == argv[argi] ) )
+    {
+        iterations = strtoul( argv[argi + 1], NULL, 10 );
+        argi += 2;
+    }
+
+    if( ( argi >= argc ) || ( string( "--" ) != argv[argi] ) || ( 0 == iterations ) )
+    {
+        cerr << "usage: " << argv[0] << " [-i ITERATIONS] -- PLUGIN-ARGUMENTS..." << endl;
+        return 255;
+    }
+
+    // the plugin arguments with the program name in front
+    vector<char *> args( argv + argi, argv + argc );
+    args[0] = argv[0];
+    args.push_back( NULL );
+    int args_c = args.size() - 1;
+
+    try
+    {
+        options_description all;
+        {
+            SnmpProcsCheckAppl checkAppl;
+            checkAppl.initSupportedSnmpDaemons();
+            all.add( checkAppl.get_options() );
+        }
+        parsed_options parsed( &all );
+        if( !parse_command_line_fast( args_c, &args[0], all, parsed ) )
+            cout << "command line not handled by the fast path" << endl;
+
+        variables_map boostVm, fastVm;
+        setup( args_c, &args[0], false, boostVm );
+        setup( args_c, &args[0], true, fastVm );
+        string diff = compare( boostVm, fastVm );
+        if( !diff.empty() )
+        {
+            cerr << "MISMATCH:" << diff << endl;
+            return 1;
+        }
+    }
+    catch( std::exception &e )
+    {
+        cerr << "invalid command line: " << e.what() << endl;
+        return 1;
+    }
+
+    double start = now();
+    for( unsigned n = 0; n < iterations; ++n )
+    {
+        variables_map vm;
+        setup( args_c, &args[0], false, vm );
+    }
+    double boostTime = now() - start;
+
+    start = now();
+    for( unsigned n = 0; n < iterations; ++n )
+    {
+        variables_map vm;
+        setup( args_c, &args[0], true, vm );
+    }
+    double fastTime = now() - start;
+
+    cout << iterations << " iterations: boost parser " << boostTime / iterations * 1e6
+         << "us, fast path " << fastTime / iterations * 1e6 << "us";
+    if( fastTime > 0 )
+        cout << ", speedup " << boostTime / fastTime;
+    cout << endl;
+
+    return 0;
+}
@@ -0,0 +1,172 @@
+/*
+ * Copyright 2010,2011 Matthias Haag, Jens Rehsack
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ *
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * microbenchmark of the process matching of check_procs_by_snmp
+ *
+ * Matches the argument strings of a recorded process table (one process
+ * per line, e.g. recorded by "ps -eo args= > procs.txt") against the given
+ * command (-P) and argument (-A) patterns - once by the plain regular
+ * expressions check_procs_by_snmp used before and once by the
+ * ArgumentPatternMatcher. Both have to agree on each process, and patterns
+ * without meta characters have to be compared directly. A recorded table
+ * of a typical server is shipped as bench_process_table.txt:
+ *
+ *   make bench_process_match
+ *   ./bench_process_match -i 1000 bench_process_table.txt -P '.*sshd' -A '-jar' -P java
+ */
+
+#include <smart-snmpd-nagios-plugins-build-defs.h>
+#include <smart-snmpd-nagios-plugins/pattern-matcher.h>
+
+#include <sys/time.h>
+#include <stdlib.h>
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static double
+now()
+{
+    struct timeval tv;
+    gettimeofday( &tv, NULL );
+    return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+/**
+ * checks whether the matcher of pattern takes the direct comparison
+ *
+ * @return 0 when it does exactly when expected, 1 otherwise
+ */
+static int
+check_exact( string const &pattern, bool expected, string const &literal = "" )
+{
+    LiteralPrefilter prefilter( pattern );
+
+    if( ( prefilter.isExact() == expected ) && ( !expected || ( prefilter.getLiteral() == literal ) ) &&
+        ( ArgumentPatternMatcher( pattern ).isExact() == expected ) )
+        return 0;
+
+    cerr << "EXACT " << pattern << ": expected " << expected << ", got " << prefilter.isExact()
+         << " (" << prefilter.getLiteral() << ")" << endl;
+    return 1;
+}
+
+static int
+bench( vector<string> const &processes, string const &pattern, ArgumentPatternMatcher::Position position, unsigned iterations )
+{
+    boost::regex regex( ArgumentPatternMatcher::CommandPosition == position
+                        ? "^" + pattern + "(\\s+.*|$)"
+                        : ".*\\s+" + pattern + "(\\s+.*|$)" );
+    ArgumentPatternMatcher matcher( pattern, position );
+
+    int rc = 0;
+    for( vector<string>::size_type i = 0; i < processes.size(); ++i )
+    {
+        if( boost::regex_match( processes[i], regex ) != matcher.matches( processes[i] ) )
+        {
+            cerr << "MISMATCH " << pattern << ": " << processes[i] << endl;
+            rc = 1;
+        }
+    }
+
+    unsigned long regexMatches = 0, matcherMatches = 0;
+
+    double start = now();
+    for( unsigned n = 0; n < iterations; ++n )
+        for( vector<string>::const_iterator ci = processes.begin(); ci != processes.end(); ++ci )
+            regexMatches += boost::regex_match( *ci, regex );
+    double regexTime = now() - start;
+
+    start = now();
+    for( unsigned n = 0; n < iterations; ++n )
+        for( vector<string>::const_iterator ci = processes.begin(); ci != processes.end(); ++ci )
+            matcherMatches += matcher.matches( *ci );
+    double matcherTime = now() - start;
+
+    cout << ( ArgumentPatternMatcher::CommandPosition == position ? "-P " : "-A " ) << pattern
+         << ( matcher.isExact() ? " (exact)" : "" ) << ": "
+         << regexMatches / iterations << " matches, regex " << regexTime << "s, matcher " << matcherTime << "s";
+    if( matcherTime > 0 )
+        cout << ", speedup " << regexTime / matcherTime;
+    cout << endl;
+
+    return rc;
+}
+
+int
+main(int argc, char *argv[])
+{
+    unsigned iterations = 100;
+    int argi = 1;
+
+    if( ( argi + 1 < argc ) && ( string( "-i" ) == argv[argi] ) )
+    {
+        iterations = strtoul( argv[argi + 1], NULL, 10 );
+        argi += 2;
+    }
+
+    if( ( argi >= argc ) || ( 0 == iterations ) )
+    {
+        cerr << "usage: " << argv[0] << " [-i ITERATIONS] PROCESS-TABLE-FILE [-P COMMAND | -A ARGUMENT]..." << endl;
+        return 255;
+    }
+
+    // patterns without meta characters have to be compared directly
+    int rc = check_exact( "sshd", true, "sshd" )
+           | check_exact( "/usr/sbin/sshd", true, "/usr/sbin/sshd" )
+           | check_exact( "java -jar", true, "java -jar" )
+           | check_exact( "a\\.b", true, "a.b" )
+           | check_exact( ".*sshd", false )
+           | check_exact( "sshd.*", false )
+           | check_exact( "ssh[d]", false )
+           | check_exact( "sshd?", false );
+
+    ifstream ifs( argv[argi] );
+    if( !ifs )
+    {
+        cerr << "Can't open process table file '" << argv[argi] << "'" << endl;
+        return 255;
+    }
+
+    vector<string> processes;
+    string line;
+    while( getline( ifs, line ) )
+        processes.push_back( line );
+
+    cout << processes.size() << " processes, " << iterations << " iterations" << endl;
+
+    for( ++argi; argi + 1 < argc; argi += 2 )
+    {
+        string opt( argv[argi] );
+        if( "-P" == opt )
+            rc |= bench( processes, argv[argi + 1], ArgumentPatternMatcher::CommandPosition, iterations );
+        else if( "-A" == opt )
+            rc |= bench( processes, argv[argi + 1], ArgumentPatternMatcher::ArgumentPosition, iterations );
+        else
+        {
+            cerr << "unknown option " << opt << endl;
+            return 255;
+        }
+    }
+
+    return rc;
+}
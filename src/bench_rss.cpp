@@ -0,0 +1,177 @@
+/*
+ * Copyright 2010,2011 Matthias Haag, Jens Rehsack
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ *
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * benchmark of the memory footprint of concurrently running checks
+ *
+ * Starts the given commands round robin until the requested number of
+ * processes runs, waits for them to initialize and sums up their resident
+ * (Rss) and proportional (Pss, shared pages are divided by the number of
+ * processes mapping them) set sizes from /proc/PID/smaps. The checks have
+ * to stay alive meanwhile - let them query an address nobody answers:
+ *
+ *   make bench_rss
+ *   ./bench_rss -n 100 ./check_cpu_by_snmp -H 10.255.255.1 -C public -t 30 \
+ *       -- ./check_mem_by_snmp -H 10.255.255.1 -C public -t 30
+ *   ./bench_rss -n 100 smart-snmpd-check check_cpu_by_snmp -H 10.255.255.1 -C public -t 30 \
+ *       -- smart-snmpd-check check_mem_by_snmp -H 10.255.255.1 -C public -t 30
+ */
+
+#include <smart-snmpd-nagios-plugins-build-defs.h>
+
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * starts argv with stdout and stderr redirected to /dev/null
+ *
+ * @return pid of the started process, -1 on failure
+ */
+static pid_t
+start( vector<char *> const &argv )
+{
+    pid_t pid = fork();
+    if( 0 == pid )
+    {
+        int devnull = open( "/dev/null", O_WRONLY );
+        if( -1 != devnull )
+        {
+            dup2( devnull, STDOUT_FILENO );
+            dup2( devnull, STDERR_FILENO );
+        }
+        execvp( argv[0], &argv[0] );
+        _exit( 127 );
+    }
+
+    return pid;
+}
+
+/**
+ * adds the Rss and Pss values of a process in kB
+ *
+ * @return false when the process isn't running anymore
+ */
+static bool
+measure( pid_t pid, unsigned long &rss, unsigned long &pss )
+{
+    ostringstream path;
+    path << "/proc/" << pid << "/smaps";
+    ifstream ifs( path.str().c_str() );
+    if( !ifs )
+        return false;
+
+    string line;
+    bool found = false;
+    while( getline( ifs, line ) )
+    {
+        if( 0 == line.compare( 0, 4, "Rss:" ) )
+            rss += strtoul( line.c_str() + 4, NULL, 10 );
+        else if( 0 == line.compare( 0, 4, "Pss:" ) )
+            pss += strtoul( line.c_str() + 4, NULL, 10 );
+        else
+            continue;
+        found = true;
+    }
+
+    return found;
+}
+
+int
+main(int argc, char *argv[])
+{
+    unsigned processes = 50, settle = 2;
+    int argi = 1;
+
+    for( ; ( argi + 1 < argc ) && ( '-' == argv[argi][0] ); argi += 2 )
+    {
+        string opt( argv[argi] );
+        if( "-n" == opt )
+            processes = strtoul( argv[argi + 1], NULL, 10 );
+        else if( "-s" == opt )
+            settle = strtoul( argv[argi + 1], NULL, 10 );
+        else
+            break;
+    }
+
+    vector< vector<char *> > commands( 1 );
+    for( ; argi < argc; ++argi )
+    {
+        if( 0 == strcmp( argv[argi], "--" ) )
+            commands.push_back( vector<char *>() );
+        else
+            commands.back().push_back( argv[argi] );
+    }
+
+    for( vector< vector<char *> >::iterator i = commands.begin(); i != commands.end(); ++i )
+    {
+        if( i->empty() )
+            processes = 0;
+        i->push_back( NULL );
+    }
+
+    if( 0 == processes )
+    {
+        cerr << "usage: " << argv[0] << " [-n PROCESSES] [-s SETTLE-SECONDS] COMMAND [ARGS...] [-- COMMAND [ARGS...]]..." << endl;
+        return 255;
+    }
+
+    vector<pid_t> pids;
+    for( unsigned n = 0; n < processes; ++n )
+    {
+        pid_t pid = start( commands[n % commands.size()] );
+        if( -1 == pid )
+        {
+            cerr << "fork failed: " << strerror(errno) << endl;
+            break;
+        }
+        pids.push_back( pid );
+    }
+
+    sleep( settle );
+
+    unsigned long rss = 0, pss = 0;
+    unsigned running = 0;
+    for( vector<pid_t>::const_iterator ci = pids.begin(); ci != pids.end(); ++ci )
+    {
+        if( measure( *ci, rss, pss ) )
+            ++running;
+    }
+
+    for( vector<pid_t>::const_iterator ci = pids.begin(); ci != pids.end(); ++ci )
+        kill( *ci, SIGTERM );
+    for( vector<pid_t>::const_iterator ci = pids.begin(); ci != pids.end(); ++ci )
+        waitpid( *ci, NULL, 0 );
+
+    cout << running << " of " << pids.size() << " processes running: Rss " << rss << " kB, Pss " << pss << " kB";
+    if( running > 0 )
+        cout << ", Pss per process " << pss / running << " kB";
+    cout << endl;
+
+    return ( running == pids.size() ) ? 0 : 1;
+}
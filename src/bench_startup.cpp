@@ -0,0 +1,209 @@
+/*
+ * Copyright 2010,2011 Matthias Haag, Jens Rehsack
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ *
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * benchmark of the start-up latency of the check plugins
+ *
+ * Runs each plugin the given number of times by executing it directly and
+ * by check_by_snmp_client through a running check_by_snmp_daemon (start it
+ * with --fork to compare against forking pre-initialized checks). The
+ * plugin arguments default to --help, which measures the start-up only:
+ *
+ *   make bench_startup
+ *   ./check_by_snmp_daemon --socket /tmp/ssnc.sock --fork true &
+ *   SSNC_CHECK_DAEMON_SOCKET=/tmp/ssnc.sock ./bench_startup -i 100
+ *   SSNC_CHECK_DAEMON_SOCKET=/tmp/ssnc.sock ./bench_startup -i 100 -- -H 127.0.0.1 -p 8161 -C public -V 2C
+ */
+
+#include <smart-snmpd-nagios-plugins-build-defs.h>
+#include <smart-snmpd-nagios-plugins/smart-snmpd-nagios-plugins.h>
+
+#include <smart-snmpd-nagios-plugins/check-daemon-protocol.h>
+
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <stdlib.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * plugins served by the check daemon (see check_plugins.h)
+ */
+static char const * const BenchPlugins[] =
+{
+    "check_fs_by_snmp",
+    "check_cpu_by_snmp",
+    "check_procs_by_snmp",
+    "check_mem_by_snmp",
+    "check_swap_by_snmp",
+    "check_load_by_snmp",
+    "check_user_cnt_by_snmp",
+    "check_proc_cnt_by_snmp",
+    "check_host_by_snmp",
+    "check_snmp_daemon_avail",
+    "check_snmp_agent_avail",
+};
+
+static double
+now()
+{
+    struct timeval tv;
+    gettimeofday( &tv, NULL );
+    return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+/**
+ * executes args with stdout and stderr redirected to /dev/null
+ *
+ * @return exit code of the program, -1 when it couldn't be run
+ */
+static int
+run( vector<string> const &args )
+{
+    vector<char *> argv;
+    for( vector<string>::const_iterator ci = args.begin(); ci != args.end(); ++ci )
+        argv.push_back( const_cast<char *>( ci->c_str() ) );
+    argv.push_back( NULL );
+
+    pid_t pid = fork();
+    if( 0 == pid )
+    {
+        int devnull = open( "/dev/null", O_WRONLY );
+        if( -1 != devnull )
+        {
+            dup2( devnull, STDOUT_FILENO );
+            dup2( devnull, STDERR_FILENO );
+        }
+        execv( argv[0], &argv[0] );
+        _exit( 127 );
+    }
+
+    int status;
+    if( ( -1 == pid ) || ( -1 == waitpid( pid, &status, 0 ) ) || !WIFEXITED( status ) || ( 127 == WEXITSTATUS( status ) ) )
+        return -1;
+
+    return WEXITSTATUS( status );
+}
+
+/**
+ * runs args the given number of times
+ *
+ * @return seconds per run, negative when args couldn't be run
+ */
+static double
+bench( vector<string> const &args, unsigned iterations, int &exitCode )
+{
+    double start = now();
+    for( unsigned n = 0; n < iterations; ++n )
+    {
+        if( -1 == ( exitCode = run( args ) ) )
+            return -1;
+    }
+
+    return ( now() - start ) / iterations;
+}
+
+int
+main(int argc, char *argv[])
+{
+    unsigned iterations = 20;
+    string bindir = ".", client;
+    vector<string> pluginArgs;
+    int argi = 1;
+
+    for( ; argi < argc; ++argi )
+    {
+        string opt( argv[argi] );
+        if( ( "-i" == opt ) && ( argi + 1 < argc ) )
+            iterations = strtoul( argv[++argi], NULL, 10 );
+        else if( ( "-b" == opt ) && ( argi + 1 < argc ) )
+            bindir = argv[++argi];
+        else if( ( "-c" == opt ) && ( argi + 1 < argc ) )
+            client = argv[++argi];
+        else if( "--" == opt )
+            break;
+        else
+            iterations = 0;
+    }
+
+    if( 0 == iterations )
+    {
+        cerr << "usage: " << argv[0] << " [-i ITERATIONS] [-b PLUGIN-DIR] [-c CLIENT] [-- PLUGIN-ARGUMENTS...]" << endl;
+        return 255;
+    }
+
+    for( ++argi; argi < argc; ++argi )
+        pluginArgs.push_back( argv[argi] );
+    if( pluginArgs.empty() )
+        pluginArgs.push_back( "--help" );
+    if( client.empty() )
+        client = bindir + "/check_by_snmp_client";
+
+    // the client would silently fall back to executing the plugin
+    char const *socketPath = getenv( SSNC_CHECK_DAEMON_SOCKET_ENV );
+    if( !socketPath )
+        socketPath = SSNC_DEFAULT_CHECK_DAEMON_SOCKET;
+    CheckDaemonConnection conn;
+    if( !conn.connect( socketPath ) )
+    {
+        cerr << "Can't connect to the check daemon on " << socketPath << ": " << strerror(errno) << endl;
+        return 1;
+    }
+    conn.close();
+
+    cout << iterations << " iterations, milliseconds per run" << endl;
+
+    int rc = 0;
+    for( size_t i = 0; i < sizeof(BenchPlugins) / sizeof(BenchPlugins[0]); ++i )
+    {
+        vector<string> execArgs, clientArgs;
+        execArgs.push_back( bindir + "/" + BenchPlugins[i] );
+        execArgs.insert( execArgs.end(), pluginArgs.begin(), pluginArgs.end() );
+        clientArgs.push_back( client );
+        clientArgs.push_back( BenchPlugins[i] );
+        clientArgs.insert( clientArgs.end(), pluginArgs.begin(), pluginArgs.end() );
+
+        int execRc, clientRc;
+        double execTime = bench( execArgs, iterations, execRc );
+        double clientTime = bench( clientArgs, iterations, clientRc );
+
+        cout << BenchPlugins[i] << ": ";
+        if( ( execTime < 0 ) || ( clientTime < 0 ) )
+        {
+            cout << "can't be run" << endl;
+            rc = 1;
+            continue;
+        }
+
+        cout << "exec " << execTime * 1000 << " (" << execRc << "), daemon " << clientTime * 1000 << " (" << clientRc << ")";
+        if( clientTime > 0 )
+            cout << ", speedup " << execTime / clientTime;
+        if( execRc != clientRc )
+        {
+            cout << " - EXIT CODES DIFFER";
+            rc = 1;
+        }
+        cout << endl;
+    }
+
+    return rc;
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright 2010,2011 Matthias Haag, Jens Rehsack
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ *
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * benchmark of the logging overhead of table walks
+ *
+ * Walks the given table columns (the process table by default) the given
+ * number of times like the check plugins do and reports the time per walk.
+ * Compare the default debug level with a verbose one, and a build
+ * configured with --disable-debug, which removes the debug log statements
+ * at compile time, against a default build:
+ *
+ *   make bench_walk
+ *   ./bench_walk -H 127.0.0.1 -p 8161 -C public -V 2C -i 100
+ *   ./bench_walk -H 127.0.0.1 -p 8161 -C public -V 2C -i 100 -d 3 >/dev/null
+ *   ./bench_walk -H 127.0.0.1 -p 8161 -C public -V 2C -i 100 --column 1.3.6.1.2.1.25.2.3.1.3
+ */
+
+#include <smart-snmpd-nagios-plugins-build-defs.h>
+#include <smart-snmpd-nagios-plugins/smart-snmpd-nagios-plugins.h>
+
+#include <smart-snmpd-nagios-plugins/oids.h>
+#include <smart-snmpd-nagios-plugins/snmp-appl.h>
+
+#include <sys/time.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static double
+now()
+{
+    struct timeval tv;
+    gettimeofday( &tv, NULL );
+    return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+/**
+ * counts the rows of a walk
+ */
+struct CountRows
+{
+    CountRows() : mRows( 0 ) {}
+
+    template < class Row >
+    bool operator () ( Row const & )
+    {
+        ++mRows;
+        return false;
+    }
+
+    unsigned long mRows;
+};
+
+class WalkBenchAppl
+    : public SnmpAppl
+{
+public:
+    WalkBenchAppl()
+        : SnmpAppl()
+    {}
+
+    virtual ~WalkBenchAppl() {}
+
+    virtual options_description get_options() const
+    {
+        options_description all = SnmpAppl::get_options();
+        options_description benchopts("Benchmark options");
+        benchopts.add_options()
+            ("iterations,i", value<unsigned>()->default_value(20), "number of walks")
+            ("column", value< vector<string> >()->composing(), "oid of a column to walk (repeatable, default: the process table)")
+            ;
+        all.add(benchopts);
+
+        return all;
+    }
+
+    int run()
+    {
+        vector<Oid> columns;
+        if( mCmndlineValuesMap.count("column") )
+        {
+            vector<string> const &oids = mCmndlineValuesMap["column"].as< vector<string> >();
+            for( vector<string>::const_iterator ci = oids.begin(); ci != oids.end(); ++ci )
+                columns.push_back( Oid( ci->c_str() ) );
+        }
+        else
+        {
+            columns.push_back( Oid( HR_SWRUN_INDEX ) );
+            columns.push_back( Oid( HR_SWRUN_NAME ) );
+            columns.push_back( Oid( HR_SWRUN_PATH ) );
+            columns.push_back( Oid( HR_SWRUN_PARAMETERS ) );
+            columns.push_back( Oid( HR_SWRUN_STATUS ) );
+        }
+
+        unsigned iterations = mCmndlineValuesMap["iterations"].as<unsigned>();
+        if( 0 == iterations )
+            throw validation_error( validation_error::invalid_option_value, "0", "iterations" );
+
+        CountRows counter;
+        double start = now();
+        for( unsigned n = 0; n < iterations; ++n )
+        {
+            int rc = mSnmpComm.get_table( columns, counter );
+            if( SNMP_CLASS_SUCCESS != rc )
+            {
+                cerr << "walk failed: " << Snmp::error_msg( rc ) << endl;
+                return 1;
+            }
+        }
+        double elapsed = now() - start;
+
+        // the log output goes to stdout - keep the result apart from it
+        cerr << iterations << " walks of " << columns.size() << " columns, " << counter.mRows / iterations
+             << " rows: " << elapsed * 1000 / iterations << " milliseconds per walk" << endl;
+
+        return 0;
+    }
+
+protected:
+    virtual string const getApplName() const { return "bench_walk"; }
+    virtual string const getApplVersion() const { return SSNC_VERSION_STRING; }
+    virtual string const getApplDescription() const { return "Benchmark of table walks"; }
+};
+
+int
+main(int argc, char *argv[])
+{
+    int rc = 255;
+    WalkBenchAppl benchAppl;
+
+    try
+    {
+        benchAppl.setupFromCommandLine(argc, argv);
+        benchAppl.configure();
+
+        rc = benchAppl.run();
+    }
+    catch(std::exception& e)
+    {
+        cerr << e.what() << endl;
+    }
+
+    return rc;
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright 2010,2011 Matthias Haag, Jens Rehsack
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ *
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Thin client forwarding a check to check_by_snmp_daemon.
+ *
+ * This program is intentionally kept free of SNMP++ and boost to start up
+ * as fast as possible. It's installed under the names of the check plugins
+ * (symlinks into a separate directory) and forwards its command line to the
+ * daemon. When the daemon can't be reached, the real plugin is executed.
+ */
+
+#include <smart-snmpd-nagios-plugins-build-defs.h>
+#include <smart-snmpd-nagios-plugins/smart-snmpd-nagios-plugins.h>
+
+#include <smart-snmpd-nagios-plugins/nagios-stats.h>
+#include <smart-snmpd-nagios-plugins/check-daemon-protocol.h>
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * set in the environment of the executed fallback plugin to avoid loops
+ */
+#define SSNC_CHECK_CLIENT_FALLBACK_ENV "SSNC_CHECK_CLIENT_FALLBACK"
+
+static string
+base_name( string const &path )
+{
+    string::size_type pos = path.find_last_of( '/' );
+    return ( pos == string::npos ) ? path : path.substr( pos + 1 );
+}
+
+/**
+ * executes the real check plugin - only returns on failure
+ */
+static int
+run_fallback( string const &pluginName, int argc, char *argv[] )
+{
+    if( getenv( SSNC_CHECK_CLIENT_FALLBACK_ENV ) )
+    {
+        cout << "UNKNOWN - check daemon not reachable and " << pluginName << " refers to the client itself" << endl;
+        return STATE_UNKNOWN;
+    }
+
+    string pluginPath = string( BINDIR ) + "/" + pluginName;
+    vector<char *> args( argv, argv + argc );
+    args[0] = const_cast<char *>( pluginPath.c_str() );
+    args.push_back( NULL );
+
+    setenv( SSNC_CHECK_CLIENT_FALLBACK_ENV, "1", 1 );
+    execv( pluginPath.c_str(), &args[0] );
+
+    cout << "UNKNOWN - can't execute " << pluginPath << ": " << strerror(errno) << endl;
+    return STATE_UNKNOWN;
+}
+
+int
+main(int argc, char *argv[])
+{
+    string pluginName = base_name( argv[0] );
+
+    // allow "check_by_snmp_client check_xxx [options]" additionally to symlinks
+    if( pluginName == "check_by_snmp_client" )
+    {
+        if( argc < 2 )
+        {
+            cerr << "usage: " << argv[0] << " <check plugin> [plugin options]" << endl;
+            return STATE_UNKNOWN;
+        }
+
+        pluginName = base_name( argv[1] );
+        ++argv;
+        --argc;
+    }
+
+    const char *socketPath = getenv( SSNC_CHECK_DAEMON_SOCKET_ENV );
+    if( NULL == socketPath )
+        socketPath = SSNC_DEFAULT_CHECK_DAEMON_SOCKET;
+
+    CheckDaemonConnection conn;
+    if( !conn.connect( socketPath ) )
+        return run_fallback( pluginName, argc, argv );
+
+    vector<string> request( argv, argv + argc );
+    request[0] = pluginName;
+
+    int rc;
+    string out, err;
+    if( !conn.sendRequest( request ) || !conn.receiveResponse( rc, out, err ) )
+    {
+        cout << "UNKNOWN - lost connection to check daemon at " << socketPath << endl;
+        return STATE_UNKNOWN;
+    }
+
+    cout << out;
+    cerr << err;
+
+    return rc;
+}
@@ -0,0 +1,564 @@
+/*
+ * Copyright 2010,2011 Matthias Haag, Jens Rehsack
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ *
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "check_plugins.h"
+
+#include <smart-snmpd-nagios-plugins/check-daemon-protocol.h>
+#include <smart-snmpd-nagios-plugins/snmp-session-pool.h>
+
+#include <sstream>
+
+#include <pthread.h>
+#include <sys/select.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+
+#undef loggerModuleName
+#define loggerModuleName "nagiosplugins.checkdaemon"
+
+extern "C"
+{
+static void * check_daemon_worker(void *arg);
+static void check_daemon_terminate_handler(int signo);
+static void check_daemon_child_handler(int signo);
+}
+
+/**
+ * termination signal received while forking checks, 0 while running
+ */
+static volatile sig_atomic_t check_daemon_terminate_signal = 0;
+
+/**
+ * check daemon - runs the check plugins on behalf of check_by_snmp_client
+ *
+ * The daemon listens on a unix domain socket and runs each received
+ * check request in one of its worker threads. Loading the plugin code,
+ * initializing SNMP++ and the logging happens only once at startup,
+ * snmp sessions are reused between the requests via SnmpSessionPool.
+ *
+ * With --fork the daemon acts as zygote instead: each request is run by
+ * a child forked from the initialized daemon, so a check starts without
+ * loading and initializing anything but doesn't share the address space
+ * with other checks.
+ */
+class CheckDaemonAppl
+    : public SnmpAppl
+{
+public:
+    /**
+     * default constructor
+     */
+    CheckDaemonAppl()
+        : SnmpAppl()
+        , mSessionPool()
+        , mListenFd(-1)
+        , mSocketPath()
+        , mWorkers()
+        , mTerminating(false)
+    {}
+
+    /**
+     * destructor
+     */
+    virtual ~CheckDaemonAppl()
+    {
+        closeListenSocket();
+    }
+
+    /**
+     * adds the options controlling the daemon to the given options_description instance
+     *
+     * @param daemonopts - options_description instance to add the daemon options to
+     */
+    virtual void add_daemon_options(options_description &daemonopts) const
+    {
+        daemonopts.add_options()
+            ("socket,S", value<string>()->default_value(SSNC_DEFAULT_CHECK_DAEMON_SOCKET),
+                "path of the unix domain socket to listen on")
+            ("workers,w", value<unsigned>()->default_value(8),
+                "number of worker threads (children with --fork) running checks concurrently")
+            ("fork", value<bool>()->default_value(false),
+                "run each check in a child forked from the initialized daemon instead of a worker thread")
+            ;
+    }
+
+    /**
+     * initializes program options and return them
+     *
+     * The snmp options are specified per check request, so they're
+     * not accepted by the daemon itself.
+     *
+     * @return options_description - the daemon program options
+     */
+    virtual options_description get_options() const
+    {
+        options_description general("General options");
+        add_general_options( general );
+        options_description daemonopts("Daemon options");
+        add_daemon_options( daemonopts );
+
+        options_description all("Allowed options");
+        all.add(general).add(daemonopts);
+
+        return all;
+    }
+
+    virtual void validate_options() const
+    {
+        if( 0 == mCmndlineValuesMap["workers"].as<unsigned>() )
+            throw validation_error( validation_error::invalid_option_value, "0", "workers" );
+    }
+
+    /**
+     * configures daemon
+     */
+    void configure()
+    {
+#ifndef _NO_LOGGING
+        configure_logging( mCmndlineValuesMap["debug-level"].as<int>() );
+#endif
+#ifdef _SNMPv3
+        SnmpComm::init_v3mp();
+#endif
+
+        mSocketPath = mCmndlineValuesMap["socket"].as<string>();
+
+        // a client going away must not kill the daemon
+        signal( SIGPIPE, SIG_IGN );
+    }
+
+    /**
+     * runs the daemon until SIGTERM, SIGINT or SIGHUP is received
+     *
+     * @return exit code
+     */
+    int run()
+    {
+        struct sockaddr_un addr;
+
+        if( mSocketPath.length() >= sizeof(addr.sun_path) )
+            throw runtime_error( string( "Socket path too long: " ) + mSocketPath );
+
+        memset( &addr, 0, sizeof(addr) );
+        addr.sun_family = AF_UNIX;
+        strncpy( addr.sun_path, mSocketPath.c_str(), sizeof(addr.sun_path) - 1 );
+
+        if( -1 == ( mListenFd = socket( AF_UNIX, SOCK_STREAM, 0 ) ) )
+            throw runtime_error( string( "Can't create socket: " ) + strerror(errno) );
+
+        unlink( mSocketPath.c_str() ); // remove stale socket of previous instance
+        // checks run with the daemon's privileges - only the owner may connect
+        mode_t oldMask = umask( 0177 );
+        int rc = bind( mListenFd, (struct sockaddr *)&addr, sizeof(addr) );
+        int bindErrno = errno;
+        umask( oldMask );
+        if( -1 == rc )
+            throw runtime_error( string( "Can't bind to " ) + mSocketPath + ": " + strerror(bindErrno) );
+        if( -1 == chmod( mSocketPath.c_str(), S_IRUSR | S_IWUSR ) )
+            throw runtime_error( string( "Can't restrict access to " ) + mSocketPath + ": " + strerror(errno) );
+        if( -1 == listen( mListenFd, SOMAXCONN ) )
+            throw runtime_error( string( "Can't listen on " ) + mSocketPath + ": " + strerror(errno) );
+
+        if( mCmndlineValuesMap["fork"].as<bool>() )
+            return runForking();
+
+        // workers inherit the mask, termination signals are only received via sigwait() below
+        sigset_t termSignals;
+        sigemptyset( &termSignals );
+        sigaddset( &termSignals, SIGTERM );
+        sigaddset( &termSignals, SIGINT );
+        sigaddset( &termSignals, SIGHUP );
+        pthread_sigmask( SIG_BLOCK, &termSignals, NULL );
+
+        unsigned nWorkers = mCmndlineValuesMap["workers"].as<unsigned>();
+        for( unsigned i = 0; i < nWorkers; ++i )
+        {
+            pthread_t tid;
+            int rc = pthread_create( &tid, NULL, check_daemon_worker, this );
+            if( 0 != rc )
+            {
+                SSNC_LOG_BEGIN( loggerModuleName, ERROR_LOG | 0 );
+                LOG( "Can't create worker thread" );
+                LOG( strerror(rc) );
+                LOG_END;
+                break;
+            }
+            mWorkers.push_back( tid );
+        }
+
+        if( mWorkers.empty() )
+            throw runtime_error( "No worker threads available" );
+
+        SSNC_LOG_BEGIN( loggerModuleName, INFO_LOG | 1 );
+        LOG( "listening on socket" );
+        LOG( mSocketPath.c_str() );
+        LOG_END;
+
+        int signo = 0;
+        while( 0 != sigwait( &termSignals, &signo ) )
+            ;
+
+        SSNC_LOG_BEGIN( loggerModuleName, INFO_LOG | 1 );
+        LOG( "terminating on signal" );
+        LOG( signo );
+        LOG_END;
+
+        mTerminating = true;
+        shutdown( mListenFd, SHUT_RDWR ); // wakes up the workers blocked in accept()
+
+        for( vector<pthread_t>::iterator i = mWorkers.begin(); i != mWorkers.end(); ++i )
+            pthread_join( *i, NULL );
+        mWorkers.clear();
+
+        closeListenSocket();
+
+        return 0;
+    }
+
+    /**
+     * accepts and handles connections until the daemon terminates
+     */
+    void serve()
+    {
+        while( !mTerminating )
+        {
+            int fd = accept( mListenFd, NULL, NULL );
+            if( -1 == fd )
+            {
+                if( ( EINTR != errno ) && !mTerminating )
+                {
+                    SSNC_LOG_BEGIN( loggerModuleName, WARNING_LOG | 1 );
+                    LOG( "accept failed" );
+                    LOG( strerror(errno) );
+                    LOG_END;
+                }
+                continue;
+            }
+
+            handleConnection( fd );
+        }
+    }
+
+protected:
+    /**
+     * accepts connections and forks a child running the check for each
+     * of them until SIGTERM, SIGINT or SIGHUP is received
+     *
+     * No threads are started in this mode - the children are forked from
+     * a single threaded process. The session pool isn't used by the
+     * daemon itself, so each child starts with an empty one.
+     *
+     * @return exit code
+     */
+    int runForking()
+    {
+        // the signals are only delivered while waiting in pselect() - none gets lost between check and wait
+        sigset_t daemonSignals, waitMask;
+        sigemptyset( &daemonSignals );
+        sigaddset( &daemonSignals, SIGTERM );
+        sigaddset( &daemonSignals, SIGINT );
+        sigaddset( &daemonSignals, SIGHUP );
+        sigaddset( &daemonSignals, SIGCHLD );
+        sigprocmask( SIG_BLOCK, &daemonSignals, &waitMask );
+
+        struct sigaction sa, oldChildSa;
+        memset( &sa, 0, sizeof(sa) );
+        sa.sa_handler = check_daemon_terminate_handler;
+        sigemptyset( &sa.sa_mask );
+        sa.sa_flags = 0;
+        sigaction( SIGTERM, &sa, NULL );
+        sigaction( SIGINT, &sa, NULL );
+        sigaction( SIGHUP, &sa, NULL );
+        sa.sa_handler = check_daemon_child_handler;
+        sigaction( SIGCHLD, &sa, &oldChildSa );
+
+        // a client might give up between pselect() and accept()
+        fcntl( mListenFd, F_SETFL, fcntl( mListenFd, F_GETFL ) | O_NONBLOCK );
+
+        unsigned maxChildren = mCmndlineValuesMap["workers"].as<unsigned>();
+        unsigned children = 0;
+
+        SSNC_LOG_BEGIN( loggerModuleName, INFO_LOG | 1 );
+        LOG( "listening on socket, forking checks" );
+        LOG( mSocketPath.c_str() );
+        LOG_END;
+
+        for(;;)
+        {
+            // reap finished children
+            while( ( children > 0 ) && ( waitpid( -1, NULL, WNOHANG ) > 0 ) )
+                --children;
+
+            if( check_daemon_terminate_signal )
+                break;
+
+            // when all children are busy, wait for SIGCHLD only
+            fd_set readFds;
+            FD_ZERO( &readFds );
+            if( children < maxChildren )
+                FD_SET( mListenFd, &readFds );
+
+            int rc = pselect( mListenFd + 1, &readFds, NULL, NULL, NULL, &waitMask );
+            if( -1 == rc )
+            {
+                if( EINTR != errno )
+                {
+                    SSNC_LOG_BEGIN( loggerModuleName, ERROR_LOG | 1 );
+                    LOG( "pselect failed" );
+                    LOG( strerror(errno) );
+                    LOG_END;
+                    break;
+                }
+                continue;
+            }
+            if( !FD_ISSET( mListenFd, &readFds ) )
+                continue;
+
+            int fd = accept( mListenFd, NULL, NULL );
+            if( -1 == fd )
+            {
+                if( ( EINTR != errno ) && ( EAGAIN != errno ) && ( EWOULDBLOCK != errno ) )
+                {
+                    SSNC_LOG_BEGIN( loggerModuleName, WARNING_LOG | 1 );
+                    LOG( "accept failed" );
+                    LOG( strerror(errno) );
+                    LOG_END;
+                }
+                continue;
+            }
+
+            pid_t pid = fork();
+            if( 0 == pid )
+            {
+                // the socket file belongs to the daemon - don't unlink it
+                close( mListenFd );
+                mListenFd = -1;
+
+                sigaction( SIGCHLD, &oldChildSa, NULL );
+                sigprocmask( SIG_SETMASK, &waitMask, NULL );
+
+                handleConnection( fd );
+                _exit( 0 );
+            }
+
+            if( -1 == pid )
+            {
+                SSNC_LOG_BEGIN( loggerModuleName, WARNING_LOG | 1 );
+                LOG( "fork failed" );
+                LOG( strerror(errno) );
+                LOG_END;
+            }
+            else
+            {
+                ++children;
+            }
+
+            close( fd );
+        }
+
+        SSNC_LOG_BEGIN( loggerModuleName, INFO_LOG | 1 );
+        LOG( "terminating on signal" );
+        LOG( (int)check_daemon_terminate_signal );
+        LOG_END;
+
+        closeListenSocket();
+
+        // running checks are completed
+        while( children > 0 )
+        {
+            if( waitpid( -1, NULL, 0 ) > 0 )
+                --children;
+            else if( EINTR != errno )
+                break;
+        }
+
+        return 0;
+    }
+
+    /**
+     * pool of snmp sessions shared between all hosted checks
+     */
+    SnmpSessionPool mSessionPool;
+    /**
+     * listening socket
+     */
+    int mListenFd;
+    /**
+     * path of the listening socket
+     */
+    string mSocketPath;
+    /**
+     * running worker threads
+     */
+    vector<pthread_t> mWorkers;
+    /**
+     * set when the daemon is shutting down
+     */
+    volatile bool mTerminating;
+
+    /**
+     * reads one request from the connection, runs it and sends the result back
+     *
+     * @param fd - accepted connection, closed when done
+     */
+    void handleConnection( int fd )
+    {
+        CheckDaemonConnection conn( fd );
+        vector<string> args;
+
+        if( !conn.receiveRequest( args ) || args.empty() )
+        {
+            SSNC_LOG_BEGIN( loggerModuleName, WARNING_LOG | 1 );
+            LOG( "received invalid request" );
+            LOG_END;
+            return;
+        }
+
+        ostringstream out, err;
+        HostedEnvironment hostedEnv( out, err, mSessionPool );
+        int rc = runCheck( args, hostedEnv );
+
+        if( !conn.sendResponse( rc, out.str(), err.str() ) )
+        {
+            SSNC_LOG_BEGIN( loggerModuleName, WARNING_LOG | 1 );
+            LOG( "can't send response" );
+            LOG( args[0].c_str() );
+            LOG_END;
+        }
+    }
+
+    /**
+     * runs the check plugin requested by args[0]
+     *
+     * @param args - plugin name followed by the command line arguments
+     * @param hostedEnv - environment to run the plugin in
+     *
+     * @return exit code of the check
+     */
+    int runCheck( vector<string> const &args, HostedEnvironment &hostedEnv )
+    {
+        CheckPluginRunFunc runFunc = find_check_plugin( args[0] );
+        if( NULL == runFunc )
+        {
+            hostedEnv.getOutput() << "UNKNOWN - check plugin '" << args[0] << "' not supported by " << getApplName() << endl;
+            return STATE_UNKNOWN;
+        }
+
+        SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 5 );
+        LOG( "running check" );
+        LOG( args[0].c_str() );
+        LOG_END;
+
+        vector<char *> argv;
+        for( vector<string>::const_iterator ci = args.begin(); ci != args.end(); ++ci )
+            argv.push_back( const_cast<char *>( ci->c_str() ) );
+        argv.push_back( NULL );
+
+        try
+        {
+            return run_check_plugin( args.size(), &argv[0], runFunc, &hostedEnv );
+        }
+        catch(hosted_exit &e)
+        {
+            return e.getExitCode();
+        }
+        catch(std::exception &e)
+        {
+            hostedEnv.getOutput() << "UNKNOWN - " << e.what() << endl;
+        }
+
+        return STATE_UNKNOWN;
+    }
+
+    void closeListenSocket()
+    {
+        if( -1 != mListenFd )
+        {
+            close( mListenFd );
+            mListenFd = -1;
+            unlink( mSocketPath.c_str() );
+        }
+    }
+
+    /**
+     * contains the application name
+     */
+    virtual string const getApplName() const { return "check_by_snmp_daemon"; }
+    /**
+     * contains the application version
+     */
+    virtual string const getApplVersion() const { return SSNC_VERSION_STRING; }
+    /**
+     * short description of the application
+     */
+    virtual string const getApplDescription() const { return "Daemon running Simple Network Management Protocol checks for check_by_snmp_client"; }
+
+private:
+    /**
+     * forbidden copy constructor
+     */
+    CheckDaemonAppl(CheckDaemonAppl const &);
+    /**
+     * forbidden assignment operator
+     */
+    CheckDaemonAppl & operator = (CheckDaemonAppl const &);
+};
+
+extern "C"
+{
+static void *
+check_daemon_worker(void *arg)
+{
+    static_cast<CheckDaemonAppl *>( arg )->serve();
+    return NULL;
+}
+
+static void
+check_daemon_terminate_handler(int signo)
+{
+    check_daemon_terminate_signal = signo;
+}
+
+static void
+check_daemon_child_handler(int signo)
+{
+    // only interrupts pselect() - the children are reaped by the main loop
+    (void)signo;
+}
+}
+
+int
+main(int argc, char *argv[])
+{
+    int rc = 1;
+    CheckDaemonAppl daemonAppl;
+
+    try
+    {
+        daemonAppl.setupFromCommandLine(argc, argv);
+        daemonAppl.configure();
+
+        rc = daemonAppl.run();
+    }
+    catch(std::exception& e)
+    {
+        cerr << e.what() << endl;
+    }
+
+    return rc;
+}
@@ -0,0 +1,402 @@
+/*
+ * Copyright 2010,2011 Matthias Haag, Jens Rehsack
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ *
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __SMART_SNMPD_NAGIOS_CHECKS_CHECK_FS_BY_SNMP_H_INCLUDED__
+#define __SMART_SNMPD_NAGIOS_CHECKS_CHECK_FS_BY_SNMP_H_INCLUDED__
+
+#include <smart-snmpd-nagios-plugins-build-defs.h>
+#include <smart-snmpd-nagios-plugins/smart-snmpd-nagios-plugins.h>
+
+#include <smart-snmpd-nagios-plugins/oids.h>
+#include <smart-snmpd-nagios-plugins/snmp-comm.h>
+#include <smart-snmpd-nagios-plugins/snmp-check.h>
+#include <smart-snmpd-nagios-plugins/snmp-check-types.h>
+#include <smart-snmpd-nagios-plugins/snmp-check-appl.h>
+
+#undef loggerModuleName
+#define loggerModuleName "nagiosplugins.check"
+
+class FilesystemMibData
+    : public SupportedMibDataTable
+{
+public:
+    FilesystemMibData( StaticOidTable const &dataOids, StaticOidTable const &rowSearchColumnOids, Oid const &lastUpdateOid = Oid() )
+        : SupportedMibDataTable( dataOids, rowSearchColumnOids, lastUpdateOid )
+    {}
+
+    virtual ~FilesystemMibData() {}
+
+    FilesystemMibData & setStorageData( unsigned long long used, unsigned long long total, DataMapType &dataMap )
+    {
+        if( 0 == total )
+        {
+            used = 0;
+            total = 1;
+        }
+        SizeThreshold storage( BytesThreshold(total - used), RelativeThreshold( ((double)used / (double)total) ) );
+
+        dataMap.insert( make_pair( ProveValueMapKey, storage ) );
+        dataMap.insert( make_pair( "used", used ) );
+        dataMap.insert( make_pair( "total", total ) );
+
+        return *this;
+    }
+};
+
+static const unsigned long SmFilesystemDataOids[] = { OID_ENTRY( SM_FILE_SYSTEM_MOUNTPOINT ), OID_ENTRY( SM_FILE_SYSTEM_TOTAL ), OID_ENTRY( SM_FILE_SYSTEM_USED ) };
+static const unsigned long SmFilesystemSearchOids[] = { OID_ENTRY( SM_FILE_SYSTEM_DEVICE ), OID_ENTRY( SM_FILE_SYSTEM_MOUNTPOINT ) };
+static const unsigned long SmFilesystemLastUpdateOid[] = { SM_LAST_UPDATE_FILE_SYSTEM_USAGE_IDS };
+class SmartSnmpdFileSystemMibData
+    : public FilesystemMibData
+{
+public:
+    SmartSnmpdFileSystemMibData()
+        : FilesystemMibData( StaticOidTable( SmFilesystemDataOids ),
+                             StaticOidTable( SmFilesystemSearchOids ),
+                             Oid( SmFilesystemLastUpdateOid, lengthof(SmFilesystemLastUpdateOid) ) )
+    {}
+
+    virtual void convertSnmpData( vector<Vb> const &vblist, DataMapType &dataMap )
+    {
+        string mnt;
+        unsigned long long total, used;
+        if( SnmpComm::extract_value( vblist[0], mnt ) &&
+            SnmpComm::extract_value( vblist[1], total ) &&
+            SnmpComm::extract_value( vblist[2], used ) )
+        {
+            setStorageData( used, total, dataMap );
+            dataMap.insert( make_pair( "mnt", mnt ) );
+        }
+        else
+        {
+            throw snmp_bad_result( "File system data incomplete or corrupt" );
+        }
+    }
+};
+
+static const unsigned long HrStorageDataOids[] = { OID_ENTRY( HR_STORAGE_DESCR ), OID_ENTRY( HR_STORAGE_ALLOC_UNITS ), OID_ENTRY( HR_STORAGE_SIZE ), OID_ENTRY( HR_STORAGE_USED ) };
+static const unsigned long HrStorageSearchOids[] = { OID_ENTRY( HR_STORAGE_DESCR ) };
+class HostResourcesFileSystemMibData
+    : public FilesystemMibData
+{
+public:
+    HostResourcesFileSystemMibData()
+        : FilesystemMibData( StaticOidTable( HrStorageDataOids ),
+                             StaticOidTable( HrStorageSearchOids ) )
+    {}
+
+    virtual void convertSnmpData( vector<Vb> const &vblist, DataMapType &dataMap )
+    {
+        string mnt;
+        unsigned long long bs, total, used;
+        if( SnmpComm::extract_value( vblist[0], mnt ) &&
+            SnmpComm::extract_value( vblist[1], bs ) &&
+            SnmpComm::extract_value( vblist[2], total ) &&
+            SnmpComm::extract_value( vblist[3], used ) )
+        {
+            used *= bs;
+            total *= bs;
+
+            setStorageData( used, total, dataMap );
+            dataMap.insert( make_pair( "mnt", mnt ) );
+        }
+        else
+        {
+            throw snmp_bad_result( "File system data incomplete or corrupt" );
+        }
+    }
+};
+
+class SnmpFsCheckAppl
+    : public CheckPluginAppl< FetchTableObjects, SnmpMandatoryWarnCritCheck< SizeThreshold > >
+{
+protected:
+    typedef CheckPluginAppl< FetchTableObjects, SnmpMandatoryWarnCritCheck< SizeThreshold > > BaseApplType;
+
+public:
+    SnmpFsCheckAppl()
+        : BaseApplType()
+        , mPatternWarn()
+        , mPatternCrit()
+        , mRowDataMaps()
+    {}
+
+    virtual ~SnmpFsCheckAppl() {}
+
+    /**
+     * configures application
+     *
+     * Patterns given by --name may be followed by their own thresholds:
+     * PATTERN;WARN;CRIT - an empty threshold falls back to --warn/--crit.
+     * In nagios object definitions the separators have to be written as \;
+     */
+    void configure()
+    {
+        BaseApplType::configure();
+
+        mPatternWarn.clear();
+        mPatternCrit.clear();
+        for( vector<TableRowPattern>::const_iterator ci = getRowPatterns().begin(); ci != getRowPatterns().end(); ++ci )
+        {
+            string const &args = ci->getArguments();
+            string::size_type pos = args.find( ';' );
+            string warn = args.substr( 0, pos );
+            string crit = ( pos == string::npos ) ? string() : args.substr( pos + 1 );
+
+            mPatternWarn.push_back( warn.empty() ? getWarn() : parseThreshold( warn ) );
+            mPatternCrit.push_back( crit.empty() ? getCrit() : parseThreshold( crit ) );
+        }
+    }
+
+    virtual void convert()
+    {
+        if( !isMultiRow() )
+        {
+            BaseApplType::convert();
+            return;
+        }
+
+        SSNC_LOG_BEGIN( loggerModuleName, EVENT_LOG | 1 );
+        LOG( "normalizing and converting fetched rows" );
+        LOG_END;
+
+        if( NULL == mSupportedMibData )
+            throw( runtime_error( "out of order execution of SnmpFsCheckAppl::convert()" ) );
+
+        mRowDataMaps.assign( getMatchedRows().size(), DataMapType() );
+        for( vector<MatchedRow>::size_type i = 0; i < getMatchedRows().size(); ++i )
+            mSupportedMibData->convertSnmpData( getMatchedRows()[i].mData, mRowDataMaps[i] );
+    }
+
+    /**
+     * proves the fetched file systems
+     *
+     * @return nagios status code, the worst one of all file systems when several are checked,
+     *         at least UNKNOWN when a pattern didn't match any file system
+     */
+    template < class Cmp >
+    int prove( Cmp const &cmp = Cmp() ) const
+    {
+        if( !isMultiRow() )
+            return BaseApplType::prove( cmp );
+
+        int worstState = getUnmatchedPatterns().empty() ? STATE_OK : STATE_UNKNOWN;
+        for( vector<DataMapType>::size_type i = 0; i < mRowDataMaps.size(); ++i )
+        {
+            worstState = worse_state( worstState, proveRow( i, cmp ) );
+        }
+
+        return worstState;
+    }
+
+    virtual void initSupportedSnmpDaemons()
+    {
+        mSupportedSnmpDaemons.push_back( IdentifySmartSnmpdMib );
+        mSupportedSnmpDaemons.push_back( IdentifyNetSnmpd );
+    }
+
+    virtual SupportedMibDataType * getMibData( SnmpDaemonIdentifier const &identifiedDaemon )
+    {
+        if( identifiedDaemon.getName() == IdentifySmartSnmpdMib.getName() )
+        {
+            return new SmartSnmpdFileSystemMibData();
+        }
+        else if( identifiedDaemon.getName() == IdentifyNetSnmpd.getName() )
+        {
+            return new HostResourcesFileSystemMibData();
+        }
+
+        throw unknown_daemon();
+    }
+
+    string createResultMessage( DataMapType const &dataMap ) const
+    {
+        if( isMultiRow() )
+        {
+            string msg;
+            for( vector<DataMapType>::size_type i = 0; i < mRowDataMaps.size(); ++i )
+            {
+                msg += msg.empty() ? "free space: " : ", ";
+                msg += createRowMessage( mRowDataMaps[i] );
+
+                int state = proveRow( i, AbsoluteRelativeCmp<>() );
+                if( STATE_OK != state )
+                    msg += string( " " ) + states[state];
+            }
+
+            for( vector<vector<TableRowPattern>::size_type>::const_iterator ci = getUnmatchedPatterns().begin();
+                 ci != getUnmatchedPatterns().end(); ++ci )
+            {
+                msg += string( ", " ) + getRowPatterns()[*ci].getPattern() + " not found " + states[STATE_UNKNOWN];
+            }
+
+            return msg;
+        }
+
+        return string("free space: ") + createRowMessage( dataMap );
+    }
+
+    string createPerformanceMessage( DataMapType const &dataMap ) const
+    {
+        if( isMultiRow() )
+        {
+            string msg;
+            for( vector<DataMapType>::size_type i = 0; i < mRowDataMaps.size(); ++i )
+            {
+                vector<TableRowPattern>::size_type p = getMatchedRows()[i].mPattern;
+                if( !msg.empty() )
+                    msg += " ";
+                msg += createRowPerformanceMessage( mRowDataMaps[i], mPatternWarn[p], mPatternCrit[p] );
+            }
+
+            return msg;
+        }
+
+        return createRowPerformanceMessage( dataMap, getWarn(), getCrit() );
+    }
+
+protected:
+    /**
+     * thresholds of the patterns given by --name
+     */
+    vector<SizeThreshold> mPatternWarn;
+    vector<SizeThreshold> mPatternCrit;
+    /**
+     * converted values of each matched row
+     */
+    vector<DataMapType> mRowDataMaps;
+
+    static SizeThreshold parseThreshold( string const &s )
+    {
+        boost::any v;
+        vector<string> vs;
+        vs.push_back( s );
+        validate( v, vs, (SizeThreshold *)0, 0 );
+
+        return any_cast<SizeThreshold>( v );
+    }
+
+    template < class Cmp >
+    int proveRow( vector<DataMapType>::size_type i, Cmp const &cmp ) const
+    {
+        vector<TableRowPattern>::size_type p = getMatchedRows()[i].mPattern;
+        SizeThreshold const &val = mRowDataMaps[i][ProveValueMapKey].as<SizeThreshold>();
+
+        return SnmpMandatoryWarnCritCheck< SizeThreshold >::prove( val, mPatternWarn[p], mPatternCrit[p], cmp );
+    }
+
+    string createRowMessage( DataMapType const &dataMap ) const
+    {
+        unsigned long long mb = 1024ULL * 1024;
+        unsigned long long total = dataMap["total"].as<unsigned long long>();
+        unsigned long long used = dataMap["used"].as<unsigned long long>();
+        string const &mnt = dataMap["mnt"].as<string>();
+
+        double d = 0 == total ? 100.0 : ((double)used * 100) / total;
+        unsigned long long used_percent = (unsigned long long)(d + 0.5);
+
+        string msg = mnt + " " + to_string( (total - used) / mb) + " MB"
+                   + " (Usage: " + to_string(used_percent) + "%)";
+
+        return msg;
+    }
+
+    string createRowPerformanceMessage( DataMapType const &dataMap, SizeThreshold const &warn, SizeThreshold const &crit ) const
+    {
+        unsigned long long total = dataMap["total"].as<unsigned long long>();
+        unsigned long long used = dataMap["used"].as<unsigned long long>();
+        unsigned long long checkWarning = warn.is_rel() ? (unsigned long long)( warn.relative() * total ) : (unsigned long long)(warn.absolute());
+        unsigned long long checkCritical = crit.is_rel() ? (unsigned long long)( crit.relative() * total ) : (unsigned long long)(crit.absolute());
+        unsigned long long mb = 1024ULL * 1024;
+        string const &mnt = dataMap["mnt"].as<string>();
+
+        checkWarning /= mb;
+        checkCritical /= mb;
+
+        string msg = mnt + "=" + to_string( used / mb ) + "MB;"
+                   + to_string(checkWarning) + ";"
+                   + to_string(checkCritical) + ";0;"
+                   + to_string(total / mb);
+
+        return msg;
+    }
+
+    virtual string const getCheckName() const { return "FILESYSTEM"; }
+    /**
+     * contains the application name
+     */
+    virtual string const getApplName() const { return "check_fs_by_snmp"; }
+    /**
+     * contains the application version
+     */
+    virtual string const getApplVersion() const { return SSNC_VERSION_STRING; }
+    /**
+     * short description of the application
+     */
+    virtual string const getApplDescription() const { return "Check file system storage via Simple Network Management Protocol"; }
+};
+
+/**
+ * runs the check_fs_by_snmp check
+ *
+ * @param argc - argument count
+ * @param argv - argument values
+ * @param hostedEnv - environment of the hosting process, NULL when running standalone
+ *
+ * @return nagios state to use as exit code
+ */
+int
+run_check_fs_by_snmp(int argc, char *argv[], HostedEnvironment *hostedEnv = NULL)
+{
+    int rc = STATE_EXCEPTION;
+    SnmpFsCheckAppl checkAppl;
+    string msg;
+
+    checkAppl.setHostedEnvironment( hostedEnv );
+
+    try
+    {
+        checkAppl.setupFromCommandLine(argc, argv);
+        checkAppl.configure();
+        checkAppl.identifyDaemon(); // includes: getSupportedMibs();
+
+        checkAppl.fetchData();
+        checkAppl.convert();
+
+        checkAppl.createMessages();
+        rc = checkAppl.prove< AbsoluteRelativeCmp<> >();
+    }
+    catch(alarm_timeout_reached &a)
+    {
+        rc = STATE_UNKNOWN;
+        msg = a.what();
+    }
+    catch(snmp_error &s)
+    {
+        rc = STATE_UNKNOWN;
+        msg = s.what();
+    }
+    catch(std::exception& e)
+    {
+        checkAppl.getErrorStream() << (msg = e.what()) << endl;
+    }
+
+    return checkAppl.report(rc, msg);
+}
+
+#undef loggerModuleName
+
+#endif /* __SMART_SNMPD_NAGIOS_CHECKS_CHECK_FS_BY_SNMP_H_INCLUDED__ */
@@ -0,0 +1,469 @@
+/*
+ * Copyright 2010,2011 Matthias Haag, Jens Rehsack
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ *
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __SMART_SNMPD_NAGIOS_CHECKS_CHECK_HOST_BY_SNMP_H_INCLUDED__
+#define __SMART_SNMPD_NAGIOS_CHECKS_CHECK_HOST_BY_SNMP_H_INCLUDED__
+
+#include <smart-snmpd-nagios-plugins-build-defs.h>
+#include <smart-snmpd-nagios-plugins/smart-snmpd-nagios-plugins.h>
+
+#include <smart-snmpd-nagios-plugins/oids.h>
+#include <smart-snmpd-nagios-plugins/nagios-stats.h>
+#include <smart-snmpd-nagios-plugins/snmp-check.h>
+#include <smart-snmpd-nagios-plugins/snmp-check-types.h>
+#include <smart-snmpd-nagios-plugins/snmp-check-appl.h>
+
+#include "check_cpu_by_snmp.h"
+#include "check_mem_by_snmp.h"
+#include "check_swap_by_snmp.h"
+#include "check_load_by_snmp.h"
+#include "check_user_cnt_by_snmp.h"
+#include "check_proc_cnt_by_snmp.h"
+
+#include <utility>
+
+#undef loggerModuleName
+#define loggerModuleName "nagiosplugins.check"
+
+/**
+ * mib data combining the mib data of several checks into one request
+ *
+ * The data oids of all parts are requested at once, the fetched values
+ * are handed to each part for conversion. The values delivered by a part
+ * are stored with the name of the part as prefix: the value to prove
+ * as "NAME", additional values as "NAME.KEY". When a part can't convert
+ * its values, the error message is stored as "NAME.error" instead - the
+ * other parts are evaluated nevertheless.
+ */
+class CombinedMibData
+    : public SupportedMibData
+{
+public:
+    typedef vector< pair< string, SupportedMibData * > > PartsType;
+
+    /**
+     * constructor
+     *
+     * @param parts - names and mib data of the combined checks, deleted on destruction
+     */
+    CombinedMibData( PartsType const &parts )
+        : SupportedMibData( collectDataOids( parts ) )
+        , mParts( parts )
+    {}
+
+    virtual ~CombinedMibData()
+    {
+        for( PartsType::iterator i = mParts.begin(); i != mParts.end(); ++i )
+            delete i->second;
+    }
+
+    virtual void convertSnmpData( vector<Vb> const &vblist, DataMapType &dataMap )
+    {
+        if( vblist.size() < mDataOids.size() )
+            throw snmp_bad_result( "Host statistics incomplete" );
+
+        vector<Vb>::const_iterator partBegin = vblist.begin();
+        for( PartsType::iterator i = mParts.begin(); i != mParts.end(); ++i )
+        {
+            vector<Vb>::const_iterator partEnd = partBegin + i->second->getDataOids().size();
+            vector<Vb> partVbs( partBegin, partEnd );
+            partBegin = partEnd;
+
+            DataMapType partMap;
+            try
+            {
+                i->second->convertSnmpData( partVbs, partMap );
+            }
+            catch( snmp_error &e )
+            {
+                dataMap.insert( make_pair( i->first + ".error", any( string( e.what() ) ) ) );
+                continue;
+            }
+
+            for( DataMapType::const_iterator ci = partMap.begin(); ci != partMap.end(); ++ci )
+            {
+                string key = ( ci->first == ProveValueMapKey ) ? i->first : i->first + "." + ci->first;
+                dataMap.insert( make_pair( key, ci->second ) );
+            }
+        }
+    }
+
+protected:
+    PartsType mParts;
+
+    static vector<Oid> collectDataOids( PartsType const &parts )
+    {
+        vector<Oid> dataOids;
+        for( PartsType::const_iterator ci = parts.begin(); ci != parts.end(); ++ci )
+        {
+            vector<Oid> const &partOids = ci->second->getDataOids();
+            dataOids.insert( dataOids.end(), partOids.begin(), partOids.end() );
+        }
+
+        return dataOids;
+    }
+
+private:
+    CombinedMibData();
+    CombinedMibData( CombinedMibData const & );
+    CombinedMibData & operator = ( CombinedMibData const & );
+};
+
+/**
+ * check of the host health: cpu, memory, swap, load, logged in users and
+ * running processes - each with its own thresholds (--cpu-warn, --mem-crit, ...)
+ */
+class SnmpHostHealthCheck
+{
+public:
+    typedef SupportedMibData::DataMapType CheckType;
+
+    SnmpHostHealthCheck()
+        : mCpuCheck( "cpu" )
+        , mMemCheck( "mem" )
+        , mSwapCheck( "swap" )
+        , mLoadCheck( "load" )
+        , mUsersCheck( "users" )
+        , mProcsCheck( "procs" )
+    {}
+
+    virtual ~SnmpHostHealthCheck() {}
+
+    void add_check_options(options_description &checkopts) const
+    {
+        mCpuCheck.add_check_options( checkopts );
+        mMemCheck.add_check_options( checkopts );
+        mSwapCheck.add_check_options( checkopts );
+        mLoadCheck.add_check_options( checkopts );
+        mUsersCheck.add_check_options( checkopts );
+        mProcsCheck.add_check_options( checkopts );
+    }
+
+    void validate_options(variables_map const &vm) const { (void)vm; }
+
+    void configure(variables_map const &vm)
+    {
+        mCpuCheck.configure( vm );
+        mMemCheck.configure( vm );
+        mSwapCheck.configure( vm );
+        mLoadCheck.configure( vm );
+        mUsersCheck.configure( vm );
+        mProcsCheck.configure( vm );
+    }
+
+    /**
+     * proves each converted part against its thresholds
+     *
+     * @param dataMap - converted values, receives the state of each part as "NAME.state"
+     */
+    void proveParts( CheckType &dataMap ) const
+    {
+        if( dataMap.count( "cpu" ) )
+            setState( dataMap, "cpu", mCpuCheck.prove( dataMap["cpu"].as<CpuTuple>(), std::greater_equal<CpuTuple>() ) );
+        if( dataMap.count( "mem" ) )
+            setState( dataMap, "mem", mMemCheck.prove( dataMap["mem"].as<SizeThreshold>(), AbsoluteRelativeCmp<>() ) );
+        if( dataMap.count( "swap" ) )
+            setState( dataMap, "swap", mSwapCheck.prove( dataMap["swap"].as<SizeThreshold>(), AbsoluteRelativeCmp<>() ) );
+        if( dataMap.count( "load" ) )
+            setState( dataMap, "load", mLoadCheck.prove( dataMap["load"].as<LoadTuple>(), std::greater_equal<LoadTuple>() ) );
+        if( dataMap.count( "users" ) )
+            setState( dataMap, "users", mUsersCheck.prove( dataMap["users"].as<AbsoluteThreshold>(), std::greater_equal<AbsoluteThreshold>() ) );
+        if( dataMap.count( "procs" ) )
+            setState( dataMap, "procs", mProcsCheck.prove( dataMap["procs"].as<AbsoluteThreshold>(), std::greater_equal<AbsoluteThreshold>() ) );
+    }
+
+protected:
+    SnmpNamedWarnCritCheck< CpuTuple > mCpuCheck;
+    SnmpNamedWarnCritCheck< SizeThreshold > mMemCheck;
+    SnmpNamedWarnCritCheck< SizeThreshold > mSwapCheck;
+    SnmpNamedWarnCritCheck< LoadTuple > mLoadCheck;
+    SnmpNamedWarnCritCheck< AbsoluteThreshold > mUsersCheck;
+    SnmpNamedWarnCritCheck< AbsoluteThreshold > mProcsCheck;
+
+    static void setState( CheckType &dataMap, string const &part, int state )
+    {
+        dataMap.insert( make_pair( part + ".state", any( state ) ) );
+    }
+};
+
+//! names of the parts of the host health check in order of output
+static const char * const HostHealthParts[] = { "cpu", "mem", "swap", "load", "users", "procs" };
+
+class SnmpHostCheckAppl
+    : public CheckPluginAppl< FetchStaticObjects, SnmpHostHealthCheck >
+{
+public:
+    SnmpHostCheckAppl()
+        : CheckPluginAppl< FetchStaticObjects, SnmpHostHealthCheck >()
+    {}
+
+    virtual ~SnmpHostCheckAppl() {}
+
+    virtual void initSupportedSnmpDaemons()
+    {
+        mSupportedSnmpDaemons.push_back( IdentifySmartSnmpdMib );
+        mSupportedSnmpDaemons.push_back( IdentifyNetSnmpd );
+    }
+
+    virtual SupportedMibDataType * getMibData( SnmpDaemonIdentifier const &identifiedDaemon )
+    {
+        CombinedMibData::PartsType parts;
+
+        if( identifiedDaemon.getName() == IdentifySmartSnmpdMib.getName() )
+        {
+            parts.push_back( make_pair( string( "cpu" ), static_cast<SupportedMibData *>( new SmartSnmpdCpuMibData() ) ) );
+            parts.push_back( make_pair( string( "mem" ), static_cast<SupportedMibData *>( new SmartSnmpdMemMibData() ) ) );
+            parts.push_back( make_pair( string( "swap" ), static_cast<SupportedMibData *>( new SmartSnmpdSwapMibData() ) ) );
+            parts.push_back( make_pair( string( "load" ), static_cast<SupportedMibData *>( new SmartSnmpdLoadMibData() ) ) );
+            parts.push_back( make_pair( string( "users" ), static_cast<SupportedMibData *>( new SmartSnmpdUserCountMibData() ) ) );
+            parts.push_back( make_pair( string( "procs" ), static_cast<SupportedMibData *>( new SmartSnmpdProcessCountMibData() ) ) );
+        }
+        else if( identifiedDaemon.getName() == IdentifyNetSnmpd.getName() )
+        {
+            parts.push_back( make_pair( string( "cpu" ), static_cast<SupportedMibData *>( new UcdavisCpuMibData() ) ) );
+            parts.push_back( make_pair( string( "mem" ), static_cast<SupportedMibData *>( new UcdavisMemMibData() ) ) );
+            parts.push_back( make_pair( string( "swap" ), static_cast<SupportedMibData *>( new UcdavisSwapMibData() ) ) );
+            parts.push_back( make_pair( string( "load" ), static_cast<SupportedMibData *>( new UcdavisLoadMibData() ) ) );
+            parts.push_back( make_pair( string( "users" ), static_cast<SupportedMibData *>( new HostResourcesUserCountMibData() ) ) );
+            parts.push_back( make_pair( string( "procs" ), static_cast<SupportedMibData *>( new HostResourcesProcessCountMibData() ) ) );
+        }
+        else
+            throw unknown_daemon();
+
+        return new CombinedMibData( parts );
+    }
+
+    virtual void convert()
+    {
+        CheckPluginAppl< FetchStaticObjects, SnmpHostHealthCheck >::convert();
+        proveParts( mDataMap );
+    }
+
+    /**
+     * generate nagios status message
+     *
+     * @param dataMap - values for nagios status message
+     *
+     * @return string containing the generated status message, the state of each part followed by its values
+     */
+    string createResultMessage( DataMapType const &dataMap ) const
+    {
+        string msg;
+
+        for( size_t i = 0; i < lengthof(HostHealthParts); ++i )
+        {
+            string part = HostHealthParts[i];
+            if( !msg.empty() )
+                msg += ", ";
+            msg += part + " " + states[getPartState( dataMap, part )] + " (" + createPartMessage( dataMap, part ) + ")";
+        }
+
+        return msg;
+    }
+
+    /**
+     * generate performance message for monitoring
+     *
+     * @param dataMap - values for performance message
+     *
+     * @return string containing the generated performance message
+     */
+    string createPerformanceMessage( DataMapType const &dataMap ) const
+    {
+        string msg;
+        unsigned long long kb = 1024ULL;
+
+        if( dataMap.count( "cpu" ) )
+        {
+            CpuTuple const &cpu = dataMap.find( "cpu" )->second.as<CpuTuple>();
+            CpuTuple const &warn = mCpuCheck.getWarn(), &crit = mCpuCheck.getCrit();
+            msg += string("cpu_user=") + to_string(cpu.user()) + "%;" + perfThreshold(warn.user()) + ";" + perfThreshold(crit.user()) + ";0;100 "
+                 + string("cpu_system=") + to_string(cpu.system()) + "%;" + perfThreshold(warn.system()) + ";" + perfThreshold(crit.system()) + ";0;100 "
+                 + string("cpu_idle=") + to_string(cpu.idle()) + "%;;;0;100 ";
+        }
+        if( dataMap.count( "mem.avail" ) && dataMap.count( "mem.total" ) )
+        {
+            unsigned long long total = dataMap.find( "mem.total" )->second.as<unsigned long long>();
+            msg += string("mem_avail=") + to_string(dataMap.find( "mem.avail" )->second.as<unsigned long long>() / kb) + "KB;;;0;" + to_string(total / kb) + " ";
+        }
+        if( dataMap.count( "swap.avail" ) && dataMap.count( "swap.total" ) )
+        {
+            unsigned long long total = dataMap.find( "swap.total" )->second.as<unsigned long long>();
+            msg += string("swap_avail=") + to_string(dataMap.find( "swap.avail" )->second.as<unsigned long long>() / kb) + "KB;;;0;" + to_string(total / kb) + " ";
+        }
+        if( dataMap.count( "load" ) )
+        {
+            LoadTuple const &load = dataMap.find( "load" )->second.as<LoadTuple>();
+            LoadTuple const &warn = mLoadCheck.getWarn(), &crit = mLoadCheck.getCrit();
+            msg += string("load1=") + to_string(load.load1()) + ";" + perfThreshold(warn.load1()) + ";" + perfThreshold(crit.load1()) + ";0; "
+                 + string("load5=") + to_string(load.load5()) + ";" + perfThreshold(warn.load5()) + ";" + perfThreshold(crit.load5()) + ";0; "
+                 + string("load15=") + to_string(load.load15()) + ";" + perfThreshold(warn.load15()) + ";" + perfThreshold(crit.load15()) + ";0; ";
+        }
+        if( dataMap.count( "users" ) )
+        {
+            msg += string("users=") + to_string(dataMap.find( "users" )->second.as<AbsoluteThreshold>()) + ";"
+                 + perfThreshold(mUsersCheck.getWarn()) + ";" + perfThreshold(mUsersCheck.getCrit()) + ";0 ";
+        }
+        if( dataMap.count( "procs" ) )
+        {
+            msg += string("procs=") + to_string(dataMap.find( "procs" )->second.as<AbsoluteThreshold>()) + ";"
+                 + perfThreshold(mProcsCheck.getWarn()) + ";" + perfThreshold(mProcsCheck.getCrit()) + ";0 ";
+        }
+
+        if( !msg.empty() )
+            msg.erase( msg.length() - 1 );
+
+        return msg;
+    }
+
+    /**
+     * proves the values of all parts
+     *
+     * @return worst nagios state of all parts (OK < WARNING < UNKNOWN < CRITICAL)
+     */
+    int prove() const
+    {
+        SSNC_LOG_BEGIN( loggerModuleName, EVENT_LOG | 1 );
+        LOG( "proving values" );
+        LOG_END;
+
+        // a part which couldn't be checked mustn't hide a critical one
+        int worstState = STATE_OK;
+        for( size_t i = 0; i < lengthof(HostHealthParts); ++i )
+            worstState = worse_state( worstState, getPartState( mDataMap, HostHealthParts[i] ) );
+
+        return worstState;
+    }
+
+protected:
+    /**
+     * @return the state proved for part, STATE_UNKNOWN when its values couldn't be converted
+     */
+    static int getPartState( DataMapType const &dataMap, string const &part )
+    {
+        DataMapType::const_iterator ci = dataMap.find( part + ".state" );
+        return ( ci != dataMap.end() ) ? ci->second.as<int>() : STATE_UNKNOWN;
+    }
+
+    static string perfThreshold( AbsoluteThreshold const &t )
+    {
+        return t.empty() ? string() : to_string(t);
+    }
+
+    static string perfThreshold( Threshold<double> const &t )
+    {
+        return t.empty() ? string() : to_string(t);
+    }
+
+    static string createPartMessage( DataMapType const &dataMap, string const &part )
+    {
+        DataMapType::const_iterator ci = dataMap.find( part + ".error" );
+        if( ci != dataMap.end() )
+            return ci->second.as<string>();
+        if( 0 == dataMap.count( part ) )
+            return "no data";
+
+        AnyDataType const &value = dataMap.find( part )->second;
+        if( "cpu" == part )
+        {
+            CpuTuple const &cpu = value.as<CpuTuple>();
+            return string("user: ") + to_string(cpu.user()) + "% "
+                 + string("system: ") + to_string(cpu.system()) + "% "
+                 + string("idle: ") + to_string(cpu.idle()) + "%";
+        }
+        if( ( "mem" == part ) || ( "swap" == part ) )
+        {
+            unsigned long long mb = 1024ULL * 1024;
+            unsigned long long avail = dataMap.find( part + ".avail" )->second.as<unsigned long long>();
+            unsigned long long total = dataMap.find( part + ".total" )->second.as<unsigned long long>();
+            return string("avail: ") + to_string(avail/mb) + "M "
+                 + string("total: ") + to_string(total/mb) + "M";
+        }
+        if( "load" == part )
+        {
+            LoadTuple const &load = value.as<LoadTuple>();
+            return to_string(load.load1()) + " " + to_string(load.load5()) + " " + to_string(load.load15());
+        }
+
+        return to_string(value.as<AbsoluteThreshold>());
+    }
+
+    virtual string const getCheckName() const { return "HOST"; }
+    /**
+     * contains the application name
+     */
+    virtual string const getApplName() const { return "check_host_by_snmp"; }
+    /**
+     * contains the application version
+     */
+    virtual string const getApplVersion() const { return SSNC_VERSION_STRING; }
+    /**
+     * short description of the application
+     */
+    virtual string const getApplDescription() const { return "Check cpu, memory, swap, load, users and processes with one request via Simple Network Management Protocol"; }
+};
+
+/**
+ * runs the check_host_by_snmp check
+ *
+ * @param argc - argument count
+ * @param argv - argument values
+ * @param hostedEnv - environment of the hosting process, NULL when running standalone
+ *
+ * @return nagios state to use as exit code
+ */
+int
+run_check_host_by_snmp(int argc, char *argv[], HostedEnvironment *hostedEnv = NULL)
+{
+    int rc = STATE_EXCEPTION;
+    SnmpHostCheckAppl checkAppl;
+    string msg;
+
+    checkAppl.setHostedEnvironment( hostedEnv );
+
+    try
+    {
+        checkAppl.setupFromCommandLine(argc, argv);
+        checkAppl.configure();
+        checkAppl.identifyDaemon(); // includes: getSupportedMibs();
+
+        checkAppl.fetchData();
+        checkAppl.convert();
+
+        checkAppl.createMessages();
+        rc = checkAppl.prove();
+    }
+    catch(alarm_timeout_reached &a)
+    {
+        rc = STATE_UNKNOWN;
+        msg = a.what();
+    }
+    catch(snmp_error &s)
+    {
+        rc = STATE_UNKNOWN;
+        msg = s.what();
+    }
+    catch(std::exception& e)
+    {
+        checkAppl.getErrorStream() << (msg = e.what()) << endl;
+    }
+
+    return checkAppl.report(rc, msg);
+}
+
+#undef loggerModuleName
+
+#endif /* __SMART_SNMPD_NAGIOS_CHECKS_CHECK_HOST_BY_SNMP_H_INCLUDED__ */
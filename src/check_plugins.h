@@ -0,0 +1,91 @@
+/*
+ * Copyright 2010,2011 Matthias Haag, Jens Rehsack
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ *
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __SMART_SNMPD_NAGIOS_CHECKS_CHECK_PLUGINS_H_INCLUDED__
+#define __SMART_SNMPD_NAGIOS_CHECKS_CHECK_PLUGINS_H_INCLUDED__
+
+#include "check_cpu_by_snmp.h"
+#include "check_fs_by_snmp.h"
+#include "check_host_by_snmp.h"
+#include "check_load_by_snmp.h"
+#include "check_mem_by_snmp.h"
+#include "check_proc_cnt_by_snmp.h"
+#include "check_procs_by_snmp.h"
+#include "check_snmp_agent_avail.h"
+#include "check_snmp_daemon_avail.h"
+#include "check_swap_by_snmp.h"
+#include "check_user_cnt_by_snmp.h"
+
+#include <string>
+
+using namespace std;
+
+/**
+ * entry of the check plugin dispatch table
+ */
+struct CheckPluginEntry
+{
+    /**
+     * name of the check plugin (the name of the standalone binary)
+     */
+    const char *mName;
+    /**
+     * function running the check
+     */
+    CheckPluginRunFunc mRun;
+};
+
+/**
+ * all check plugins which can be hosted by a single process
+ */
+static const CheckPluginEntry CheckPlugins[] =
+{
+    { "check_cpu_by_snmp", run_check_cpu_by_snmp },
+    { "check_fs_by_snmp", run_check_fs_by_snmp },
+    { "check_host_by_snmp", run_check_host_by_snmp },
+    { "check_load_by_snmp", run_check_load_by_snmp },
+    { "check_mem_by_snmp", run_check_mem_by_snmp },
+    { "check_proc_cnt_by_snmp", run_check_proc_cnt_by_snmp },
+    { "check_procs_by_snmp", run_check_procs_by_snmp },
+    { "check_snmp_agent_avail", run_check_snmp_agent_avail },
+    { "check_snmp_daemon_avail", run_check_snmp_daemon_avail },
+    { "check_swap_by_snmp", run_check_swap_by_snmp },
+    { "check_user_cnt_by_snmp", run_check_user_cnt_by_snmp },
+};
+
+/**
+ * looks up the run function of a check plugin
+ *
+ * @param name - name of the plugin, leading directories are ignored
+ *
+ * @return run function of the plugin or NULL when unknown
+ */
+static CheckPluginRunFunc
+find_check_plugin( string const &name )
+{
+    string::size_type pos = name.find_last_of( '/' );
+    string baseName = ( pos == string::npos ) ? name : name.substr( pos + 1 );
+
+    for( size_t i = 0; i < lengthof(CheckPlugins); ++i )
+    {
+        if( baseName == CheckPlugins[i].mName )
+            return CheckPlugins[i].mRun;
+    }
+
+    return NULL;
+}
+
+#endif /* __SMART_SNMPD_NAGIOS_CHECKS_CHECK_PLUGINS_H_INCLUDED__ */
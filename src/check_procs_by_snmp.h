@@ -0,0 +1,1136 @@
+/*
+ * Copyright 2010,2011 Matthias Haag, Jens Rehsack, Volker Hein
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ *
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __SMART_SNMPD_NAGIOS_CHECKS_CHECK_PROCS_BY_SNMP_H_INCLUDED__
+#define __SMART_SNMPD_NAGIOS_CHECKS_CHECK_PROCS_BY_SNMP_H_INCLUDED__
+
+#include <smart-snmpd-nagios-plugins-build-defs.h>
+#include <smart-snmpd-nagios-plugins/smart-snmpd-nagios-plugins.h>
+
+#include <smart-snmpd-nagios-plugins/oids.h>
+#include <smart-snmpd-nagios-plugins/snmp-check.h>
+#include <smart-snmpd-nagios-plugins/snmp-check-types.h>
+#include <smart-snmpd-nagios-plugins/snmp-check-appl.h>
+#include <smart-snmpd-nagios-plugins/pattern-matcher.h>
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+#undef loggerModuleName
+#define loggerModuleName "nagiosplugins.check"
+
+/**
+ * columns of the process table which can be searched
+ */
+enum ProcessColumn
+{
+    ProcessArgumentsColumn = 0,
+    ProcessUsernameColumn,
+    ProcessGroupnameColumn,
+    ProcessEffectiveUsernameColumn,
+    ProcessEffectiveGroupnameColumn,
+    ProcessColumnCount
+};
+
+static const char * const ProcessColumnOids[ProcessColumnCount] =
+{
+    SM_PROCESS_ARGS,
+    SM_PROCESS_USERNAME,
+    SM_PROCESS_GROUPNAME,
+    SM_PROCESS_EFFECTIVE_USERNAME,
+    SM_PROCESS_EFFECTIVE_GROUPNAME
+};
+
+class ProcessTuple
+    : public boost::tuple<string, string, string, string, string>
+{
+public:
+    ProcessTuple( string const &args = "", string const &user = "", string const &group = "",
+                  string const &effectiveUser = "", string const &effectiveGroup = "" )
+        : boost::tuple<string, string, string, string, string>( args, user, group, effectiveUser, effectiveGroup )
+    {}
+
+    bool hasArguments()          const { return !get<0>().empty(); }
+    bool hasUsername()           const { return !get<1>().empty(); }
+    bool hasGroupname()          const { return !get<2>().empty(); }
+    bool hasEffectiveUsername()  const { return !get<3>().empty(); }
+    bool hasEffectiveGroupname() const { return !get<4>().empty(); }
+
+    string const & getArguments()            const { return get<0>(); }
+    string const & getUsername()             const { return get<1>(); }
+    string const & getGroupname()            const { return get<2>(); }
+    string const & getEffectiveUsername()    const { return get<3>(); }
+    string const & getEffectiveGroupname()   const { return get<4>(); }
+
+    ProcessTuple & setArguments( string const &args )           { get<0>() = args;  return *this; }
+    ProcessTuple & setUsername( string const &user )            { get<1>() = user;  return *this; }
+    ProcessTuple & setGroupname( string const &group )          { get<2>() = group; return *this; }
+    ProcessTuple & setEffectiveUsername( string const &user )   { get<3>() = user;  return *this; }
+    ProcessTuple & setEffectiveGroupname( string const &group ) { get<4>() = group; return *this; }
+};
+
+class ProcessCompareTuple
+    : public boost::tuple<string, string, string, string, string, string>
+{
+public:
+    ProcessCompareTuple( string const &command = "", string const &arg = "", string const &user = "", string const &group = "",
+                         string const &effectiveUser = "", string const &effectiveGroup = "" )
+        : boost::tuple<string, string, string, string, string, string>( command, arg, user, group, effectiveUser, effectiveGroup )
+        // argument has to be between whitespace and ( whitespace / end-of-line )
+        //
+        , mArgumentMatcher( arg, ArgumentPatternMatcher::ArgumentPosition )
+        // command has to be between begin-of-line and ( whitespace / end-of-line )
+        //
+        , mCommandMatcher( command, ArgumentPatternMatcher::CommandPosition )
+    {}
+
+    bool hasCommand()            const { return !get<0>().empty(); }
+    bool hasArgument()           const { return !get<1>().empty(); }
+    bool hasUsername()           const { return !get<2>().empty(); }
+    bool hasGroupname()          const { return !get<3>().empty(); }
+    bool hasEffectiveUsername()  const { return !get<4>().empty(); }
+    bool hasEffectiveGroupname() const { return !get<5>().empty(); }
+
+    bool empty() const
+    {
+        return !( hasCommand() || hasArgument() || hasUsername() || hasGroupname() ||
+                  hasEffectiveUsername() || hasEffectiveGroupname() );
+    }
+
+    string const & getCommand()             const { return get<0>(); }
+    string const & getArgument()            const { return get<1>(); }
+    string const & getUsername()            const { return get<2>(); }
+    string const & getGroupname()           const { return get<3>(); }
+    string const & getEffectiveUsername()   const { return get<4>(); }
+    string const & getEffectiveGroupname()  const { return get<5>(); }
+
+    ProcessCompareTuple & setCommand( string const &command )           { get<0>() = command; return *this; }
+    ProcessCompareTuple & setArgument( string const &arg )              { get<1>() = arg;     return *this; }
+    ProcessCompareTuple & setUsername( string const &user )             { get<2>() = user;    return *this; }
+    ProcessCompareTuple & setGroupname( string const &group )           { get<3>() = group;   return *this; }
+    ProcessCompareTuple & setEffectiveUsername( string const &user )    { get<4>() = user;    return *this; }
+    ProcessCompareTuple & setEffectiveGroupname( string const &group )  { get<5>() = group;   return *this; }
+
+    bool checkCommand( string const &args ) const
+    {
+        if ( ! hasCommand() )
+        {
+            // always return true if no command is given
+            //
+            return true;
+        }
+
+        return mCommandMatcher.matches( args );
+    }
+
+    bool checkArgument( string const &args ) const
+    {
+        if ( ! hasArgument() )
+        {
+            // always return true if no argument is given
+            //
+            return true;
+        }
+
+        return mArgumentMatcher.matches( args );
+    }
+
+    bool checkUsername( string const &username ) const
+    {
+        if ( ! hasUsername() )
+        {
+            // always return true if no username is given
+            //
+            return true;
+        }
+
+        return username.compare( getUsername() ) == 0;
+    }
+
+    bool checkGroupname( string const &groupname ) const
+    {
+        if ( ! hasGroupname() )
+        {
+            // always return true if no groupname is given
+            //
+            return true;
+        }
+
+        return groupname.compare( getGroupname() ) == 0;
+    }
+
+    bool checkEffectiveUsername( string const &username ) const
+    {
+        if ( ! hasEffectiveUsername() )
+        {
+            // always return true if no username is given
+            //
+            return true;
+        }
+
+        return username.compare( getEffectiveUsername() ) == 0;
+    }
+
+    bool checkEffectiveGroupname( string const &groupname ) const
+    {
+        if ( ! hasEffectiveGroupname() )
+        {
+            // always return true if no groupname is given
+            //
+            return true;
+        }
+
+        return groupname.compare( getEffectiveGroupname() ) == 0;
+    }
+
+    /**
+     * @param column - ProcessColumn to check
+     *
+     * @return true when the given column has to be fetched to check the process
+     */
+    bool constrains( int column ) const
+    {
+        switch( column )
+        {
+        case ProcessArgumentsColumn:            return hasCommand() || hasArgument();
+        case ProcessUsernameColumn:             return hasUsername();
+        case ProcessGroupnameColumn:            return hasGroupname();
+        case ProcessEffectiveUsernameColumn:    return hasEffectiveUsername();
+        case ProcessEffectiveGroupnameColumn:   return hasEffectiveGroupname();
+        }
+
+        return false;
+    }
+
+    /**
+     * checks the value of a single column
+     *
+     * @param column - ProcessColumn of value
+     * @param value - the value fetched from the process table
+     *
+     * @return true when value matches (or column isn't constrained)
+     */
+    bool checkColumn( int column, string const &value ) const
+    {
+        switch( column )
+        {
+        case ProcessArgumentsColumn:            return checkCommand( value ) && checkArgument( value );
+        case ProcessUsernameColumn:             return checkUsername( value );
+        case ProcessGroupnameColumn:            return checkGroupname( value );
+        case ProcessEffectiveUsernameColumn:    return checkEffectiveUsername( value );
+        case ProcessEffectiveGroupnameColumn:   return checkEffectiveGroupname( value );
+        }
+
+        return true;
+    }
+
+protected:
+    ArgumentPatternMatcher mArgumentMatcher;
+    ArgumentPatternMatcher mCommandMatcher;
+};
+
+std::string
+to_string(ProcessCompareTuple const &t)
+{
+    string s;
+
+    if ( t.hasCommand() )
+        s += "command=" + t.getCommand() + ",";
+    if ( t.hasArgument() )
+        s += "arg=" + t.getArgument() + ",";
+    if ( t.hasUsername() )
+        s += "username=" + t.getUsername() + ",";
+    if ( t.hasGroupname() )
+        s += "groupname=" + t.getGroupname() + ",";
+    if ( t.hasEffectiveUsername() )
+        s += "eff_username=" + t.getEffectiveUsername() + ",";
+    if ( t.hasEffectiveGroupname() )
+        s += "eff_groupname=" + t.getEffectiveGroupname();
+
+    if ( s[ s.length() - 1 ] == ',' )
+        s.erase( s.length() - 1 );
+
+    return s;
+}
+
+/**
+ * named process specification given by --process-spec or --process-spec-file
+ *
+ * A specification is written as LABEL;KEY=VALUE;... where KEY is one of
+ * command, argument, username, groupname, effective-username and
+ * effective-groupname (matched like the corresponding process-* options)
+ * or warn and crit (range thresholds of this specification, --warn and
+ * --crit are used when missing). In nagios object definitions the
+ * separators have to be written as \; - ";" starts a comment there. The
+ * specification files need no escaping.
+ */
+class ProcessSpec
+{
+public:
+    ProcessSpec( string const &label = "", ProcessCompareTuple const &compare = ProcessCompareTuple(),
+                 string const &warn = "", string const &crit = "" )
+        : mLabel( label )
+        , mCompare( compare )
+        , mWarn( warn )
+        , mCrit( crit )
+    {}
+
+    /**
+     * parses a process specification
+     *
+     * @param spec - LABEL;KEY=VALUE;...
+     *
+     * @return the parsed specification
+     */
+    static ProcessSpec parse( string const &spec )
+    {
+        string command, argument, username, groupname, effectiveUsername, effectiveGroupname, warn, crit;
+        string::size_type st = spec.find( ';' );
+        string label = spec.substr( 0, st );
+
+        while( st != string::npos )
+        {
+            string::size_type sb = st + 1;
+            st = spec.find( ';', sb );
+            string field( spec, sb, st == string::npos ? string::npos : st - sb );
+            if( field.empty() )
+                continue;
+
+            string::size_type eq = field.find( '=' );
+            if( eq == string::npos )
+                throw validation_error( validation_error::invalid_option_value, spec, "process-spec" );
+
+            string key( field, 0, eq ), value( field, eq + 1 );
+            if( key == "command" )
+                command = value;
+            else if( key == "argument" )
+                argument = value;
+            else if( key == "username" )
+                username = value;
+            else if( key == "groupname" )
+                groupname = value;
+            else if( key == "effective-username" )
+                effectiveUsername = value;
+            else if( key == "effective-groupname" )
+                effectiveGroupname = value;
+            else if( key == "warn" )
+                warn = value;
+            else if( key == "crit" )
+                crit = value;
+            else
+                throw validation_error( validation_error::invalid_option_value, spec, "process-spec" );
+        }
+
+        ProcessCompareTuple compare( command, argument, username, groupname, effectiveUsername, effectiveGroupname );
+        if( label.empty() || compare.empty() )
+            throw validation_error( validation_error::invalid_option_value, spec, "process-spec" );
+
+        return ProcessSpec( label, compare, warn, crit );
+    }
+
+    string const & getLabel() const { return mLabel; }
+    ProcessCompareTuple const & getCompare() const { return mCompare; }
+    string const & getWarn() const { return mWarn; }
+    string const & getCrit() const { return mCrit; }
+
+protected:
+    string mLabel;
+    ProcessCompareTuple mCompare;
+    string mWarn;
+    string mCrit;
+};
+
+class ProcessMap
+    : public std::map<long, ProcessTuple>
+{
+protected:
+    typedef std::map<long, ProcessTuple> MapType;
+
+public:
+    MapType::iterator
+    addOrUpdateArgs( long key, string const &args )
+    {
+        MapType::iterator lb = lower_bound(key);
+
+        if ( lb != end() && !( key_comp()( key, lb->first )))
+        {
+            lb->second.setArguments( args );
+            return lb;
+        }
+        else
+        {
+            typedef MapType::value_type MVT;
+
+            ProcessTuple pt( args );
+            return insert( lb, MVT( key, pt ) );
+        }
+    }
+
+    MapType::iterator
+    addOrUpdateUsername( long key, string const &username )
+    {
+        MapType::iterator lb = lower_bound(key);
+
+        if ( lb != end() && !( key_comp()( key, lb->first )))
+        {
+            lb->second.setUsername( username );
+            return lb;
+        }
+        else
+        {
+            typedef MapType::value_type MVT;
+
+            ProcessTuple pt( "", username );
+            return insert( lb, MVT( key, pt ) );
+        }
+    }
+
+    MapType::iterator
+    addOrUpdateGroupname( long key, string const &groupname )
+    {
+        MapType::iterator lb = lower_bound(key);
+
+        if ( lb != end() && !( key_comp()( key, lb->first )))
+        {
+            lb->second.setGroupname( groupname );
+            return lb;
+        }
+        else
+        {
+            typedef MapType::value_type MVT;
+
+            ProcessTuple pt( "", "", groupname );
+            return insert( lb, MVT( key, pt ) );
+        }
+    }
+
+    MapType::iterator
+    addOrUpdateEffectiveUsername( long key, string const &username )
+    {
+        MapType::iterator lb = lower_bound(key);
+
+        if ( lb != end() && !( key_comp()( key, lb->first )))
+        {
+            lb->second.setEffectiveUsername( username );
+            return lb;
+        }
+        else
+        {
+            typedef MapType::value_type MVT;
+
+            ProcessTuple pt( "", "", "", username );
+            return insert( lb, MVT( key, pt ) );
+        }
+    }
+
+    MapType::iterator
+    addOrUpdateEffectiveGroupname( long key, string const &groupname )
+    {
+        MapType::iterator lb = lower_bound(key);
+
+        if ( lb != end() && !( key_comp()( key, lb->first )))
+        {
+            lb->second.setEffectiveGroupname( groupname );
+            return lb;
+        }
+        else
+        {
+            typedef MapType::value_type MVT;
+
+            ProcessTuple pt( "", "", "", "", groupname );
+            return insert( lb, MVT( key, pt ) );
+        }
+    }
+};
+
+class SmartSnmpdProcessesMibData
+{
+public:
+    typedef AnyDataMap DataMapType;
+
+    SmartSnmpdProcessesMibData() {}
+
+    virtual ~SmartSnmpdProcessesMibData() {}
+
+    virtual void convertSnmpData( ProcessMap &processMap, DataMapType &dataMap )
+    {
+        // just push the length of the process map as prove value
+        //
+        AbsoluteThreshold count( processMap.size() );
+
+        dataMap.insert( make_pair( ProveValueMapKey, RangeThreshold<AbsoluteThreshold>( count, count ) ) );
+        dataMap.insert( make_pair( "count", count ) );
+    }
+};
+
+/**
+ * collects the processes matching each of several process specifications
+ * while walking the process table once
+ *
+ * Only the columns constrained by any of the specifications need to be
+ * walked - the columns of the rows passed in are given by columns.
+ */
+class GetBulkProcesses
+{
+public:
+    GetBulkProcesses( vector<ProcessCompareTuple> const &aProcessComperatorTuples, vector<int> const &columns, vector<ProcessMap> &result_bufs )
+        : mStart( SM_PROCESS_ENTRY )
+        , mResultBufs( result_bufs )
+        , mProcessCompares( aProcessComperatorTuples )
+        , mColumns( columns )
+    {
+        mResultBufs.resize( mProcessCompares.size() );
+    }
+
+    ~GetBulkProcesses() {}
+
+    template < class Row >
+    bool operator () (Row const &varBinds)
+    {
+        // OIDs come in the order of mColumns, unfetched columns remain empty
+        //
+//        cout << "BULKING" << endl;
+
+        Oid idxOid;
+        long lineIdx = -1;
+
+        string values[ProcessColumnCount];
+        for( vector<int>::size_type c = 0; c < mColumns.size(); ++c )
+            SnmpComm::extract_value( varBinds[ c ], values[ mColumns[c] ] );
+
+        // check if values match the given filters - a process may match several of them
+        //
+        for( vector<ProcessCompareTuple>::size_type i = 0; i < mProcessCompares.size(); ++i )
+        {
+            bool matches = true;
+            for( int c = 0; matches && ( c < ProcessColumnCount ); ++c )
+                matches = mProcessCompares[i].checkColumn( c, values[c] );
+
+            if( matches )
+            {
+                if( -1 == lineIdx )
+                {
+                    varBinds[ 0 ].get_oid( idxOid );
+                    lineIdx = idxOid[ idxOid.len() - 1 ];
+                }
+
+                mResultBufs[i].insert( make_pair( lineIdx,
+                        ProcessTuple( values[ProcessArgumentsColumn], values[ProcessUsernameColumn], values[ProcessGroupnameColumn],
+                                      values[ProcessEffectiveUsernameColumn], values[ProcessEffectiveGroupnameColumn] ) ) );
+            }
+        }
+        return false;
+    }
+
+protected:
+    Oid const mStart;
+    vector<ProcessMap> &mResultBufs;
+    vector<ProcessCompareTuple> const &mProcessCompares;
+    vector<int> const &mColumns;
+
+private:
+    GetBulkProcesses();
+};
+
+/**
+ * collects the index of the rows whose value in column matches any of
+ * the process specifications (first phase of a two phase walk)
+ */
+class GetBulkProcessCandidates
+{
+public:
+    GetBulkProcessCandidates( vector<ProcessCompareTuple> const &aProcessComperatorTuples, int column, vector<Vb> &candidates )
+        : mCandidates( candidates )
+        , mProcessCompares( aProcessComperatorTuples )
+        , mColumn( column )
+    {}
+
+    ~GetBulkProcessCandidates() {}
+
+    template < class Row >
+    bool operator () (Row const &varBinds)
+    {
+        string value;
+        SnmpComm::extract_value( varBinds[ 0 ], value );
+
+        for( vector<ProcessCompareTuple>::const_iterator ci = mProcessCompares.begin(); ci != mProcessCompares.end(); ++ci )
+        {
+            if( ci->checkColumn( mColumn, value ) )
+            {
+                mCandidates.push_back( varBinds[ 0 ] );
+                break;
+            }
+        }
+
+        return false;
+    }
+
+protected:
+    vector<Vb> &mCandidates;
+    vector<ProcessCompareTuple> const &mProcessCompares;
+    int const mColumn;
+
+private:
+    GetBulkProcessCandidates();
+};
+
+class FetchProcessObjects
+    : public FetchStaticObjects
+{
+protected:
+    typedef SmartSnmpdProcessesMibData SupportedMibDataType ;
+
+public:
+    FetchProcessObjects()
+        : FetchStaticObjects()
+        , mProcessSpecs()
+        , mMultiSpec( false )
+        , mFetchedData()
+        , mSpecFetchedData()
+        , mTwoPhaseWalk( false )
+    {}
+
+    virtual void add_check_options(options_description &checkopts) const
+    {
+        checkopts.add_options()
+            ("process-command,P", value<string>(), "command of the process to check")
+            ("process-argument,A", value<string>(), "argument of the process to check")
+            ("process-username,u", value<string>(), "username of the process to check")
+            ("process-groupname,g", value<string>(), "groupname of the process to check")
+            ("process-effective-username,U", value<string>(), "effective username of the process to check")
+            ("process-effective-groupname,G", value<string>(), "effective groupname of the process to check")
+            ("process-spec", value< vector<string> >()->composing(), "named process specification LABEL;KEY=VALUE;... to check, may be repeated "
+                                                                "(nagios object definitions need \\; since ; starts a comment there)")
+            ("process-spec-file", value<string>(), "file containing one named process specification per line")
+            ("two-phase-walk", value<bool>()->default_value(false), "walk one column searched by all process specifications first and get the other columns of matching processes only")
+            ;
+    }
+
+    virtual void validate_options() const
+    {
+        vector<const char *> v;
+        v.push_back( "process-command" );
+        v.push_back( "process-argument" );
+        v.push_back( "process-username" );
+        v.push_back( "process-groupname" );
+        v.push_back( "process-effective-username" );
+        v.push_back( "process-effective-groupname" );
+        v.push_back( "process-spec" );
+        v.push_back( "process-spec-file" );
+        option_required( mCmndlineValuesMap, v );
+    }
+
+    virtual void configure()
+    {
+        SnmpAppl::configure();
+
+        string command, argument, username, groupname, effectiveUsername, effectiveGroupname;
+
+        if ( mCmndlineValuesMap.count("process-command") )
+        {
+            command = mCmndlineValuesMap["process-command"].as<string>();
+        }
+        if ( mCmndlineValuesMap.count("process-argument") )
+        {
+            argument = mCmndlineValuesMap["process-argument"].as<string>();
+        }
+        if ( mCmndlineValuesMap.count("process-username") )
+        {
+            username = mCmndlineValuesMap["process-username"].as<string>();
+        }
+        if ( mCmndlineValuesMap.count("process-groupname") )
+        {
+            groupname = mCmndlineValuesMap["process-groupname"].as<string>();
+        }
+        if ( mCmndlineValuesMap.count("process-effective-username") )
+        {
+            effectiveUsername = mCmndlineValuesMap["process-effective-username"].as<string>();
+        }
+        if ( mCmndlineValuesMap.count("process-effective-groupname") )
+        {
+            effectiveGroupname = mCmndlineValuesMap["process-effective-groupname"].as<string>();
+        }
+
+        mProcessSpecs.clear();
+
+        // the process-* options form the specification "count" (the label of their performance data)
+        //
+        ProcessCompareTuple processCompare( command, argument, username, groupname, effectiveUsername, effectiveGroupname );
+        if( !processCompare.empty() )
+            mProcessSpecs.push_back( ProcessSpec( "count", processCompare ) );
+
+        mMultiSpec = false;
+        if ( mCmndlineValuesMap.count("process-spec") )
+        {
+            vector<string> const &specs = mCmndlineValuesMap["process-spec"].as< vector<string> >();
+            for( vector<string>::const_iterator ci = specs.begin(); ci != specs.end(); ++ci )
+                mProcessSpecs.push_back( ProcessSpec::parse( *ci ) );
+            mMultiSpec = true;
+        }
+        if ( mCmndlineValuesMap.count("process-spec-file") )
+        {
+            readProcessSpecFile( mCmndlineValuesMap["process-spec-file"].as<string>() );
+            mMultiSpec = true;
+        }
+
+        if( mProcessSpecs.empty() )
+            throw runtime_error( "No process specification to check" );
+
+        mTwoPhaseWalk = mCmndlineValuesMap.count("two-phase-walk") && mCmndlineValuesMap["two-phase-walk"].as<bool>();
+    }
+
+    void fetchData(SmartSnmpdProcessesMibData &mibData)
+    {
+        (void)mibData;
+
+        vector<ProcessCompareTuple> processCompares;
+        for( vector<ProcessSpec>::const_iterator ci = mProcessSpecs.begin(); ci != mProcessSpecs.end(); ++ci )
+            processCompares.push_back( ci->getCompare() );
+
+        // walk only the columns searched by any of the process specifications
+        //
+        vector<int> columns;
+        for( int c = 0; c < ProcessColumnCount; ++c )
+        {
+            for( vector<ProcessCompareTuple>::const_iterator ci = processCompares.begin(); ci != processCompares.end(); ++ci )
+            {
+                if( ci->constrains( c ) )
+                {
+                    columns.push_back( c );
+                    break;
+                }
+            }
+        }
+
+        int phaseColumn = mTwoPhaseWalk ? selectPhaseColumn( processCompares, columns ) : -1;
+        if( -1 != phaseColumn )
+        {
+            columns.erase( find( columns.begin(), columns.end(), phaseColumn ) );
+            columns.insert( columns.begin(), phaseColumn );
+        }
+
+        vector<ProcessMap> fetchedData;
+        GetBulkProcesses searchMatchingRows( processCompares, columns, fetchedData );
+
+        // the uptime is requested as non-repeater of the first request of the walk
+        vector<Vb> scalars;
+        if( mFetchSysUpTime )
+            scalars.push_back( Vb( Oid( SYS_UPTIME ".0" ) ) );
+
+        if( -1 == phaseColumn )
+        {
+            vector<Oid> procOids;
+            for( vector<int>::const_iterator ci = columns.begin(); ci != columns.end(); ++ci )
+                procOids.push_back( Oid( ProcessColumnOids[*ci] ) );
+
+            if( SNMP_CLASS_SUCCESS != mSnmpComm.get_table_snapshot( Oid( SM_LAST_UPDATE_PROCESS_STATUS ), scalars, procOids, searchMatchingRows ) )
+                throw snmp_bad_request( string( "Cannot fetch values to search from " + getDaemonName() ) );
+        }
+        else
+        {
+            fetchTwoPhase( processCompares, columns, scalars, searchMatchingRows );
+        }
+
+        mFetchedData.clear();
+        mSpecFetchedData.clear();
+        if( mMultiSpec )
+            mSpecFetchedData.swap( fetchedData );
+        else
+            mFetchedData.swap( fetchedData.front() );
+
+        if( mFetchSysUpTime )
+            mSysUpTime = scalars.front();
+    }
+
+    ProcessMap const & getFetchedData() const { return mFetchedData; }
+
+    /**
+     * @return true when named process specifications are checked
+     */
+    bool isMultiSpec() const { return mMultiSpec; }
+
+    vector<ProcessSpec> const & getProcessSpecs() const { return mProcessSpecs; }
+
+    /**
+     * @return the processes matching each process specification (when isMultiSpec())
+     */
+    vector<ProcessMap> const & getSpecFetchedData() const { return mSpecFetchedData; }
+
+protected:
+    vector<ProcessSpec> mProcessSpecs;
+    bool mMultiSpec;
+    ProcessMap mFetchedData;
+    vector<ProcessMap> mSpecFetchedData;
+    bool mTwoPhaseWalk;
+
+    /**
+     * selects the column to walk first in two phase mode
+     *
+     * The column has to be searched by all process specifications, short
+     * names are preferred over the arguments.
+     *
+     * @return ProcessColumn to walk first, -1 when walking all columns at once is preferable
+     */
+    static int selectPhaseColumn( vector<ProcessCompareTuple> const &processCompares, vector<int> const &columns )
+    {
+        static const int preferredColumns[] =
+        {
+            ProcessEffectiveUsernameColumn, ProcessUsernameColumn,
+            ProcessEffectiveGroupnameColumn, ProcessGroupnameColumn,
+            ProcessArgumentsColumn
+        };
+
+        if( columns.size() < 2 )
+            return -1;
+
+        for( size_t i = 0; i < lengthof(preferredColumns); ++i )
+        {
+            bool searchedByAll = true;
+            for( vector<ProcessCompareTuple>::const_iterator ci = processCompares.begin(); searchedByAll && ci != processCompares.end(); ++ci )
+                searchedByAll = ci->constrains( preferredColumns[i] );
+
+            if( searchedByAll )
+                return preferredColumns[i];
+        }
+
+        return -1;
+    }
+
+    /**
+     * walks the first of columns and gets the remaining columns for the
+     * rows matching any of the process specifications
+     *
+     * @param processCompares - the process specifications
+     * @param columns - ProcessColumn to walk first followed by the columns to get
+     * @param scalars - scalars to fetch along with the first column, receive the values
+     * @param searchMatchingRows - receives the complete candidate rows
+     */
+    void fetchTwoPhase( vector<ProcessCompareTuple> const &processCompares, vector<int> const &columns, vector<Vb> &scalars, GetBulkProcesses &searchMatchingRows )
+    {
+        vector<Vb> candidates;
+        GetBulkProcessCandidates searchCandidates( processCompares, columns.front(), candidates );
+
+        vector<Oid> phaseOids( 1, Oid( ProcessColumnOids[columns.front()] ) );
+        if( SNMP_CLASS_SUCCESS != mSnmpComm.get_table_snapshot( Oid( SM_LAST_UPDATE_PROCESS_STATUS ), scalars, phaseOids, searchCandidates ) )
+            throw snmp_bad_request( string( "Cannot fetch values to search from " + getDaemonName() ) );
+
+        SSNC_LOG_BEGIN( loggerModuleName, DEBUG_LOG | 5 );
+        LOG( "FetchProcessObjects::fetchTwoPhase: candidate rows" );
+        LOG( candidates.size() );
+        LOG_END;
+
+        if( candidates.empty() )
+            return;
+
+        vector<int>::size_type others = columns.size() - 1;
+        vector<Vb> request;
+        request.reserve( candidates.size() * others );
+        for( vector<Vb>::const_iterator ci = candidates.begin(); ci != candidates.end(); ++ci )
+        {
+            Oid idxOid;
+            ci->get_oid( idxOid );
+            unsigned long idx = idxOid[ idxOid.len() - 1 ];
+
+            for( vector<int>::size_type c = 1; c < columns.size(); ++c )
+            {
+                Oid colOid( ProcessColumnOids[columns[c]] );
+                colOid += idx;
+                request.push_back( Vb( colOid ) );
+            }
+        }
+
+        if( SNMP_CLASS_SUCCESS != mSnmpComm.get( request ) )
+            throw snmp_bad_request( string( "Cannot fetch values of candidate processes from " + getDaemonName() ) );
+
+        for( vector<Vb>::size_type i = 0; i < candidates.size(); ++i )
+        {
+            vector<Vb> row( 1, candidates[i] );
+            row.insert( row.end(), request.begin() + i * others, request.begin() + ( i + 1 ) * others );
+            searchMatchingRows( row );
+        }
+    }
+
+    /**
+     * reads process specifications from given file - empty lines and lines starting with # are skipped
+     */
+    void readProcessSpecFile( string const &fileName )
+    {
+        ifstream ifs( fileName.c_str() );
+        if( !ifs )
+            throw runtime_error( string( "Can't open process specification file '" ) + fileName + "'" );
+
+        string line;
+        while( getline( ifs, line ) )
+        {
+            string::size_type pos = line.find_first_not_of( " \t\r" );
+            if( ( pos == string::npos ) || ( '#' == line[pos] ) )
+                continue;
+
+            string::size_type end = line.find_last_not_of( " \t\r" );
+            mProcessSpecs.push_back( ProcessSpec::parse( line.substr( pos, end - pos + 1 ) ) );
+        }
+    }
+};
+
+class SnmpProcsCheckAppl
+    : public CheckPluginAppl< FetchProcessObjects, SnmpWarnCritCheck< RangeThreshold<AbsoluteThreshold> >, false >
+{
+protected:
+    typedef CheckPluginAppl< FetchProcessObjects, SnmpWarnCritCheck< RangeThreshold<AbsoluteThreshold> >, false > BaseApplType;
+    typedef RangeThreshold<AbsoluteThreshold> ProcsThreshold;
+
+public:
+    SnmpProcsCheckAppl()
+        : BaseApplType()
+        , mSpecWarn()
+        , mSpecCrit()
+        , mSpecDataMaps()
+    {}
+
+    virtual ~SnmpProcsCheckAppl() {}
+
+    /**
+     * configures application
+     *
+     * Process specifications without own thresholds use --warn/--crit.
+     */
+    void configure()
+    {
+        BaseApplType::configure();
+
+        mSpecWarn.clear();
+        mSpecCrit.clear();
+        for( vector<ProcessSpec>::const_iterator ci = getProcessSpecs().begin(); ci != getProcessSpecs().end(); ++ci )
+        {
+            mSpecWarn.push_back( ci->getWarn().empty() ? getWarn() : parseThreshold( ci->getWarn() ) );
+            mSpecCrit.push_back( ci->getCrit().empty() ? getCrit() : parseThreshold( ci->getCrit() ) );
+        }
+    }
+
+    virtual void convert()
+    {
+        if( !isMultiSpec() )
+        {
+            BaseApplType::convert();
+            return;
+        }
+
+        SSNC_LOG_BEGIN( loggerModuleName, EVENT_LOG | 1 );
+        LOG( "normalizing and converting fetched processes" );
+        LOG_END;
+
+        if( NULL == mSupportedMibData )
+            throw( runtime_error( "out of order execution of SnmpProcsCheckAppl::convert()" ) );
+
+        mSpecDataMaps.assign( mSpecFetchedData.size(), DataMapType() );
+        for( vector<ProcessMap>::size_type i = 0; i < mSpecFetchedData.size(); ++i )
+            mSupportedMibData->convertSnmpData( mSpecFetchedData[i], mSpecDataMaps[i] );
+    }
+
+    /**
+     * proves the count of the fetched processes
+     *
+     * @return nagios status code, the worst one of all process specifications when several are checked
+     */
+    template < class Cmp >
+    int prove( Cmp const &cmp = Cmp() ) const
+    {
+        if( !isMultiSpec() )
+            return BaseApplType::prove( cmp );
+
+        int worstState = STATE_OK;
+        for( vector<DataMapType>::size_type i = 0; i < mSpecDataMaps.size(); ++i )
+        {
+            worstState = worse_state( worstState, proveSpec( i, cmp ) );
+        }
+
+        return worstState;
+    }
+
+    virtual void initSupportedSnmpDaemons()
+    {
+        mSupportedSnmpDaemons.push_back( IdentifySmartSnmpdMib );
+    }
+
+    virtual SupportedMibDataType * getMibData( SnmpDaemonIdentifier const &identifiedDaemon )
+    {
+        if( identifiedDaemon.getName() == IdentifySmartSnmpdMib.getName() )
+        {
+            return new SmartSnmpdProcessesMibData();
+        }
+
+        throw unknown_daemon();
+    }
+
+    string createResultMessage( DataMapType const &dataMap ) const
+    {
+        if( isMultiSpec() )
+        {
+            string msg;
+            for( vector<DataMapType>::size_type i = 0; i < mSpecDataMaps.size(); ++i )
+            {
+                AbsoluteThreshold count = mSpecDataMaps[i]["count"].as<AbsoluteThreshold>();
+
+                msg += msg.empty() ? "Processes: " : ", ";
+                msg += getProcessSpecs()[i].getLabel() + " " + to_string( count );
+
+                int state = proveSpec( i, RangeCmp<AbsoluteThreshold>() );
+                if( STATE_OK != state )
+                    msg += string( " " ) + states[state];
+            }
+
+            return msg;
+        }
+
+        AbsoluteThreshold count = dataMap["count"].as<AbsoluteThreshold>();
+
+        string summary = "( " + to_string( getProcessSpecs().front().getCompare() ) + " )";
+
+        string msg = string( to_string( count ) + " Processes " + summary );
+
+        return msg;
+    }
+
+    string createPerformanceMessage( DataMapType const &dataMap ) const
+    {
+        if( isMultiSpec() )
+        {
+            string msg;
+            for( vector<DataMapType>::size_type i = 0; i < mSpecDataMaps.size(); ++i )
+            {
+                AbsoluteThreshold count = mSpecDataMaps[i]["count"].as<AbsoluteThreshold>();
+
+                if( !msg.empty() )
+                    msg += " ";
+                msg += getProcessSpecs()[i].getLabel() + "=" + to_string( count ) + ";"
+                     + thresholdPerformanceRange( mSpecWarn[i] ) + ";"
+                     + thresholdPerformanceRange( mSpecCrit[i] );
+            }
+
+            return msg;
+        }
+
+        AbsoluteThreshold count = dataMap["count"].as<AbsoluteThreshold>();
+        return string("count=" + to_string( count ) );
+    }
+
+protected:
+    /**
+     * thresholds of each process specification
+     */
+    vector<ProcsThreshold> mSpecWarn;
+    vector<ProcsThreshold> mSpecCrit;
+    /**
+     * converted values of each process specification
+     */
+    vector<DataMapType> mSpecDataMaps;
+
+    static ProcsThreshold parseThreshold( string const &s )
+    {
+        boost::any v;
+        vector<string> vs;
+        vs.push_back( s );
+        validate( v, vs, (ProcsThreshold *)0, 0 );
+
+        return any_cast<ProcsThreshold>( v );
+    }
+
+    /**
+     * @return the threshold in the range syntax of nagios performance data, empty when not set
+     */
+    static string thresholdPerformanceRange( ProcsThreshold const &t )
+    {
+        if( !t.hasThresholdMin() && !t.hasThresholdMax() )
+            return string();
+
+        return ( t.isNegated() ? "@" : "" ) + to_string( t );
+    }
+
+    template < class Cmp >
+    int proveSpec( vector<DataMapType>::size_type i, Cmp const &cmp ) const
+    {
+        ProcsThreshold const &val = mSpecDataMaps[i][ProveValueMapKey].as<ProcsThreshold>();
+
+        return SnmpWarnCritCheck< ProcsThreshold >::prove( val, mSpecWarn[i], mSpecCrit[i], cmp );
+    }
+
+    virtual string const getCheckName() const { return "PROCS_EXT"; }
+    /**
+     * contains the application name
+     */
+    virtual string const getApplName() const { return "check_procs_by_snmp"; }
+    /**
+     * contains the application version
+     */
+    virtual string const getApplVersion() const { return SSNC_VERSION_STRING; }
+    /**
+     * short description of the application
+     */
+    virtual string const getApplDescription() const { return "Check count of a certain running process via Simple Network Management Protocol"; }
+};
+
+/**
+ * runs the check_procs_by_snmp check
+ *
+ * @param argc - argument count
+ * @param argv - argument values
+ * @param hostedEnv - environment of the hosting process, NULL when running standalone
+ *
+ * @return nagios state to use as exit code
+ */
+int
+run_check_procs_by_snmp(int argc, char *argv[], HostedEnvironment *hostedEnv = NULL)
+{
+    int rc = STATE_EXCEPTION;
+    SnmpProcsCheckAppl checkAppl;
+    string msg;
+
+    checkAppl.setHostedEnvironment( hostedEnv );
+
+    try
+    {
+        checkAppl.setupFromCommandLine(argc, argv);
+        checkAppl.configure();
+        checkAppl.identifyDaemon(); // includes: getSupportedMibs();
+
+        checkAppl.fetchData();
+        checkAppl.convert();
+
+        checkAppl.createMessages();
+        rc = checkAppl.prove< RangeCmp<AbsoluteThreshold> >();
+    }
+    catch(alarm_timeout_reached &a)
+    {
+        rc = STATE_UNKNOWN;
+        msg = a.what();
+    }
+    catch(snmp_error &s)
+    {
+        rc = STATE_UNKNOWN;
+        msg = s.what();
+    }
+    catch(std::exception& e)
+    {
+        checkAppl.getErrorStream() << (msg = e.what()) << endl;
+    }
+
+    return checkAppl.report(rc, msg);
+}
+
+#undef loggerModuleName
+
+#endif /* __SMART_SNMPD_NAGIOS_CHECKS_CHECK_PROCS_BY_SNMP_H_INCLUDED__ */
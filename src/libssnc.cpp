@@ -0,0 +1,68 @@
+/*
+ * Copyright 2010,2011 Matthias Haag, Jens Rehsack
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ *
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * libssnc - all check plugins in one shared library
+ *
+ * The check plugins and the header-only stack they're built on are
+ * instantiated once here instead of once per plugin binary, so
+ * concurrently running checks share the pages of one object.
+ */
+
+#include "check_plugins.h"
+#include "libssnc.h"
+
+/**
+ * name the multi-call binary is installed as
+ */
+#define SSNC_MULTI_CALL_NAME "smart-snmpd-check"
+
+int
+ssnc_main(int argc, char *argv[])
+{
+    string::size_type pos;
+    string pluginName( argv[0] );
+    if( ( pos = pluginName.find_last_of( '/' ) ) != string::npos )
+        pluginName.erase( 0, pos + 1 );
+
+    // allow "smart-snmpd-check check_xxx [options]" additionally to symlinks
+    if( pluginName == SSNC_MULTI_CALL_NAME )
+    {
+        if( argc < 2 )
+        {
+            cerr << "usage: " << argv[0] << " <check plugin> [plugin options]" << endl
+                 << "check plugins:";
+            for( size_t i = 0; i < lengthof(CheckPlugins); ++i )
+                cerr << " " << CheckPlugins[i].mName;
+            cerr << endl;
+            return STATE_UNKNOWN;
+        }
+
+        pluginName = argv[1];
+        ++argv;
+        --argc;
+    }
+
+    CheckPluginRunFunc runFunc = find_check_plugin( pluginName );
+    if( NULL == runFunc )
+    {
+        cout << "UNKNOWN - unknown check plugin " << pluginName << endl;
+        return STATE_UNKNOWN;
+    }
+
+    return run_check_plugin( argc, argv, runFunc );
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright 2010,2011 Matthias Haag, Jens Rehsack
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ *
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __SMART_SNMPD_NAGIOS_CHECKS_LIBSSNC_H_INCLUDED__
+#define __SMART_SNMPD_NAGIOS_CHECKS_LIBSSNC_H_INCLUDED__
+
+/*
+ * interface of libssnc - the shared library containing all check plugins
+ *
+ * Kept free of SNMP++ and boost, the multi-call binary includes nothing
+ * else and all code is shared between concurrently running checks.
+ */
+
+/**
+ * runs the check plugin named by argv[0]
+ *
+ * When argv[0] names the multi-call binary itself, argv[1] names the
+ * check plugin ("smart-snmpd-check check_cpu_by_snmp -H ...").
+ *
+ * @param argc - argument count
+ * @param argv - argument values
+ *
+ * @return nagios state to use as exit code
+ */
+int ssnc_main(int argc, char *argv[]);
+
+#endif /* __SMART_SNMPD_NAGIOS_CHECKS_LIBSSNC_H_INCLUDED__ */
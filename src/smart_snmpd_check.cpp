@@ -0,0 +1,31 @@
+/*
+ * Copyright 2010,2011 Matthias Haag, Jens Rehsack
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ *
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * multi-call binary running the check plugin it's called as
+ *
+ * Installed once with symbolic links named like the check plugins, the
+ * plugins themselves are contained in libssnc.
+ */
+
+#include "libssnc.h"
+
+int
+main(int argc, char *argv[])
+{
+    return ssnc_main(argc, argv);
+}
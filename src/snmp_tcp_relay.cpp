@@ -0,0 +1,161 @@
+/*
+ * Copyright 2010,2011 Matthias Haag, Jens Rehsack
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ *
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * stand-in for an agent accepting SNMP over TCP (RFC 3430)
+ *
+ * Accepts tcp connections and forwards each message received to an agent
+ * listening on udp, the responses are sent back over the connection. This
+ * allows verifying --transport tcp against any agent, e.g. the test agent:
+ *
+ *   make snmp_tcp_relay
+ *   ./snmp_tcp_relay -l 8161 -a 127.0.0.1 -p 8161 &
+ *   ./check_procs_by_snmp -H 127.0.0.1 -p 8161 -C public -V 2C --transport tcp ...
+ */
+
+#include <smart-snmpd-nagios-plugins-build-defs.h>
+#include <smart-snmpd-nagios-plugins/smart-snmpd-nagios-plugins.h>
+#include <smart-snmpd-nagios-plugins/snmp-tcp-transport.h>
+
+#include <arpa/inet.h>
+#include <signal.h>
+#include <stdlib.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * milliseconds to wait for the response of the udp agent
+ */
+static const int RelayAgentTimeout = 5000;
+
+/**
+ * forwards the messages of one connection until it's closed
+ */
+static int
+relay( int client, struct sockaddr_in const &agent )
+{
+    int udp = socket( AF_INET, SOCK_DGRAM, 0 );
+    if( ( -1 == udp ) || ( -1 == connect( udp, (struct sockaddr const *)&agent, sizeof(agent) ) ) )
+    {
+        cerr << "Can't create udp socket: " << strerror(errno) << endl;
+        return 1;
+    }
+
+    string request;
+    vector<unsigned char> response( 65536 );
+    while( SNMP_CLASS_SUCCESS == SnmpTcpTransport::receive_message( client, request, -1 ) )
+    {
+        if( -1 == send( udp, request.data(), request.length(), 0 ) )
+            break;
+
+        struct pollfd pfd;
+        pfd.fd = udp;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        if( poll( &pfd, 1, RelayAgentTimeout ) <= 0 )
+            continue; // lost like a udp datagram - the client times out
+
+        ssize_t len = recv( udp, &response[0], response.size(), 0 );
+        if( len <= 0 )
+            continue;
+
+        if( SNMP_CLASS_SUCCESS != SnmpTcpTransport::send_message( client, &response[0], len, -1 ) )
+            break;
+    }
+
+    close( udp );
+    return 0;
+}
+
+int
+main(int argc, char *argv[])
+{
+    unsigned short listenPort = 8161, agentPort = 8161;
+    string agentHost = "127.0.0.1";
+
+    for( int i = 1; i < argc; ++i )
+    {
+        string opt( argv[i] );
+        if( ( "-l" == opt ) && ( i + 1 < argc ) )
+            listenPort = atoi( argv[++i] );
+        else if( ( "-a" == opt ) && ( i + 1 < argc ) )
+            agentHost = argv[++i];
+        else if( ( "-p" == opt ) && ( i + 1 < argc ) )
+            agentPort = atoi( argv[++i] );
+        else
+        {
+            cerr << "usage: " << argv[0] << " [-l LISTEN-PORT] [-a AGENT-ADDRESS] [-p AGENT-PORT]" << endl;
+            return 255;
+        }
+    }
+
+    struct sockaddr_in agent, local;
+    memset( &agent, 0, sizeof(agent) );
+    agent.sin_family = AF_INET;
+    agent.sin_port = htons( agentPort );
+    if( 1 != inet_pton( AF_INET, agentHost.c_str(), &agent.sin_addr ) )
+    {
+        cerr << "Invalid agent address '" << agentHost << "'" << endl;
+        return 255;
+    }
+
+    memset( &local, 0, sizeof(local) );
+    local.sin_family = AF_INET;
+    local.sin_port = htons( listenPort );
+    local.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+
+    int one = 1;
+    int srv = socket( AF_INET, SOCK_STREAM, 0 );
+    if( ( -1 == srv ) ||
+        ( -1 == setsockopt( srv, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one) ) ) ||
+        ( -1 == bind( srv, (struct sockaddr *)&local, sizeof(local) ) ) ||
+        ( -1 == listen( srv, 16 ) ) )
+    {
+        cerr << "Can't listen on port " << listenPort << ": " << strerror(errno) << endl;
+        return 1;
+    }
+
+    // connections are relayed by children, nobody waits for them
+    signal( SIGCHLD, SIG_IGN );
+
+    for(;;)
+    {
+        int client = accept( srv, NULL, NULL );
+        if( -1 == client )
+        {
+            if( EINTR == errno )
+                continue;
+            cerr << "accept failed: " << strerror(errno) << endl;
+            return 1;
+        }
+
+        pid_t pid = fork();
+        if( 0 == pid )
+        {
+            close( srv );
+            int rc = relay( client, agent );
+            close( client );
+            _exit( rc );
+        }
+
+        close( client );
+    }
+}
@@ -107,8 +107,14 @@ sub test_plugin {
     if( $plugin->{SUCCEED} ) {
         $p_ok &= is( $result_hash->{stderr}, '', "No error running plugin '$plugcmd'" );
         # $p_ok &= is( scalar(@{$result_hash->{stdout}}), 1, "Got one line of nagios output from '$plugcmd'" );
-        my @nag_info = ( $result_hash->{stdout} =~ m/^\s*(?:[-\w]+?\s+)*?(\w+)(?:(?:\s\-\s|[:])([^|]+))?\s*(?:$|(?:[|](.*))$)/ );
-        $p_ok &= cmp_ok( scalar(@nag_info), ">=", 2, "Got obviously enough status elements from '$plugcmd'" );# and diag( Data::Dumper::Dumper( \@nag_info ) );
+        # multi host runs print one line prefixed with the host name per host
+        my @outputs = $plugin->{MULTI_HOST} ? map { s/^\S+\s+//; $_ } split( "\n", $result_hash->{stdout} ) : ( $result_hash->{stdout} );
+        my @nag_info;
+        foreach my $output (@outputs) {
+            @nag_info = ( $output =~ m/^\s*(?:[-\w]+?\s+)*?(\w+)(?:(?:\s\-\s|[:])([^|]+))?\s*(?:$|(?:[|](.*))$)/ );
+            $p_ok &= cmp_ok( scalar(@nag_info), ">=", 2, "Got obviously enough status elements from '$plugcmd'" );# and diag( Data::Dumper::Dumper( \@nag_info ) );
+        }
+        $plugin->{MULTI_HOST} and $p_ok &= cmp_ok( scalar(@outputs), "==", $plugin->{MULTI_HOST}, "Got one line of nagios output per host from '$plugcmd'" );
         defined($result) and "ARRAY" eq ref($result) and @$result = ($result_hash->{exit_code}, @nag_info);
     }
     else {